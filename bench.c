@@ -0,0 +1,468 @@
+/*
+ *   DESCRIPTION:	Microbenchmarks of the PDU codec stages
+ *
+ *   ABSTRACT:	Every stage (HEX codec, septets packing, GSM 7-bit <-> UTF-8, UCS-2 <-> UTF-8,
+ *		semi-octets, text estimate, full decode/encode) is run over a corpus of GSM
+ *		7-bit, UCS-2, 8-bit, concatenated, status report and alphanumeric originator
+ *		PDUs for a fixed time, the result is given as ns/message, CPU cycles per input
+ *		octet and messages per second. Stages are internal functions of pdu.c, so
+ *		pdu.c is compiled into the benchmark. Every stage is run with the scalar
+ *		kernels and with the kernels selected for the CPU.
+ *
+ *   AUTHOR: AG
+ *
+ *   CREATION DATE: 17-OCT-2026
+ *
+ *   USAGE:
+ *		make bench
+ *		./bench [<milliseconds per stage>]
+ *
+ *   MODIFICATION HISTORY:
+ *
+ *
+ */
+
+
+//###########################################################################
+// @INCLUDES
+//###########################################################################
+#include	"pdu.c"							/* Stages are static functions */
+
+#include	<stdlib.h>
+#include	<time.h>
+
+#if	defined(__x86_64__) || defined(__i386__)
+#include	<x86intrin.h>
+#define	BENCH_RDTSC				1
+#endif
+
+//###########################################################################
+// @DEFINES
+//###########################################################################
+#define	BENCH_MS_DFLT				300	/* Run time of a stage */
+#define	BENCH_PDUS_MAX				64
+
+#define	BENCH_ANY				0	/* Items of a stage */
+#define	BENCH_GSM				1	/* GSM 7-bit items only */
+#define	BENCH_UCS2				2	/* UCS-2 items only */
+
+//###########################################################################
+// @DATATYPE
+//###########################################################################
+/* Corpus item, all representations are prepared before the run */
+typedef struct
+{
+	unsigned char	hex[SMS_PDU_MAX_LEN * 2 + 1];			/* HEX PDU */
+	int	hexLen;
+	uint8_t	bin[SMS_PDU_MAX_LEN];					/* Octets */
+	int	binLen;
+	PDU_DESC	pdsc;						/* Decoded PDU, input of EncodePduData() */
+
+	uint8_t	sept[SMS_GSM7BIT_MAX_LEN];				/* GSM 7-bit text: septets, */
+	int	nsept;
+	uint8_t	packed[SMS_PDU_USER_DATA_MAX_LEN];			/* packed septets, */
+	int	packedLen;
+	unsigned char	utf8[SMS_GSM7BIT_MAX_LEN * UTF8_CHAR_LEN + 1];	/* UTF-8 */
+	int	utf8Len;
+
+	uint8_t	ucs2[SMS_PDU_USER_DATA_MAX_LEN];			/* UCS-2 text: UTF-16BE units */
+	int	ucs2Len;
+
+	uint8_t	addr[ADDR_OCTET_MAX_LEN + 2];				/* Originator as swapped semi-octets */
+	int	addrLen;
+} BENCH_PDU_DESC;
+
+/* Stage: processes one message, returns number of input octets */
+typedef struct
+{
+	const char	*name;
+	size_t	(*run)(const BENCH_PDU_DESC *item);
+	int	only;						/* BENCH_* items */
+} BENCH_STAGE_DESC;
+
+//###########################################################################
+// @DATA
+//###########################################################################
+static const char	*__bench_hex[] = {
+	/* SMS-DELIVER, GSM 7-bit */
+	"07911326040000F0040B911346610089F60000208062917314080CC8F71D14969741F977FD07",
+	/* SMS-DELIVER, alphanumeric originator */
+	"0791448720003023240DD0E474D81C0EBB010000111011315214000BE474D81C0EBB5DE3771B",
+	/* SMS-DELIVER, GSM 7-bit */
+	"07919730071111F1000B919746121611F10000811170021222230DC8329BFD6681EE6F399B1C02",
+	/* SMS-STATUS-REPORT */
+	"0006D60B911326880736F4111011719551401110117195714000",
+	/* SMS-DELIVER, UCS-2, part 1 of 2 */
+	"07911326040000F0440B911346610089F60008208062917314080E0500030A02010048006500720065",
+	/* SMS-DELIVER, 8-bit */
+	"07911326040000F0040B911346610089F60004208062917314080548656C6C6F",
+};
+
+static const char	*__bench_texts[] = {
+	"Hi",
+	"See you at 7pm, bring the keys!",
+	"Your verification code is 482913. Do not share it with anyone. "
+		"If you did not request the code, please ignore this message.",
+	"Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt "
+		"ut labore et dolore magna aliqua. Ut enim ad minim veniam, quis nostrud exercitation "
+		"ullamco laboris nisi ut aliquip ex ea commodo consequat. Duis aute irure dolor in "
+		"reprehenderit in voluptate velit esse cillum dolore eu fugiat nulla pariatur. {EUR} [x]",
+	"\xd0\x9f\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82, \xd0\xba\xd0\xb0\xd0\xba "
+		"\xd0\xb4\xd0\xb5\xd0\xbb\xd0\xb0? \xd0\x9f\xd0\xbe\xd0\xb7\xd0\xb2\xd0\xbe\xd0\xbd\xd0\xb8 "
+		"\xd0\xbc\xd0\xbd\xd0\xb5 \xd0\xb7\xd0\xb0\xd0\xb2\xd1\x82\xd1\x80\xd0\xb0.",
+	"\xd0\x92\xd0\xb0\xd1\x88 \xd0\xba\xd0\xbe\xd0\xb4 \xd0\xbf\xd0\xbe\xd0\xb4\xd1\x82\xd0\xb2\xd0"
+		"\xb5\xd1\x80\xd0\xb6\xd0\xb4\xd0\xb5\xd0\xbd\xd0\xb8\xd1\x8f: 1234. \xd0\x9d\xd0\xb8\xd0"
+		"\xba\xd0\xbe\xd0\xbc\xd1\x83 \xd0\xbd\xd0\xb5 \xd1\x81\xd0\xbe\xd0\xbe\xd0\xb1\xd1\x89\xd0"
+		"\xb0\xd0\xb9\xd1\x82\xd0\xb5 \xd0\xb5\xd0\xb3\xd0\xbe. \xd0\x9f\xd0\xbe\xd0\xb4\xd1\x80\xd0"
+		"\xbe\xd0\xb1\xd0\xbd\xd0\xb5\xd0\xb5 \xd0\xbd\xd0\xb0 \xd1\x81\xd0\xb0\xd0\xb9\xd1\x82\xd0"
+		"\xb5 \xd0\xb8\xd0\xbb\xd0\xb8 \xd0\xb2 \xd0\xbf\xd1\x80\xd0\xb8\xd0\xbb\xd0\xbe\xd0\xb6\xd0"
+		"\xb5\xd0\xbd\xd0\xb8\xd0\xb8 \xd0\xb1\xd0\xb0\xd0\xbd\xd0\xba\xd0\xb0.",
+};
+
+static BENCH_PDU_DESC	__bench_pdus[BENCH_PDUS_MAX];
+static int	__bench_npdus;
+static volatile size_t	__bench_sink;				/* Results are consumed here */
+
+/*
+ *   DESCRIPTION: Prepare all representations of the PDU for the stages.
+ *
+ *   INPUTS:
+ *	hex:	HEX PDU
+ *	len:	length of the HEX PDU
+ *
+ *   RETURNS:
+ *	NONE
+ */
+static void	__bench_add(const unsigned char *hex, int len)
+{
+BENCH_PDU_DESC	*item;
+int	err, i, n;
+
+	if ( __bench_npdus == BENCH_PDUS_MAX )
+		return;
+
+	item = &__bench_pdus[__bench_npdus];
+
+	memcpy(item->hex, hex, len);
+	item->hex[len] = '\0';
+	item->hexLen = len;
+	item->binLen = __hex2bin(item->hex, len, item->bin);
+
+	if ( !DecodePduData(item->hex, &item->pdsc, &err) )
+		{
+		fprintf(stderr, "Corpus PDU %s is not decoded, error %d\n", item->hex, err);
+		exit(EXIT_FAILURE);
+		}
+
+	if ( item->pdsc.usrDataFormat == GSM_7BIT )
+		{
+		item->utf8Len = item->pdsc.usrDataLen;
+		memcpy(item->utf8, item->pdsc.usrData, item->utf8Len);
+		item->nsept = i_Utf8StrToGsmStr(item->utf8, item->utf8Len, item->sept, sizeof(item->sept), NULL);
+		item->packedLen = i_Text2Pdu(item->sept, item->nsept, 0, item->packed, sizeof(item->packed));
+		}
+
+	if ( item->pdsc.usrDataFormat == UCS2_16BIT )
+		item->ucs2Len = i_Utf8StrToUcs2Str(item->pdsc.usrData, item->pdsc.usrDataLen, item->ucs2, sizeof(item->ucs2));
+
+	/* Numeric originator as it is on the wire: swapped semi-octets, F-padded */
+	n = (int) strlen((char *) item->pdsc.phoneAddr);
+
+	for (i = 0; i < n; i += 2)
+		{
+		item->addr[i] = (i + 1 < n) ? item->pdsc.phoneAddr[i + 1] : 'F';
+		item->addr[i + 1] = item->pdsc.phoneAddr[i];
+		}
+
+	item->addrLen = i;
+	__bench_npdus++;
+}
+
+/*
+ *   DESCRIPTION: Turn SMS-SUBMIT made by the encoder into SMS-DELIVER as a handset gets
+ *	it: destination becomes originator, MR & VP are dropped, SCTS is added.
+ *
+ *   INPUTS:
+ *	hex:	HEX SMS-SUBMIT w/o VP
+ *	len:	length of the HEX PDU
+ *	out:	HEX SMS-DELIVER
+ *
+ *   RETURNS:
+ *	length of the HEX SMS-DELIVER
+ */
+static int	__bench_submit2deliver(const unsigned char *hex, int len, unsigned char *out)
+{
+static const uint8_t	scts[7] = {0x02, 0x08, 0x26, 0x19, 0x37, 0x41, 0x80};
+uint8_t	sub[SMS_PDU_MAX_LEN], dlv[SMS_PDU_MAX_LEN + 8];
+int	n, i, k, addrLen;
+
+	n = __hex2bin(hex, len, sub);
+
+	k = i = 1 + sub[0];						/* SMSC address as is */
+	memcpy(dlv, sub, k);
+
+	dlv[k++] = (sub[i++] & USER_DATA_HEADER_INDICATION) | 0x04;	/* SMS-DELIVER, no more messages */
+	i++;								/* TP-MR */
+
+	addrLen = 2 + (sub[i] + 1) / 2;					/* TP-DA -> TP-OA */
+	memcpy(&dlv[k], &sub[i], addrLen);
+	k += addrLen;
+	i += addrLen;
+
+	dlv[k++] = sub[i++];						/* TP-PID */
+	dlv[k++] = sub[i++];						/* TP-DCS */
+
+	memcpy(&dlv[k], scts, sizeof(scts));
+	k += sizeof(scts);
+
+	memcpy(&dlv[k], &sub[i], n - i);				/* TP-UDL, TP-UD */
+	k += n - i;
+
+	return	__bin2hex(dlv, k, out);
+}
+
+/*
+ *   DESCRIPTION: Build the corpus: static PDUs and PDUs of sample texts encoded by
+ *	EncodePduDataLong(), long texts give concatenated parts.
+ *
+ *   RETURNS:
+ *	NONE
+ */
+static void	__bench_corpus(void)
+{
+PDU_DESC	pdsc;
+PDU_PART_DESC	parts[8];
+unsigned char	pdus[8 * (SMS_PDU_MAX_LEN * 2 + 1)], hex[SMS_PDU_MAX_LEN * 2 + 16];
+size_t	i;
+int	j, nparts, err;
+
+	for (i = 0; i < sizeof(__bench_hex) / sizeof(__bench_hex[0]); i++)
+		__bench_add((const unsigned char *) __bench_hex[i], (int) strlen(__bench_hex[i]));
+
+	memset(&pdsc, 0, sizeof(pdsc));
+	strcpy((char *) pdsc.smscAddr, "31624000000");
+	pdsc.smscAddrLen = 11;
+	pdsc.smscTypeOfAddr = NUM_TYPE_INTERNATIONAL;
+	strcpy((char *) pdsc.phoneAddr, "79161234567");
+	pdsc.phoneAddrLen = 11;
+	pdsc.phoneTypeOfAddr = NUM_TYPE_INTERNATIONAL;
+
+	for (i = 0; i < sizeof(__bench_texts) / sizeof(__bench_texts[0]); i++)
+		{
+		pdsc.concateMsgRefNo = (uint8_t) i;
+
+		if ( !(nparts = EncodePduDataLong(&pdsc, (const unsigned char *) __bench_texts[i], strlen(__bench_texts[i]),
+				pdus, sizeof(pdus), parts, 8, &err)) )
+			{
+			fprintf(stderr, "Corpus text #%zu is not encoded, error %d\n", i, err);
+			exit(EXIT_FAILURE);
+			}
+
+		for (j = 0; j < nparts; j++)
+			__bench_add(hex, __bench_submit2deliver(pdus + parts[j].off, parts[j].len, hex));
+		}
+}
+
+static size_t	__bench_hex2bin(const BENCH_PDU_DESC *item)
+{
+uint8_t	out[SMS_PDU_MAX_LEN];
+
+	__bench_sink += __hex2bin(item->hex, item->hexLen, out) + out[0];
+	return	item->hexLen;
+}
+
+static size_t	__bench_bin2hex(const BENCH_PDU_DESC *item)
+{
+unsigned char	out[SMS_PDU_MAX_LEN * 2 + 1];
+
+	__bench_sink += __bin2hex(item->bin, item->binLen, out) + out[0];
+	return	item->binLen;
+}
+
+static size_t	__bench_pdu2text(const BENCH_PDU_DESC *item)
+{
+uint8_t	out[SMS_GSM7BIT_MAX_LEN + 1];
+
+	__bench_sink += i_Pdu2Text(item->packed, item->packedLen, 0, item->nsept, out) + out[0];
+	return	item->packedLen;
+}
+
+static size_t	__bench_text2pdu(const BENCH_PDU_DESC *item)
+{
+uint8_t	out[SMS_PDU_USER_DATA_MAX_LEN];
+
+	__bench_sink += i_Text2Pdu(item->sept, item->nsept, 0, out, sizeof(out)) + out[0];
+	return	item->nsept;
+}
+
+static size_t	__bench_gsm2utf8(const BENCH_PDU_DESC *item)
+{
+uint8_t	out[SMS_GSM7BIT_MAX_LEN * UTF8_CHAR_LEN + 1];
+
+	__bench_sink += i_GsmStrToUtf8Str(item->sept, item->nsept, out, sizeof(out)) + out[0];
+	return	item->nsept;
+}
+
+static size_t	__bench_utf82gsm(const BENCH_PDU_DESC *item)
+{
+uint8_t	out[SMS_GSM7BIT_MAX_LEN];
+
+	__bench_sink += i_Utf8StrToGsmStr(item->utf8, item->utf8Len, out, sizeof(out), NULL) + out[0];
+	return	item->utf8Len;
+}
+
+static size_t	__bench_ucs2utf8(const BENCH_PDU_DESC *item)
+{
+uint8_t	out[SMS_GSM7BIT_MAX_LEN * UTF8_CHAR_LEN + 1];
+
+	__bench_sink += i_Ucs2StrToUtf8Str(item->ucs2, item->ucs2Len, out, sizeof(out)) + out[0];
+	return	item->ucs2Len;
+}
+
+static size_t	__bench_utf8ucs2(const BENCH_PDU_DESC *item)
+{
+uint8_t	out[SMS_PDU_USER_DATA_MAX_LEN];
+
+	__bench_sink += i_Utf8StrToUcs2Str(item->pdsc.usrData, item->pdsc.usrDataLen, out, sizeof(out)) + out[0];
+	return	item->pdsc.usrDataLen;
+}
+
+static size_t	__bench_semioct(const BENCH_PDU_DESC *item)
+{
+uint8_t	in[ADDR_OCTET_MAX_LEN + 2], out[ADDR_OCTET_MAX_LEN + 2];
+
+	memcpy(in, item->addr, item->addrLen);				/* The function takes a non-const buffer */
+	__bench_sink += i_DecSemiOctet2Ascii(in, item->addrLen, out) + out[0];
+	return	item->addrLen;
+}
+
+static size_t	__bench_estimate(const BENCH_PDU_DESC *item)
+{
+PDU_TEXT_EST_DESC	est;
+
+	__bench_sink += PduTextEstimate(item->pdsc.usrData, item->pdsc.usrDataLen, &est) + est.udLen;
+	return	item->pdsc.usrDataLen;
+}
+
+static size_t	__bench_decode(const BENCH_PDU_DESC *item)
+{
+PDU_DESC	pdsc;
+int	err;
+
+	__bench_sink += DecodePduDataN(item->hex, item->hexLen, &pdsc, &err) + pdsc.usrDataLen;
+	return	item->hexLen;
+}
+
+static size_t	__bench_encode(const BENCH_PDU_DESC *item)
+{
+PDU_DESC	pdsc = item->pdsc;
+unsigned char	out[SMS_PDU_MAX_LEN * 2 + 1];
+int	tpdulen;
+
+	__bench_sink += EncodePduData(&pdsc, out, sizeof(out), &tpdulen) + out[0];
+	return	item->pdsc.usrDataLen;
+}
+
+static const BENCH_STAGE_DESC	__bench_stages[] = {
+	{"__hex2bin", __bench_hex2bin, BENCH_ANY},
+	{"__bin2hex", __bench_bin2hex, BENCH_ANY},
+	{"i_Pdu2Text", __bench_pdu2text, BENCH_GSM},
+	{"i_Text2Pdu", __bench_text2pdu, BENCH_GSM},
+	{"i_GsmStrToUtf8Str", __bench_gsm2utf8, BENCH_GSM},
+	{"i_Utf8StrToGsmStr", __bench_utf82gsm, BENCH_GSM},
+	{"i_Ucs2StrToUtf8Str", __bench_ucs2utf8, BENCH_UCS2},
+	{"i_Utf8StrToUcs2Str", __bench_utf8ucs2, BENCH_UCS2},
+	{"i_DecSemiOctet2Ascii", __bench_semioct, BENCH_ANY},
+	{"PduTextEstimate", __bench_estimate, BENCH_ANY},
+	{"DecodePduData", __bench_decode, BENCH_ANY},
+	{"EncodePduData", __bench_encode, BENCH_ANY},
+};
+
+static inline uint64_t	__bench_ns(void)
+{
+struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return	(uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static inline uint64_t	__bench_cycles(void)
+{
+#ifdef	BENCH_RDTSC
+	return	__rdtsc();
+#else
+	return	0;
+#endif
+}
+
+/*
+ *   DESCRIPTION: Run the stage over the corpus for the given time and print the result.
+ *
+ *   INPUTS:
+ *	stage:	stage
+ *	ms:	run time in milliseconds
+ *
+ *   RETURNS:
+ *	NONE
+ */
+static void	__bench_run(const BENCH_STAGE_DESC *stage, int ms)
+{
+const BENCH_PDU_DESC	*items[BENCH_PDUS_MAX];
+uint64_t	t0, t1, c0, c1, msgs = 0, octets = 0, limit = (uint64_t) ms * 1000000ULL;
+int	i, n = 0;
+
+	for (i = 0; i < __bench_npdus; i++)
+		if ( (stage->only == BENCH_ANY) || ((stage->only == BENCH_GSM) && __bench_pdus[i].nsept)
+			|| ((stage->only == BENCH_UCS2) && __bench_pdus[i].ucs2Len) )
+			items[n++] = &__bench_pdus[i];
+
+	for (i = 0; i < n; i++)						/* Warm up */
+		stage->run(items[i]);
+
+	t0 = __bench_ns();
+	c0 = __bench_cycles();
+
+	do	{
+		for (i = 0; i < n; i++)
+			octets += stage->run(items[i]);
+
+		msgs += n;
+		t1 = __bench_ns();
+		} while ( t1 - t0 < limit );
+
+	c1 = __bench_cycles();
+
+	fprintf(stdout, "%-22s %12llu %10.1f", stage->name, (unsigned long long) msgs, (double) (t1 - t0) / msgs);
+
+	if ( c1 - c0 )
+		fprintf(stdout, " %12.2f", (double) (c1 - c0) / octets);
+	else	fprintf(stdout, " %12s", "-");
+
+	fprintf(stdout, " %14.0f\n", msgs * 1e9 / (t1 - t0));
+}
+
+int	main(int argc, char **argv)
+{
+int	ms = (argc > 1) ? atoi(argv[1]) : BENCH_MS_DFLT, cpuFlags, pass;
+size_t	i;
+
+	__bench_corpus();
+	cpuFlags = __pdu_cpu_detect();
+
+	fprintf(stdout, "Corpus: %d PDUs, %d ms per stage, CPU flags: %s%s%s\n", __bench_npdus, ms,
+		(cpuFlags & PDU_CPU_SSE2) ? "sse2 " : "", (cpuFlags & PDU_CPU_AVX2) ? "avx2 " : "",
+		(cpuFlags & PDU_CPU_BMI2) ? "bmi2 " : "");
+
+	for (pass = 0; pass < 2; pass++)
+		{
+		__pdu_cpu_select(pass ? cpuFlags : 0);
+
+		fprintf(stdout, "\n%s kernels:\n", pass ? "CPU" : "Scalar");
+		fprintf(stdout, "%-22s %12s %10s %12s %14s\n", "stage", "messages", "ns/msg", "cycles/byte", "msgs/sec");
+
+		for (i = 0; i < sizeof(__bench_stages) / sizeof(__bench_stages[0]); i++)
+			__bench_run(&__bench_stages[i], ms);
+		}
+
+	return	0;
+}
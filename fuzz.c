@@ -0,0 +1,658 @@
+/*
+ *   DESCRIPTION:	Differential fuzz and timing harness of the PDU decoders
+ *
+ *   ABSTRACT:	Every input (PDU octets) is given to DecodePduDataBin() of pdu.c and, if
+ *		accepted and inside the envelope the reference decoder can safely parse, to
+ *		GsmLib_DecodeSmsSubmitPduFrmt()/GsmLib_DecodeSmsDlvryRprtPduFrmt() of
+ *		other_lib/gsm_pdu.c; originator address, time stamp and GSM 7-bit text are
+ *		compared. The decode time of every input is measured for both decoders, so an
+ *		input which makes a decoder slow is reported like a mismatch is.
+ *
+ *		The reference decoder has no bounds checks and derives some fields wrongly,
+ *		the envelope and the fields compared are described at __fuzz_ref_envelope().
+ *
+ *		Built with -DFUZZ_LIBFUZZER the file is a libFuzzer target: a mismatch aborts,
+ *		a slow input is reported on stderr. Otherwise it is a standalone driver: inputs
+ *		are files (one binary input per file, a libFuzzer corpus directory can be given),
+ *		HEX PDU lines (-x, e.g. output of pdugen) or built-in seeds mutated by a PRNG.
+ *
+ *   AUTHOR: AG
+ *
+ *   CREATION DATE: 17-OCT-2026
+ *
+ *   USAGE:
+ *		make fuzz
+ *		./fuzz [-n <mutations>] [-s <seed>] [-t <slow us>] [-o <timing TSV>] [-x] [<file>|<dir> ...]
+ *
+ *		clang -g -O1 -fsanitize=fuzzer,address -DFUZZ_LIBFUZZER -I ./ -o fuzz_lf fuzz.c other_lib/gsm_pdu.c
+ *		./fuzz_lf <corpus dir>
+ *
+ *   MODIFICATION HISTORY:
+ *
+ *
+ */
+
+
+//###########################################################################
+// @INCLUDES
+//###########################################################################
+#include	"pdu.c"							/* Internals: HEX & GSM 7-bit codecs */
+
+#include	<stdlib.h>
+#include	<time.h>
+#include	<unistd.h>
+#include	<dirent.h>
+#include	<sys/stat.h>
+
+#undef	SMS_PDU_MAX_LEN							/* Defined by both headers, other_lib ones are used below */
+#undef	TIME_STAMP_LEN
+#include	"other_lib/gsm_pdu.h"					/* Reference decoder */
+
+//###########################################################################
+// @DEFINES
+//###########################################################################
+#define	FUZZ_IN_MAX				512	/* Longest input to be kept, longer ones are cut */
+#define	FUZZ_SLOW_US_DFLT			50	/* Decode time to report an input */
+#define	FUZZ_MUTATIONS_DFLT			1000000
+#define	FUZZ_RETIME				5	/* Runs of a slow input, the best time is taken */
+#define	FUZZ_TOP				8	/* Slowest inputs to be shown per decoder */
+#define	FUZZ_DIFFS_SHOWN			16
+
+#define	FUZZ_R_REJECT				0	/* Input is rejected by pdu.c */
+#define	FUZZ_R_SKIP				1	/* Accepted, outside of the reference envelope */
+#define	FUZZ_R_SAME				2	/* Decoded by both, no mismatch */
+#define	FUZZ_R_DIFF				3	/* Mismatch */
+
+#define	FUZZ_F_ADDR				0x01	/* Fields to be compared */
+#define	FUZZ_F_TIME				0x02
+#define	FUZZ_F_TEXT				0x04
+
+#define	FUZZ_TOA_ALNUM				0x50	/* Type of number of the TOA: alphanumeric */
+
+//###########################################################################
+// @DATATYPE
+//###########################################################################
+/* Input kept for the report */
+typedef struct
+{
+	uint64_t	ns;
+	int	len;
+	uint8_t	data[FUZZ_IN_MAX];
+} FUZZ_INPUT_DESC;
+
+/* Decoder timing */
+typedef struct
+{
+	const char	*name;
+	unsigned long long	ncalls;
+	uint64_t	totalNs;
+	FUZZ_INPUT_DESC	top[FUZZ_TOP];					/* Slowest first */
+} FUZZ_TIMING_DESC;
+
+typedef struct
+{
+	unsigned long long	ninputs;
+	unsigned long long	nres[FUZZ_R_DIFF + 1];
+	unsigned long long	nslow;
+	unsigned long long	nknown;					/* Text not compared, reference bug */
+	uint64_t	slowNs;
+	FILE	*tsv;							/* Per-input timing records */
+	FUZZ_TIMING_DESC	tm[2];					/* pdu.c, other_lib */
+} FUZZ_STAT_DESC;
+
+//###########################################################################
+// @DATA
+//###########################################################################
+static FUZZ_STAT_DESC	__fuzz_stat = {.tm = {{"pdu.c"}, {"other_lib"}}, .slowNs = FUZZ_SLOW_US_DFLT * 1000};
+
+static inline uint64_t	__fuzz_ns(void)
+{
+struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return	(uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/*
+ *   DESCRIPTION: Record decode time of the input, keep the slowest inputs.
+ *
+ *   INPUTS:
+ *	tm:	decoder timing
+ *	ns:	decode time
+ *	data:	input
+ *	len:	length of the input
+ *
+ *   RETURNS:
+ *	NONE
+ */
+static void	__fuzz_time(FUZZ_TIMING_DESC *tm, uint64_t ns, const uint8_t *data, size_t len)
+{
+int	i;
+
+	tm->ncalls++;
+	tm->totalNs += ns;
+
+	if ( ns <= tm->top[FUZZ_TOP - 1].ns )
+		return;
+
+	for (i = FUZZ_TOP - 1; (i > 0) && (tm->top[i - 1].ns < ns); i--)
+		tm->top[i] = tm->top[i - 1];
+
+	tm->top[i].ns = ns;
+	tm->top[i].len = (len < FUZZ_IN_MAX) ? (int) len : FUZZ_IN_MAX;
+	memcpy(tm->top[i].data, data, tm->top[i].len);
+}
+
+static void	__fuzz_put_hex(FILE *fp, const uint8_t *data, size_t len)
+{
+unsigned char	hex[FUZZ_IN_MAX * 2 + 1];
+
+	len = (len < FUZZ_IN_MAX) ? len : FUZZ_IN_MAX;
+	__bin2hex(data, (int) len, hex);
+	fprintf(fp, "%s", len ? (char *) hex : "-");
+}
+
+/*
+ *   DESCRIPTION: Check that the reference decoder can parse the PDU w/o going out of its
+ *	buffers and give the fields to be compared. The reference:
+ *	- has no checks of lengths: the PDU must be in its 140 octets, the UDH must be short
+ *	  and leave some septets after it;
+ *	- takes the data coding from the TOA of the originator, so the text is only compared
+ *	  if pdu.c decodes GSM 7-bit and the reference does it too (NPI bits 2..3 are zero);
+ *	- skips one septet too much after the UDH if (UDHL + 1) * 8 is a multiple of 7, the
+ *	  text of such PDUs is not compared (counted as known);
+ *	- does not decode alphanumeric recipient of STATUS-REPORT.
+ *
+ *   INPUTS:
+ *	view:	view of the PDU accepted by pdu.c
+ *	pdsc:	decoded PDU
+ *
+ *   OUTPUS:
+ *	pKnown:	TRUE - text is not compared due to the reference bug
+ *
+ *   RETURNS:
+ *	FUZZ_F_* fields to be compared, 0 - outside of the envelope
+ */
+static int	__fuzz_ref_envelope(const PDU_VIEW *view, const PDU_DESC *pdsc, int *pKnown)
+{
+int	fields = FUZZ_F_ADDR | FUZZ_F_TIME, toa = view->pdu[view->oa + 1], udhl, rest;
+
+	*pKnown = FALSE;
+
+	if ( (view->len > SMS_PDU_MAX_LEN) || (view->pdu[view->oa] > ADDR_MAX_LEN) )
+		return	0;
+
+	if ( pdsc->msgType == MSG_TYPE_SMS_STATUS_REPORT )
+		return	((toa & 0x70) == FUZZ_TOA_ALNUM) ? FUZZ_F_TIME : fields;
+
+	if ( pdsc->msgType != MSG_TYPE_SMS_DELIVER )
+		return	0;
+
+	if ( view->udl == PDU_VIEW_NONE )
+		return	0;
+
+	rest = view->len - view->udl - 1;					/* Octets the reference unpacks */
+
+	if ( view->udh != PDU_VIEW_NONE )
+		{
+		udhl = view->pdu[view->udh];
+
+		if ( (udhl > 30) || (rest < udhl + 4) )
+			return	0;
+
+		if ( ((udhl + 1) * 8) % 7 == 0 )
+			return	*pKnown = (view->usrDataFormat == GSM_7BIT), fields;
+		}
+
+	if ( (view->usrDataFormat == GSM_7BIT) && !(toa & 0x0C) )
+		fields |= FUZZ_F_TEXT;
+
+	return	fields;
+}
+
+/*
+ *   DESCRIPTION: Strip trailing '@' (GSM 7-bit 0x00): the reference stops at a zero septet
+ *	in the last octet, pdu.c takes the number of septets from the UDL.
+ */
+static int	__fuzz_trim_at(const uint8_t *s, int len)
+{
+	while ( (len > 0) && (s[len - 1] == '@') )
+		len--;
+
+	return	len;
+}
+
+static void	__fuzz_diff(FUZZ_STAT_DESC *st, const char *field, const uint8_t *mine, int mineLen,
+		const uint8_t *ref, int refLen, const uint8_t *data, size_t len)
+{
+	if ( st->nres[FUZZ_R_DIFF] >= FUZZ_DIFFS_SHOWN )
+		return;
+
+	fprintf(stderr, "DIFF %s: pdu.c '%.*s' other_lib '%.*s' input ", field, mineLen, mine, refLen, ref);
+	__fuzz_put_hex(stderr, data, len);
+	fputc('\n', stderr);
+}
+
+/*
+ *   DESCRIPTION: Run one input through both decoders.
+ *
+ *   INPUTS:
+ *	st:	statistics
+ *	data:	PDU octets
+ *	len:	number of octets
+ *
+ *   RETURNS:
+ *	FUZZ_R_*
+ */
+static int	__fuzz_one(FUZZ_STAT_DESC *st, const uint8_t *data, size_t len)
+{
+static PDU_DESC	pdsc;
+PDU_VIEW	view;
+PDU_DECODE_DESC	ref;
+char	hex[SMS_PDU_MAX_LEN * 2 + 1], refAddr[ADDR_MAX_LEN + 1], refTs[TIME_STAMP_LEN + 1],
+	refText[SMS_PDU_MAX_LEN * 2 + 1];
+uint8_t	utf8[sizeof(pdsc.usrData)];
+uint64_t	t0, ns[2] = {0, 0};
+int	err, ok = FALSE, fields, known, res = FUZZ_R_SAME, n, mineLen, refLen, nsept, r;
+
+	st->ninputs++;
+
+	/* An input is timed again while slow: one slow run may be a preemption, the best run is taken */
+	for (r = 0, ns[0] = UINT64_MAX; (r < FUZZ_RETIME) && (ns[0] > st->slowNs); r++)
+		{
+		t0 = __fuzz_ns();
+		ok = DecodePduDataBin(data, len, 0, &pdsc, &err);
+		t0 = __fuzz_ns() - t0;
+		ns[0] = (t0 < ns[0]) ? t0 : ns[0];
+		}
+
+	__fuzz_time(&st->tm[0], ns[0], data, len);
+
+	if ( !ok )
+		res = FUZZ_R_REJECT;
+	else if ( !DecodePduView(data, len, 0, &view, &err) )
+		{
+		fprintf(stderr, "DIFF view: DecodePduView() error %d on the PDU accepted by DecodePduDataBin() input ", err);
+		__fuzz_put_hex(stderr, data, len);
+		fputc('\n', stderr);
+		res = FUZZ_R_DIFF;
+		}
+	else if ( !(fields = __fuzz_ref_envelope(&view, &pdsc, &known)) )
+		res = FUZZ_R_SKIP;
+	else	{
+		memset(&ref, 0, sizeof(ref));
+		ref.smsBufLen = (uint16_t) __bin2hex(data, (int) len, (unsigned char *) hex);
+		ref.pSmsBuf = hex;
+		ref.pOrgAddr = refAddr;
+		ref.pTimeStamp = refTs;
+		ref.pTextMsg = refText;
+
+		for (r = 0, ns[1] = UINT64_MAX; (r < FUZZ_RETIME) && (ns[1] > st->slowNs); r++)
+			{
+			t0 = __fuzz_ns();
+
+			if ( pdsc.msgType == MSG_TYPE_SMS_STATUS_REPORT )
+				GsmLib_DecodeSmsDlvryRprtPduFrmt(&ref);
+			else	GsmLib_DecodeSmsSubmitPduFrmt(&ref);
+
+			t0 = __fuzz_ns() - t0;
+			ns[1] = (t0 < ns[1]) ? t0 : ns[1];
+			}
+
+		__fuzz_time(&st->tm[1], ns[1], data, len);
+		st->nknown += known;
+
+		if ( fields & FUZZ_F_ADDR )
+			{
+			if ( (view.pdu[view.oa + 1] & 0x70) == FUZZ_TOA_ALNUM )
+				{
+				/* Reference gives septets of whole octets, pdu.c ones of the semi-octets */
+				nsept = (view.pdu[view.oa] * 4) / 7;
+				refLen = i_GsmStrToUtf8Str((uint8_t *) refAddr, (ref.orgAddrLen < nsept) ? ref.orgAddrLen : nsept,
+					utf8, sizeof(utf8));
+				refLen = __fuzz_trim_at(utf8, refLen);
+				mineLen = __fuzz_trim_at(pdsc.phoneAddr, pdsc.phoneAddrLen);
+
+				if ( (mineLen != refLen) || memcmp(pdsc.phoneAddr, utf8, refLen) )
+					{
+					__fuzz_diff(st, "address", pdsc.phoneAddr, mineLen, utf8, refLen, data, len);
+					res = FUZZ_R_DIFF;
+					}
+				}
+			else if ( strcmp((char *) pdsc.phoneAddr, refAddr) )
+				{
+				__fuzz_diff(st, "address", pdsc.phoneAddr, (int) strlen((char *) pdsc.phoneAddr),
+					(uint8_t *) refAddr, (int) strlen(refAddr), data, len);
+				res = FUZZ_R_DIFF;
+				}
+			}
+
+		if ( (fields & FUZZ_F_TIME) && strcmp((char *) pdsc.timeStamp, refTs) )
+			{
+			__fuzz_diff(st, "timeStamp", pdsc.timeStamp, (int) strlen((char *) pdsc.timeStamp),
+				(uint8_t *) refTs, (int) strlen(refTs), data, len);
+			res = FUZZ_R_DIFF;
+			}
+
+		if ( (fields & FUZZ_F_TEXT) && !known )
+			{
+			/* Reference unpacks all octets up to the end, only UDL septets are the text */
+			n = (ref.textMsgLen < view.udCount) ? ref.textMsgLen : view.udCount;
+			refLen = __fuzz_trim_at(utf8, i_GsmStrToUtf8Str((uint8_t *) refText, n, utf8, sizeof(utf8)));
+			mineLen = __fuzz_trim_at(pdsc.usrData, pdsc.usrDataLen);
+
+			if ( (mineLen != refLen) || memcmp(pdsc.usrData, utf8, refLen) )
+				{
+				__fuzz_diff(st, "usrData", pdsc.usrData, mineLen, utf8, refLen, data, len);
+				res = FUZZ_R_DIFF;
+				}
+			}
+		}
+
+	st->nres[res]++;
+
+	if ( (ns[0] > st->slowNs) || (ns[1] > st->slowNs) )
+		{
+		st->nslow++;
+		fprintf(stderr, "SLOW pdu.c %llu ns other_lib %llu ns input ", (unsigned long long) ns[0], (unsigned long long) ns[1]);
+		__fuzz_put_hex(stderr, data, len);
+		fputc('\n', stderr);
+		}
+
+	if ( st->tsv )
+		{
+		fprintf(st->tsv, "%llu\t%zu\t%d\t%llu\t%llu\t", st->ninputs, len, res, (unsigned long long) ns[0],
+			(unsigned long long) ns[1]);
+		__fuzz_put_hex(st->tsv, data, len);
+		fputc('\n', st->tsv);
+		}
+
+	return	res;
+}
+
+
+#ifdef	FUZZ_LIBFUZZER
+
+int	LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+	if ( FUZZ_R_DIFF == __fuzz_one(&__fuzz_stat, data, size) )
+		abort();
+
+	return	0;
+}
+
+#else	/* Standalone driver */
+
+static const char	*__fuzz_seeds[] = {
+	/* SMS-DELIVER, GSM 7-bit */
+	"07911326040000F0040B911346610089F60000208062917314080CC8F71D14969741F977FD07",
+	/* SMS-DELIVER, alphanumeric originator */
+	"0791448720003023240DD0E474D81C0EBB010000111011315214000BE474D81C0EBB5DE3771B",
+	/* SMS-DELIVER, GSM 7-bit, part 2 of 2 */
+	"0791447758100650440B914466290451F600006210211160920235050003010202D2206BAE0CCAA6AFEE7499AE65A76720F739FC43DBE432D9ACEC56CAC8F4E73BED66A55DECF2329F02",
+	/* SMS-DELIVER, GSM 7-bit, application ports */
+	"0791447758100650440C91939241047349000062500212612571190605040B840087723BB1DC66DDEFA898B28C0B93976D",
+	/* SMS-STATUS-REPORT */
+	"07911326040000F006D60B911326880736F4111011719551401110117195714000",
+	/* SMS-DELIVER, UCS-2, part 1 of 2 */
+	"07911326040000F0440B911346610089F60008208062917314080E0500030A02010048006500720065",
+	/* SMS-DELIVER, 8-bit */
+	"07911326040000F0040B911346610089F60004208062917314080548656C6C6F",
+};
+
+static uint64_t	__fuzz_rnd;						/* splitmix64 state */
+
+static inline uint64_t	__fuzz_u64(void)
+{
+uint64_t	z = (__fuzz_rnd += 0x9E3779B97F4A7C15ULL);
+
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return	z ^ (z >> 31);
+}
+
+static inline unsigned	__fuzz_below(unsigned n)
+{
+	return	(unsigned) (((__fuzz_u64() >> 32) * n) >> 32);
+}
+
+/*
+ *   DESCRIPTION: Mutate the input: bit flips, random and boundary octets (lengths!),
+ *	insertion, removal, truncation, splicing with another seed.
+ *
+ *   INPUTS:
+ *	buf:	input, FUZZ_IN_MAX octets
+ *	len:	length of the input
+ *	seeds:	seed inputs
+ *	seedLens:	lengths of the seeds
+ *	nseeds:	number of seeds
+ *
+ *   RETURNS:
+ *	length of the mutated input
+ */
+static int	__fuzz_mutate(uint8_t *buf, int len, uint8_t seeds[][FUZZ_IN_MAX], const int *seedLens, int nseeds)
+{
+static const uint8_t	special[] = {0x00, 0x01, 0x06, 0x07, 0x0B, 0x7F, 0x80, 0x8C, 0x9F, 0xA0, 0xFE, 0xFF};
+int	nmut = 1 + __fuzz_below(4), i, pos, n;
+
+	for (i = 0; i < nmut; i++)
+		{
+		pos = len ? (int) __fuzz_below(len) : 0;
+
+		switch ( __fuzz_below(7) )
+			{
+			case	0:
+				if ( len )
+					buf[pos] ^= (uint8_t) (1 << __fuzz_below(8));
+				break;
+
+			case	1:
+				if ( len )
+					buf[pos] = (uint8_t) __fuzz_u64();
+				break;
+
+			case	2:
+				if ( len )
+					buf[pos] = special[__fuzz_below(sizeof(special))];
+				break;
+
+			case	3:						/* Insert */
+				if ( len < FUZZ_IN_MAX )
+					{
+					memmove(&buf[pos + 1], &buf[pos], len - pos);
+					buf[pos] = (uint8_t) __fuzz_u64();
+					len++;
+					}
+				break;
+
+			case	4:						/* Remove */
+				if ( len )
+					{
+					memmove(&buf[pos], &buf[pos + 1], len - pos - 1);
+					len--;
+					}
+				break;
+
+			case	5:						/* Truncate */
+				len = pos;
+				break;
+
+			default:						/* Splice the tail of another seed */
+				n = __fuzz_below(nseeds);
+
+				if ( pos < seedLens[n] )
+					{
+					memcpy(&buf[pos], &seeds[n][pos], seedLens[n] - pos);
+					len = seedLens[n];
+					}
+			}
+		}
+
+	return	len;
+}
+
+/*
+ *   DESCRIPTION: Feed the file: whole file is one input, or (hexLines) every line is a
+ *	HEX PDU. A directory gives all its regular files.
+ *
+ *   INPUTS:
+ *	st:	statistics
+ *	path:	file or directory
+ *	hexLines:	TRUE - file of HEX PDU lines
+ *
+ *   RETURNS:
+ *	0/-1
+ */
+static int	__fuzz_file(FUZZ_STAT_DESC *st, const char *path, int hexLines)
+{
+char	line[FUZZ_IN_MAX * 2 + 2], sub[4096];
+uint8_t	buf[FUZZ_IN_MAX];
+struct stat	sb;
+struct dirent	*de;
+DIR	*dir;
+FILE	*fp;
+size_t	n;
+int	len;
+
+	if ( stat(path, &sb) )
+		return	perror(path), -1;
+
+	if ( S_ISDIR(sb.st_mode) )
+		{
+		if ( !(dir = opendir(path)) )
+			return	perror(path), -1;
+
+		while ( (de = readdir(dir)) )
+			{
+			snprintf(sub, sizeof(sub), "%s/%s", path, de->d_name);
+
+			if ( !stat(sub, &sb) && S_ISREG(sb.st_mode) )
+				__fuzz_file(st, sub, hexLines);
+			}
+
+		closedir(dir);
+		return	0;
+		}
+
+	if ( !(fp = fopen(path, "rb")) )
+		return	perror(path), -1;
+
+	if ( hexLines )
+		{
+		while ( fgets(line, sizeof(line), fp) )
+			{
+			n = strcspn(line, "\r\n");
+
+			if ( n && !(n & 1) && (0 < (len = __hex2bin((uint8_t *) line, (int) n, buf))) )
+				__fuzz_one(st, buf, len);
+			}
+		}
+	else	{
+		n = fread(buf, 1, sizeof(buf), fp);			/* Longer files are cut */
+		__fuzz_one(st, buf, n);
+		}
+
+	fclose(fp);
+	return	0;
+}
+
+static void	__fuzz_report(const FUZZ_STAT_DESC *st)
+{
+const FUZZ_TIMING_DESC	*tm;
+int	d, i;
+
+	printf("Inputs: %llu, rejected by pdu.c: %llu, outside reference: %llu, same: %llu, mismatch: %llu,"
+		" text not compared (reference bug): %llu, slow (> %llu us): %llu\n",
+		st->ninputs, st->nres[FUZZ_R_REJECT], st->nres[FUZZ_R_SKIP], st->nres[FUZZ_R_SAME],
+		st->nres[FUZZ_R_DIFF], st->nknown, (unsigned long long) (st->slowNs / 1000), st->nslow);
+
+	for (d = 0; d < 2; d++)
+		{
+		tm = &st->tm[d];
+
+		printf("%-10s calls: %llu, mean: %.1f ns, slowest:\n", tm->name, tm->ncalls,
+			tm->ncalls ? (double) tm->totalNs / tm->ncalls : 0.0);
+
+		for (i = 0; (i < FUZZ_TOP) && tm->top[i].ns; i++)
+			{
+			printf("  %8llu ns  ", (unsigned long long) tm->top[i].ns);
+			__fuzz_put_hex(stdout, tm->top[i].data, tm->top[i].len);
+			putchar('\n');
+			}
+		}
+}
+
+static void	__usage(const char *prog)
+{
+	fprintf(stderr, "Usage: %s [-n <mutations>] [-s <seed>] [-t <slow us>] [-o <timing TSV>] [-x] [<file>|<dir> ...]\n"
+		"\t-n\tnumber of mutated inputs if no files are given, default is %d\n"
+		"\t-s\tseed of mutations, default is 1\n"
+		"\t-t\tdecode time to report an input as slow, default is %d us\n"
+		"\t-o\twrite a record per input: number, length, result, pdu.c ns, other_lib ns, HEX\n"
+		"\t-x\tfiles are HEX PDU lines, default is one binary input per file\n",
+		prog, FUZZ_MUTATIONS_DFLT, FUZZ_SLOW_US_DFLT);
+}
+
+int	main(int argc, char **argv)
+{
+static uint8_t	seeds[sizeof(__fuzz_seeds) / sizeof(__fuzz_seeds[0])][FUZZ_IN_MAX];
+int	seedLens[sizeof(__fuzz_seeds) / sizeof(__fuzz_seeds[0])], nseeds = sizeof(__fuzz_seeds) / sizeof(__fuzz_seeds[0]);
+unsigned long long	nmut = FUZZ_MUTATIONS_DFLT, i;
+uint8_t	buf[FUZZ_IN_MAX];
+int	opt, hexLines = 0, len, n, rc = EXIT_SUCCESS;
+
+	__fuzz_rnd = 1;
+
+	while ( -1 != (opt = getopt(argc, argv, "n:s:t:o:x")) )
+		{
+		switch ( opt )
+			{
+			case	'n':	nmut = strtoull(optarg, NULL, 10); break;
+			case	's':	__fuzz_rnd = strtoull(optarg, NULL, 0); break;
+			case	't':	__fuzz_stat.slowNs = strtoull(optarg, NULL, 10) * 1000; break;
+			case	'x':	hexLines = 1; break;
+
+			case	'o':
+				if ( !(__fuzz_stat.tsv = fopen(optarg, "w")) )
+					{
+					perror(optarg);
+					return	EXIT_FAILURE;
+					}
+				break;
+
+			default:	__usage(argv[0]); return EXIT_FAILURE;
+			}
+		}
+
+	if ( optind < argc )
+		{
+		for ( ; optind < argc; optind++)
+			if ( __fuzz_file(&__fuzz_stat, argv[optind], hexLines) )
+				rc = EXIT_FAILURE;
+		}
+	else	{
+		for (n = 0; n < nseeds; n++)
+			{
+			seedLens[n] = __hex2bin((const uint8_t *) __fuzz_seeds[n], (int) strlen(__fuzz_seeds[n]), seeds[n]);
+			__fuzz_one(&__fuzz_stat, seeds[n], seedLens[n]);
+			}
+
+		for (i = 0; i < nmut; i++)
+			{
+			n = __fuzz_below(nseeds);
+			memcpy(buf, seeds[n], seedLens[n]);
+			len = __fuzz_mutate(buf, seedLens[n], seeds, seedLens, nseeds);
+			__fuzz_one(&__fuzz_stat, buf, len);
+			}
+		}
+
+	if ( __fuzz_stat.tsv )
+		fclose(__fuzz_stat.tsv);
+
+	__fuzz_report(&__fuzz_stat);
+
+	return	(__fuzz_stat.nres[FUZZ_R_DIFF] || (rc != EXIT_SUCCESS)) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+#endif	/* FUZZ_LIBFUZZER */
@@ -1,18 +1,1071 @@
-#include "pdu.h"
-#include <string.h>
-#include <stdio.h>
+/*
+ *   DESCRIPTION:	Bulk PDU decoder
+ *
+ *   ABSTRACT:	Input file is split into chunks of records by the main thread, chunks are
+ *		decoded by a pool of worker threads, every chunk has its own input buffer,
+ *		descriptors pool and output buffer. A writer thread emits outputs of chunks
+ *		strictly in the order of input, so the output is the same for any number
+ *		of threads.
+ *
+ *		Input formats:
+ *			HEX - one HEX PDU per line, CR/LF or LF, empty lines are skipped;
+ *			binary (-b) - records of 2 octets length (network order) + PDU octets.
+ *
+ *		With -m the input file is memory-mapped, line boundaries are found by memchr()
+ *		(vectorized in libc) right in the mapping and records are given to the decoder
+ *		as slices of the mapping, no read()/copy of the input is made.
+ *
+ *		Output formats (-o):
+ *		tsv - default, one line per record:
+ *			<record>	<msgType>	<phoneAddr>	<timeStamp>	<dataCodeScheme>	<usrData>
+ *			<record>	ERR	<error code>
+ *		<record> is a line number in HEX mode or 1-based record number in binary mode,
+ *		GSM 7-bit & UCS-2 text is given in UTF-8 with \\, \t, \r, \n escaped (as well
+ *		as addresses), 8-bit user data is given in HEX.
+ *		col - columnar file of the decoded records (see pdu_col.h), one block per chunk,
+ *		failed records are not stored.
+ *		json - NDJSON line per record (see pdu_fmt.h) with the <record> key in front,
+ *			{"record":<record>,"error":<error code>} for failed records.
+ *		text - print_decoded_pdu() layout with the <record> line in front, failed records
+ *			have the <error> line only.
+ *
+ *   AUTHOR: AG
+ *
+ *   CREATION DATE: 17-OCT-2026
+ *
+ *   USAGE:
+ *		pdu					- decode the built-in sample PDU
+ *		pdu [-b] [-m] [-s] [-o tsv|col|json|text] [-j <threads>] [-r <records>] <file>|-
+ *
+ *   MODIFICATION HISTORY:
+ *
+ *
+ */
 
 
-int main(void)
+//###########################################################################
+// @INCLUDES
+//###########################################################################
+#include	<stdio.h>
+#include	<stdlib.h>
+#include	<string.h>
+#include	<unistd.h>
+#include	<fcntl.h>
+#include	<pthread.h>
+#include	<sys/mman.h>
+#include	<sys/stat.h>
+
+#include	"pdu.h"
+#include	"pdu_col.h"
+#include	"pdu_fmt.h"
+
+//###########################################################################
+// @DEFINES
+//###########################################################################
+#define	BULK_RECS_DFLT				1024	/* Records per chunk */
+#define	BULK_RECS_MAX				(1024*1024)
+#define	BULK_THREADS_MAX			256
+#define	BULK_LINE_AVG				256	/* Input buffer of chunk is <records> * this */
+#define	BULK_IN_MIN				(128*1024)	/* Fits the longest binary record */
+#define	BULK_OUT_REC_MAX			(64 + 2 * (ADDR_OCTET_MAX_LEN + TIME_STAMP_OCTET_MAX_LEN + SMS_GSM7BIT_MAX_LEN * UTF8_CHAR_LEN + 1))
+									/* Worst case of one output line */
+
+#define	BULK_F_BIN				0x01	/* Length-prefixed binary input */
+#define	BULK_F_STAT				0x02	/* Print counters to stderr */
+#define	BULK_F_MMAP				0x04	/* Memory-mapped input */
+
+#define	BULK_OUT_TSV				0	/* Output formats */
+#define	BULK_OUT_COL				1
+#define	BULK_OUT_JSON				2
+#define	BULK_OUT_TEXT				3
+
+//###########################################################################
+// @DATATYPE
+//###########################################################################
+/* Chunk of records, in-flight between reader, workers and writer */
+typedef struct
+{
+	unsigned char	*in;						/* Input octets */
+	size_t	inSz, inLen;
+
+	int	nrecs;
+	PDU_INPUT_DESC	*recs;						/* Records in the <in> */
+	uint64_t	*recno;						/* Line/record numbers */
+	PDU_DESC	*pdscs;						/* Descriptors pool */
+	int	*errs;
+
+	char	*out;							/* Output text */
+	size_t	outSz, outLen;
+	PDU_COL_DESC	*col;						/* Output columns, BULK_OUT_COL */
+
+	uint64_t	seq;						/* Order of the chunk in the input */
+	int	nerrs;
+} BULK_CHUNK_DESC;
+
+/* Input reader state */
+typedef struct
+{
+	FILE	*fp;
+	int	flags;
+	int	eof;
+	int	skip;							/* Over-length line is being dropped */
+	uint64_t	recno;						/* Number of the last read line/record */
+
+	unsigned char	*carry;						/* Unparsed tail of the previous chunk */
+	size_t	carryLen;
+
+	const unsigned char	*map;					/* Mapping of the input file, BULK_F_MMAP */
+	size_t	mapLen, mapOff;
+} BULK_READER_DESC;
+
+/* Shared state of threads */
+typedef struct
+{
+	pthread_mutex_t	mtx;
+	pthread_cond_t	cvFree, cvWork, cvDone;
+
+	int	flags;
+	int	fmt;							/* BULK_OUT_* output format */
+	int	nchunks;
+	BULK_CHUNK_DESC	*chunks;
+
+	int	*freeList, nfree;					/* Chunks are ready to be filled */
+	int	*workQ, workHead, workCnt;				/* Chunks are ready to be decoded */
+	BULK_CHUNK_DESC	**doneSlot;					/* Decoded chunks by <seq> % <nchunks> */
+
+	uint64_t	nextSeq, totalSeq;
+	int	eof;
+
+	uint64_t	nrecs, nerrs;					/* Counters, updated by writer */
+	int	ioerr;
+} BULK_DESC;
+
+//###########################################################################
+// @FUNCTIONS
+//###########################################################################
+static void	__usage(const char *prog);
+static int	__bulk_run(const char *fname, int flags, int fmt, int nthreads, int maxRecs);
+
+/*
+ *   DESCRIPTION: Append a decimal number to the output.
+ *
+ *   INPUTS:
+ *	p:	output position
+ *	v:	value
+ *
+ *   RETURNS:
+ *	position after the last digit
+ */
+static inline char	*__out_u64(char *p, uint64_t v)
+{
+char	tmp[20];
+int	n = 0;
+
+	do	{
+		tmp[n++] = (char) ('0' + v % 10);
+		v /= 10;
+		} while ( v );
+
+	while ( n )
+		*p++ = tmp[--n];
+
+	return	p;
+}
+
+/*
+ *   DESCRIPTION: Append a UTF-8 text to the output with \\, \t, \r, \n escaped.
+ *
+ *   INPUTS:
+ *	p:	output position
+ *	s:	text
+ *	len:	length of the text
+ *
+ *   RETURNS:
+ *	position after the last character
+ */
+static char	*__out_esc(char *p, const unsigned char *s, int len)
+{
+int	i;
+
+	for (i = 0; i < len; i++)
+		{
+		switch ( s[i] )
+			{
+			case	'\\':	*p++ = '\\'; *p++ = '\\'; break;
+			case	'\t':	*p++ = '\\'; *p++ = 't'; break;
+			case	'\r':	*p++ = '\\'; *p++ = 'r'; break;
+			case	'\n':	*p++ = '\\'; *p++ = 'n'; break;
+			default:	*p++ = (char) s[i];
+			}
+		}
+
+	return	p;
+}
+
+/*
+ *   DESCRIPTION: Append the user data of the decoded PDU to the output: UTF-8 text is
+ *	escaped, 8-bit octets are given in HEX.
+ *
+ *   INPUTS:
+ *	p:	output position
+ *	pdsc:	decoded PDU
+ *
+ *   RETURNS:
+ *	position after the last character
+ */
+static char	*__out_usr_data(char *p, const PDU_DESC *pdsc)
+{
+static const char	hex[] = "0123456789ABCDEF";
+const unsigned char	*s = pdsc->usrData;
+int	i;
+
+	if ( pdsc->usrDataFormat != ANSI_8BIT )
+		return	__out_esc(p, s, pdsc->usrDataLen);
+
+	for (i = 0; i < pdsc->usrDataLen; i++)
+		{
+		*p++ = hex[s[i] >> 4];
+		*p++ = hex[s[i] & 0x0F];
+		}
+
+	return	p;
+}
+
+/*
+ *   DESCRIPTION: Make room in the output buffer of the chunk.
+ *
+ *   INPUTS:
+ *	ck:	chunk
+ *	n:	number of octets
+ *
+ *   RETURNS:
+ *	current output position
+ */
+static char	*__bulk_out_room(BULK_CHUNK_DESC *ck, size_t n)
+{
+	while ( ck->outLen + n > ck->outSz )
+		{
+		ck->outSz *= 2;
+
+		if ( !(ck->out = realloc(ck->out, ck->outSz)) )
+			{
+			fprintf(stderr, "Cannot allocate %zu octets for output\n", ck->outSz);
+			exit(EXIT_FAILURE);
+			}
+		}
+
+	return	ck->out + ck->outLen;
+}
+
+/*
+ *   DESCRIPTION: Format decoded records of the chunk as TSV lines.
+ *
+ *   INPUTS:
+ *	ck:	chunk with decoded records
+ *
+ *   OUTPUS:
+ *	ck:	<out> is filled
+ *
+ *   RETURNS:
+ *	NONE
+ */
+static void	__bulk_fmt_tsv(BULK_CHUNK_DESC *ck)
+{
+int	i;
+char	*p;
+PDU_DESC	*pdsc;
+
+	for (i = 0; i < ck->nrecs; i++)
+		{
+		p = __bulk_out_room(ck, BULK_OUT_REC_MAX);
+		p = __out_u64(p, ck->recno[i]);
+		*p++ = '\t';
+
+		if ( ck->errs[i] != ERR_NONE )
+			{
+			memcpy(p, "ERR\t", 4);
+			p = __out_u64(p + 4, (uint64_t) ck->errs[i]);
+			}
+		else	{
+			pdsc = &ck->pdscs[i];
+
+			p = __out_u64(p, pdsc->msgType);
+			*p++ = '\t';
+			p = __out_esc(p, pdsc->phoneAddr, strlen((char *) pdsc->phoneAddr));
+			*p++ = '\t';
+			p = __out_esc(p, pdsc->timeStamp, strlen((char *) pdsc->timeStamp));
+			*p++ = '\t';
+			p = __out_u64(p, pdsc->dataCodeScheme);
+			*p++ = '\t';
+			p = __out_usr_data(p, pdsc);
+			}
+
+		*p++ = '\n';
+		ck->outLen = p - ck->out;
+		}
+}
+
+/*
+ *   DESCRIPTION: Format decoded records of the chunk as NDJSON lines, the <record> key
+ *	is put in front of the PDU_DESC fields, failed records have the <error> key only.
+ *
+ *   INPUTS:
+ *	ck:	chunk with decoded records
+ *
+ *   OUTPUS:
+ *	ck:	<out> is filled
+ *
+ *   RETURNS:
+ *	NONE
+ */
+static void	__bulk_fmt_json(BULK_CHUNK_DESC *ck)
+{
+int	i, n;
+char	*p, keys[32];
+
+	for (i = 0; i < ck->nrecs; i++)
+		{
+		p = __bulk_out_room(ck, sizeof(keys) + PDU_FMT_JSON_MAX);
+
+		memcpy(keys, "\"record\":", 9);
+		*__out_u64(keys + 9, ck->recno[i]) = '\0';
+
+		if ( ck->errs[i] == ERR_NONE )
+			{
+			n = PduFmtJsonKeys(&ck->pdscs[i], keys, p, sizeof(keys) + PDU_FMT_JSON_MAX);
+
+			if ( n > 0 )
+				{
+				ck->outLen = (p + n) - ck->out;
+				continue;
+				}
+
+			ck->errs[i] = ERR_NO_MEMORY;				/* Never, the room is always enough */
+			}
+
+		n = strlen(keys);
+		*p++ = '{';
+		memcpy(p, keys, n);
+		memcpy(p + n, ",\"error\":", 9);
+		p = __out_u64(p + n + 9, (uint64_t) ck->errs[i]);
+		*p++ = '}';
+		*p++ = '\n';
+
+		ck->outLen = p - ck->out;
+		}
+}
+
+/*
+ *   DESCRIPTION: Format decoded records of the chunk in the print_decoded_pdu() layout,
+ *	every record starts with the <record> line, failed records have the <error> line only.
+ *
+ *   INPUTS:
+ *	ck:	chunk with decoded records
+ *
+ *   OUTPUS:
+ *	ck:	<out> is filled
+ *
+ *   RETURNS:
+ *	NONE
+ */
+static void	__bulk_fmt_text(BULK_CHUNK_DESC *ck)
+{
+int	i;
+char	*p;
+
+	for (i = 0; i < ck->nrecs; i++)
+		{
+		p = __bulk_out_room(ck, 64 + PDU_FMT_TEXT_MAX);
+
+		memcpy(p, "record           : ", 19);
+		p = __out_u64(p + 19, ck->recno[i]);
+		*p++ = '\n';
+
+		if ( ck->errs[i] != ERR_NONE )
+			{
+			memcpy(p, "error            : ", 19);
+			p = __out_u64(p + 19, (uint64_t) ck->errs[i]);
+			*p++ = '\n';
+			}
+		else	p += PduFmtText(&ck->pdscs[i], p, PDU_FMT_TEXT_MAX);
+
+		ck->outLen = p - ck->out;
+		}
+}
+
+/*
+ *   DESCRIPTION: Append decoded records of the chunk to the chunk's column buffers,
+ *	failed records are not stored.
+ *
+ *   INPUTS:
+ *	ck:	chunk with decoded records
+ *
+ *   OUTPUS:
+ *	ck:	<col> is filled
+ *
+ *   RETURNS:
+ *	NONE
+ */
+static void	__bulk_fmt_col(BULK_CHUNK_DESC *ck)
+{
+int	i, err;
+
+	for (i = 0; i < ck->nrecs; i++)
+		{
+		if ( (ck->errs[i] == ERR_NONE) && !PduColAdd(ck->col, &ck->pdscs[i], &err) )
+			{
+			fprintf(stderr, "Cannot allocate column buffers\n");
+			exit(EXIT_FAILURE);
+			}
+		}
+}
+
+/*
+ *   DESCRIPTION: Decode all records of the chunk and format the output.
+ *
+ *   INPUTS:
+ *	ck:	chunk
+ *	flags:	BULK_F_* flags
+ *	fmt:	BULK_OUT_* output format
+ *
+ *   OUTPUS:
+ *	ck:	<pdscs>, <errs>, <nerrs> and the output are filled
+ *
+ *   RETURNS:
+ *	NONE
+ */
+static void	__bulk_decode(BULK_CHUNK_DESC *ck, int flags, int fmt)
+{
+int	i;
+
+	/* Descriptors are not cleared here: every decoder resets its descriptor w/o the text */
+	if ( flags & BULK_F_BIN )
+		DecodePduDataBinBatch(ck->recs, ck->nrecs, 0, ck->pdscs, ck->errs);
+	else	DecodePduDataBatch(ck->recs, ck->nrecs, ck->pdscs, ck->errs);
+
+	for (i = ck->nerrs = 0; i < ck->nrecs; i++)
+		ck->nerrs += (ck->errs[i] != ERR_NONE);
+
+	ck->outLen = 0;
+
+	switch ( fmt )
+		{
+		case	BULK_OUT_COL:	__bulk_fmt_col(ck); break;
+		case	BULK_OUT_JSON:	__bulk_fmt_json(ck); break;
+		case	BULK_OUT_TEXT:	__bulk_fmt_text(ck); break;
+		default:		__bulk_fmt_tsv(ck);
+		}
+}
+
+/*
+ *   DESCRIPTION: Split the input octets into records of the chunk; the last incomplete
+ *	record is left in the buffer.
+ *
+ *   INPUTS:
+ *	rd:	reader
+ *	ck:	chunk
+ *	buf:	input octets, the chunk's <in> or the mapping
+ *	bufLen:	number of octets in the <buf>
+ *	maxRecs:	capacity of the chunk
+ *
+ *   OUTPUS:
+ *	ck:	<recs>, <recno>, <nrecs> are filled, records point into the <buf>
+ *
+ *   RETURNS:
+ *	number of consumed octets
+ */
+static size_t	__bulk_split(BULK_READER_DESC *rd, BULK_CHUNK_DESC *ck, const unsigned char *buf, size_t bufLen, int maxRecs)
+{
+const unsigned char	*p = buf, *end = buf + bufLen, *eol;
+size_t	len;
+
+	while ( (ck->nrecs < maxRecs) && (p < end) )
+		{
+		if ( rd->flags & BULK_F_BIN )
+			{
+			if ( end - p < 2 )
+				break;
+
+			len = ((size_t) p[0] << 8) | p[1];
+
+			if ( (size_t) (end - p - 2) < len )
+				break;
+
+			ck->recs[ck->nrecs].pdu = p + 2;
+			ck->recs[ck->nrecs].len = len;
+			ck->recno[ck->nrecs++] = ++rd->recno;
+			p += 2 + len;
+
+			continue;
+			}
+
+		eol = memchr(p, '\n', end - p);
+
+		if ( rd->skip )							/* Tail of an over-length line */
+			{
+			if ( !eol )
+				return	ck->inLen;
+
+			rd->skip = 0;
+			p = eol + 1;
+
+			continue;
+			}
+
+		if ( !eol )
+			{
+			if ( !rd->eof )
+				break;
+
+			eol = end;						/* Last line w/o LF */
+			}
+
+		rd->recno++;
+
+		if ( (len = eol - p) && (p[len - 1] == '\r') )
+			len--;
+
+		if ( len )
+			{
+			ck->recs[ck->nrecs].pdu = p;
+			ck->recs[ck->nrecs].len = len;
+			ck->recno[ck->nrecs++] = rd->recno;
+			}
+
+		p = (eol < end) ? eol + 1 : end;
+		}
+
+	return	p - buf;
+}
+
+/*
+ *   DESCRIPTION: Fill the chunk with the next records of the input.
+ *
+ *   INPUTS:
+ *	rd:	reader
+ *	ck:	chunk
+ *	maxRecs:	capacity of the chunk
+ *
+ *   OUTPUS:
+ *	ck:	<in>, <recs>, <recno>, <nrecs> are filled
+ *
+ *   RETURNS:
+ *	0 - the chunk is filled, or the input is over if <nrecs> is 0
+ *	-1 - read error
+ */
+static int	__bulk_read(BULK_READER_DESC *rd, BULK_CHUNK_DESC *ck, int maxRecs)
+{
+size_t	used;
+
+	memcpy(ck->in, rd->carry, rd->carryLen);
+	ck->inLen = rd->carryLen;
+	ck->nrecs = 0;
+
+	for ( ;; )
+		{
+		if ( !rd->eof && (ck->inLen < ck->inSz) )
+			{
+			ck->inLen += fread(ck->in + ck->inLen, 1, ck->inSz - ck->inLen, rd->fp);
+
+			if ( ck->inLen < ck->inSz )
+				{
+				if ( ferror(rd->fp) )
+					return	-1;
+
+				rd->eof = 1;
+				}
+			}
+
+		used = __bulk_split(rd, ck, ck->in, ck->inLen, maxRecs);
+
+		if ( ck->nrecs )
+			break;
+
+		if ( used )							/* Only a skipped tail or empty lines */
+			{
+			memmove(ck->in, ck->in + used, ck->inLen - used);
+			ck->inLen -= used;
+			used = 0;
+
+			if ( !rd->eof || ck->inLen )
+				continue;
+			}
+
+		if ( rd->eof )
+			{
+			if ( ck->inLen )					/* Truncated binary record */
+				fprintf(stderr, "Truncated record #%llu is ignored\n", (unsigned long long) rd->recno + 1);
+
+			used = ck->inLen;
+			break;
+			}
+
+		/* The buffer is full but has no LF: pass the head of the line as a record,
+		 * it is rejected by the decoder as over-length, the rest of the line is dropped
+		 */
+		ck->recs[0].pdu = ck->in;
+		ck->recs[0].len = ck->inLen;
+		ck->recno[0] = ++rd->recno;
+		ck->nrecs = 1;
+		rd->skip = 1;
+		used = ck->inLen;
+		break;
+		}
+
+	rd->carryLen = ck->inLen - used;
+	memcpy(rd->carry, ck->in + used, rd->carryLen);
+
+	return	0;
+}
+
+/*
+ *   DESCRIPTION: Fill the chunk with the next records of the memory-mapped input, records
+ *	point into the mapping.
+ *
+ *   INPUTS:
+ *	rd:	reader
+ *	ck:	chunk
+ *	maxRecs:	capacity of the chunk
+ *
+ *   OUTPUS:
+ *	ck:	<recs>, <recno>, <nrecs> are filled
+ *
+ *   RETURNS:
+ *	0 - the chunk is filled, or the input is over if <nrecs> is 0
+ */
+static int	__bulk_map_read(BULK_READER_DESC *rd, BULK_CHUNK_DESC *ck, int maxRecs)
+{
+size_t	used, rest = rd->mapLen - rd->mapOff;
+
+	ck->nrecs = 0;
+	used = __bulk_split(rd, ck, rd->map + rd->mapOff, rest, maxRecs);
+
+	if ( !ck->nrecs && (used < rest) )					/* Truncated binary record */
+		{
+		fprintf(stderr, "Truncated record #%llu is ignored\n", (unsigned long long) rd->recno + 1);
+		used = rest;
+		}
+
+	rd->mapOff += used;
+
+	return	0;
+}
+
+/*
+ *   DESCRIPTION: Map the input file, the whole file is visible so the reader is at EOF
+ *	from the start.
+ *
+ *   INPUTS:
+ *	rd:	reader
+ *	fname:	input file name
+ *
+ *   OUTPUS:
+ *	rd:	<map>, <mapLen>, <eof> are set
+ *
+ *   RETURNS:
+ *	0/-1, the error is reported
+ */
+static int	__bulk_map(BULK_READER_DESC *rd, const char *fname)
+{
+struct stat	st;
+void	*map;
+int	fd;
+
+	if ( 0 > (fd = open(fname, O_RDONLY)) )
+		{
+		perror(fname);
+		return	-1;
+		}
+
+	if ( fstat(fd, &st) || !S_ISREG(st.st_mode) )
+		{
+		fprintf(stderr, "%s: a regular file is required for the memory-mapped input\n", fname);
+		close(fd);
+		return	-1;
+		}
+
+	rd->eof = 1;
+
+	if ( !(rd->mapLen = st.st_size) )
+		{
+		close(fd);
+		return	0;
+		}
+
+	if ( MAP_FAILED == (map = mmap(NULL, rd->mapLen, PROT_READ, MAP_PRIVATE, fd, 0)) )
+		{
+		perror(fname);
+		close(fd);
+		return	-1;
+		}
+
+	close(fd);
+
+	madvise(map, rd->mapLen, MADV_SEQUENTIAL);
+	rd->map = map;
+
+	return	0;
+}
+
+/*
+ *   DESCRIPTION: Worker thread: decode chunks from the work queue until the input is over.
+ *
+ *   INPUTS:
+ *	arg:	BULK_DESC
+ *
+ *   RETURNS:
+ *	NULL
+ */
+static void	*__bulk_worker(void *arg)
+{
+BULK_DESC	*bulk = arg;
+BULK_CHUNK_DESC	*ck;
+
+	for ( ;; )
+		{
+		pthread_mutex_lock(&bulk->mtx);
+
+		while ( !bulk->workCnt && !bulk->eof )
+			pthread_cond_wait(&bulk->cvWork, &bulk->mtx);
+
+		if ( !bulk->workCnt )
+			{
+			pthread_mutex_unlock(&bulk->mtx);
+			return	NULL;
+			}
+
+		ck = &bulk->chunks[bulk->workQ[bulk->workHead]];
+		bulk->workHead = (bulk->workHead + 1) % bulk->nchunks;
+		bulk->workCnt--;
+
+		pthread_mutex_unlock(&bulk->mtx);
+
+		__bulk_decode(ck, bulk->flags, bulk->fmt);
+
+		pthread_mutex_lock(&bulk->mtx);
+		bulk->doneSlot[ck->seq % bulk->nchunks] = ck;
+		pthread_cond_signal(&bulk->cvDone);
+		pthread_mutex_unlock(&bulk->mtx);
+		}
+}
+
+/*
+ *   DESCRIPTION: Writer thread: emit outputs of decoded chunks in the order of input and
+ *	return chunks into the free list.
+ *
+ *   INPUTS:
+ *	arg:	BULK_DESC
+ *
+ *   RETURNS:
+ *	NULL
+ */
+static void	*__bulk_writer(void *arg)
+{
+BULK_DESC	*bulk = arg;
+BULK_CHUNK_DESC	*ck;
+int	slot;
+
+	pthread_mutex_lock(&bulk->mtx);
+
+	for ( ;; )
+		{
+		slot = bulk->nextSeq % bulk->nchunks;
+
+		while ( !(ck = bulk->doneSlot[slot]) && !(bulk->eof && (bulk->nextSeq == bulk->totalSeq)) )
+			pthread_cond_wait(&bulk->cvDone, &bulk->mtx);
+
+		if ( !ck )
+			break;
+
+		bulk->doneSlot[slot] = NULL;
+		pthread_mutex_unlock(&bulk->mtx);
+
+		if ( ck->col ? !PduColFlush(ck->col, stdout) : (ck->outLen != fwrite(ck->out, 1, ck->outLen, stdout)) )
+			bulk->ioerr = 1;
+
+		pthread_mutex_lock(&bulk->mtx);
+
+		bulk->nrecs += ck->nrecs;
+		bulk->nerrs += ck->nerrs;
+		bulk->nextSeq++;
+
+		bulk->freeList[bulk->nfree++] = ck - bulk->chunks;
+		pthread_cond_signal(&bulk->cvFree);
+		}
+
+	pthread_mutex_unlock(&bulk->mtx);
+
+	return	NULL;
+}
+
+/*
+ *   DESCRIPTION: Tell the workers and the writer that the input is over.
+ *
+ *   INPUTS:
+ *	bulk:		bulk decoder
+ *	totalSeq:	number of chunks have been queued
+ *
+ *   RETURNS:
+ *	NONE
+ */
+static void	__bulk_stop(BULK_DESC *bulk, uint64_t totalSeq)
+{
+	pthread_mutex_lock(&bulk->mtx);
+	bulk->eof = 1;
+	bulk->totalSeq = totalSeq;
+	pthread_cond_broadcast(&bulk->cvWork);
+	pthread_cond_broadcast(&bulk->cvDone);
+	pthread_mutex_unlock(&bulk->mtx);
+}
+
+/*
+ *   DESCRIPTION: Decode the file: the calling thread reads chunks and feeds the workers.
+ *
+ *   INPUTS:
+ *	fname:	input file name, "-" - stdin
+ *	flags:	BULK_F_* flags
+ *	fmt:	BULK_OUT_* output format
+ *	nthreads:	number of worker threads
+ *	maxRecs:	number of records per chunk
+ *
+ *   RETURNS:
+ *	EXIT_SUCCESS/EXIT_FAILURE
+ */
+static int	__bulk_run(const char *fname, int flags, int fmt, int nthreads, int maxRecs)
+{
+BULK_DESC	bulk = {0};
+BULK_READER_DESC	rd = {0};
+BULK_CHUNK_DESC	*ck;
+pthread_t	tids[BULK_THREADS_MAX], wtid;
+size_t	inSz;
+uint64_t	seq;
+int	i, nworkers, err = 0, rc = EXIT_SUCCESS;
+
+	if ( flags & BULK_F_MMAP )
+		{
+		if ( __bulk_map(&rd, fname) )
+			return	EXIT_FAILURE;
+		}
+	else if ( !strcmp(fname, "-") )
+		rd.fp = stdin;
+	else if ( !(rd.fp = fopen(fname, "rb")) )
+		{
+		perror(fname);
+		return	EXIT_FAILURE;
+		}
+
+	inSz = (size_t) maxRecs * BULK_LINE_AVG;
+	inSz = (flags & BULK_F_MMAP) ? 0 : (inSz < BULK_IN_MIN) ? BULK_IN_MIN : inSz;	/* Input buffers are not used with mmap */
+
+	rd.flags = bulk.flags = flags;
+	bulk.fmt = fmt;
+	bulk.nchunks = 2 * nthreads + 2;				/* Workers are busy while the writer and reader work */
+
+	if ( !(rd.carry = malloc(inSz + 1))
+		|| !(bulk.chunks = calloc(bulk.nchunks, sizeof(BULK_CHUNK_DESC)))
+		|| !(bulk.freeList = calloc(bulk.nchunks, sizeof(int)))
+		|| !(bulk.workQ = calloc(bulk.nchunks, sizeof(int)))
+		|| !(bulk.doneSlot = calloc(bulk.nchunks, sizeof(BULK_CHUNK_DESC *))) )
+		{
+		fprintf(stderr, "Cannot allocate chunks\n");
+		exit(EXIT_FAILURE);
+		}
+
+	for (i = 0; i < bulk.nchunks; i++)
+		{
+		ck = &bulk.chunks[i];
+		ck->inSz = inSz;
+		ck->outSz = (size_t) maxRecs * 128 + BULK_OUT_REC_MAX;
+
+		if ( !(ck->in = malloc(ck->inSz + 1))
+			|| !(ck->recs = malloc(maxRecs * sizeof(PDU_INPUT_DESC)))
+			|| !(ck->recno = malloc(maxRecs * sizeof(uint64_t)))
+			|| !(ck->pdscs = malloc(maxRecs * sizeof(PDU_DESC)))
+			|| !(ck->errs = malloc(maxRecs * sizeof(int)))
+			|| !(ck->out = malloc(ck->outSz))
+			|| ((fmt == BULK_OUT_COL) && !(ck->col = PduColCreate(maxRecs))) )
+			{
+			fprintf(stderr, "Cannot allocate chunks\n");
+			exit(EXIT_FAILURE);
+			}
+
+		bulk.freeList[bulk.nfree++] = i;
+		}
+
+	pthread_mutex_init(&bulk.mtx, NULL);
+	pthread_cond_init(&bulk.cvFree, NULL);
+	pthread_cond_init(&bulk.cvWork, NULL);
+	pthread_cond_init(&bulk.cvDone, NULL);
+
+	for (nworkers = 0; nworkers < nthreads; nworkers++)
+		if ( (err = pthread_create(&tids[nworkers], NULL, __bulk_worker, &bulk)) )
+			break;
+
+	if ( err || (err = pthread_create(&wtid, NULL, __bulk_writer, &bulk)) )
+		{
+		fprintf(stderr, "Cannot create threads: %s\n", strerror(err));
+
+		__bulk_stop(&bulk, 0);						/* Nothing has been queued yet */
+
+		for (i = 0; i < nworkers; i++)
+			pthread_join(tids[i], NULL);
+
+		exit(EXIT_FAILURE);
+		}
+
+	if ( (fmt == BULK_OUT_COL) && !PduColWriteHeader(stdout) )
+		bulk.ioerr = 1;
+
+	for (seq = 0; ; seq++)
+		{
+		pthread_mutex_lock(&bulk.mtx);
+
+		while ( !bulk.nfree )
+			pthread_cond_wait(&bulk.cvFree, &bulk.mtx);
+
+		ck = &bulk.chunks[bulk.freeList[--bulk.nfree]];
+		pthread_mutex_unlock(&bulk.mtx);
+
+		if ( (flags & BULK_F_MMAP) ? __bulk_map_read(&rd, ck, maxRecs) : __bulk_read(&rd, ck, maxRecs) )
+			{
+			perror(fname);
+			rc = EXIT_FAILURE;
+			}
+
+		pthread_mutex_lock(&bulk.mtx);
+
+		if ( !ck->nrecs )
+			{
+			bulk.freeList[bulk.nfree++] = ck - bulk.chunks;
+			pthread_mutex_unlock(&bulk.mtx);
+			break;
+			}
+
+		ck->seq = seq;
+		bulk.workQ[(bulk.workHead + bulk.workCnt++) % bulk.nchunks] = ck - bulk.chunks;
+		pthread_cond_signal(&bulk.cvWork);
+		pthread_mutex_unlock(&bulk.mtx);
+		}
+
+	__bulk_stop(&bulk, seq);
+
+	for (i = 0; i < nthreads; i++)
+		pthread_join(tids[i], NULL);
+
+	pthread_join(wtid, NULL);
+
+	if ( fflush(stdout) || bulk.ioerr )
+		{
+		perror("stdout");
+		rc = EXIT_FAILURE;
+		}
+
+	if ( flags & BULK_F_STAT )
+		fprintf(stderr, "Records: %llu, errors: %llu\n", (unsigned long long) bulk.nrecs, (unsigned long long) bulk.nerrs);
+
+	for (i = 0; i < bulk.nchunks; i++)
+		{
+		ck = &bulk.chunks[i];
+		free(ck->in);
+		free(ck->recs);
+		free(ck->recno);
+		free(ck->pdscs);
+		free(ck->errs);
+		free(ck->out);
+		PduColDestroy(ck->col);
+		}
+
+	free(bulk.chunks);
+	free(bulk.freeList);
+	free(bulk.workQ);
+	free(bulk.doneSlot);
+	free(rd.carry);
+
+	pthread_mutex_destroy(&bulk.mtx);
+	pthread_cond_destroy(&bulk.cvFree);
+	pthread_cond_destroy(&bulk.cvWork);
+	pthread_cond_destroy(&bulk.cvDone);
+
+	if ( rd.map )
+		munmap((void *) rd.map, rd.mapLen);
+
+	if ( rd.fp && (rd.fp != stdin) )
+		fclose(rd.fp);
+
+	return	rc;
+}
+
+static void	__usage(const char *prog)
+{
+	fprintf(stderr, "Usage: %s [-b] [-m] [-s] [-o tsv|col|json|text] [-j <threads>] [-r <records>] <file>|-\n"
+		"\t-b\tlength-prefixed binary input, default is one HEX PDU per line\n"
+		"\t-m\tmemory-map the input file instead of reading it\n"
+		"\t-s\tprint counters to stderr\n"
+		"\t-o\toutput format: tsv - text line per record (default), col - columnar file,\n"
+		"\t\tjson - NDJSON line per record, text - the layout of the built-in sample\n"
+		"\t-j\tnumber of decoding threads, default is number of CPUs\n"
+		"\t-r\trecords per chunk, default is %d\n"
+		"Without arguments the built-in sample PDU is decoded.\n", prog, BULK_RECS_DFLT);
+}
+
+
+int main(int argc, char **argv)
 {
 	PDU_DESC pduDesc;
-	uint8_t errorType;
+	int errorType;
+	int opt, flags = 0, fmt = BULK_OUT_TSV, nthreads = 0, maxRecs = BULK_RECS_DFLT;
+
+	unsigned char pdu_buf[512] = "07911326040000F0040B911346610089F60000208062917314080CC8F71D14969741F977FD07";
+
+	if ( argc < 2 )
+		{
+		memset(&pduDesc, 0x00, sizeof(pduDesc));
+		DecodePduData(pdu_buf, &pduDesc, &errorType);
+
+		print_decoded_pdu(&pduDesc);
+
+		return 0;
+		}
+
+	while ( -1 != (opt = getopt(argc, argv, "bmso:j:r:")) )
+		{
+		switch ( opt )
+			{
+			case	'b':	flags |= BULK_F_BIN; break;
+			case	'm':	flags |= BULK_F_MMAP; break;
+			case	's':	flags |= BULK_F_STAT; break;
+
+			case	'o':
+				if ( !strcmp(optarg, "tsv") )
+					fmt = BULK_OUT_TSV;
+				else if ( !strcmp(optarg, "col") )
+					fmt = BULK_OUT_COL;
+				else if ( !strcmp(optarg, "json") )
+					fmt = BULK_OUT_JSON;
+				else if ( !strcmp(optarg, "text") )
+					fmt = BULK_OUT_TEXT;
+				else	{
+					__usage(argv[0]);
+					return	EXIT_FAILURE;
+					}
+				break;
+
+			case	'j':	nthreads = atoi(optarg); break;
+			case	'r':	maxRecs = atoi(optarg); break;
+			default:	__usage(argv[0]); return EXIT_FAILURE;
+			}
+		}
+
+	if ( (optind != argc - 1) || (nthreads < 0) || (maxRecs < 1) || (maxRecs > BULK_RECS_MAX) )
+		{
+		__usage(argv[0]);
+		return	EXIT_FAILURE;
+		}
 
-	char pdu_buf[512] = "07911326040000F0040B911346610089F60000208062917314080CC8F71D14969741F977FD07";
-	memset(&pduDesc, 0x00, sizeof(pduDesc));
-	DecodePduData(pdu_buf, &pduDesc, &errorType);
+	if ( !nthreads && (0 >= (nthreads = (int) sysconf(_SC_NPROCESSORS_ONLN))) )
+		nthreads = 1;
 
-	print_decoded_pdu(&pduDesc);
+	nthreads = (nthreads > BULK_THREADS_MAX) ? BULK_THREADS_MAX : nthreads;
 
-	return 0;
+	return	__bulk_run(argv[optind], flags, fmt, nthreads, maxRecs);
 }
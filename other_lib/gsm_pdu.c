@@ -1145,7 +1145,7 @@ uint16_t GsmLib_FramePduDataFrmt(PDU_FRAME_DESC *pPduFrameDesc)
 		
 		/* Frame PDU data up to Concatenated SMS part number */
 		sprintf(pPduFrameDesc->pPduFrmBuf,"%02X%02X%02X%02X%02X%s%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X"
-		, 0, firstSmsOctet, 0, strlen(pPduFrameDesc->pDestAddr), typeOfAddr, desAddrBuf, 0, 0, pPduFrameDesc->vp,  
+		, 0, firstSmsOctet, 0, (unsigned) strlen(pPduFrameDesc->pDestAddr), typeOfAddr, desAddrBuf, 0, 0, pPduFrameDesc->vp,  
 		udl , udhl, IE_CONCATENATED_MSG, IE_CONCATENATED_MSG_LEN, 
 		refferenceNum, pPduFrameDesc->totalParts, pPduFrameDesc->partNum);
 		
@@ -1171,7 +1171,7 @@ uint16_t GsmLib_FramePduDataFrmt(PDU_FRAME_DESC *pPduFrameDesc)
 		HexBuf2AsciiBuf(pduHexBuf, pduHexLen, textStrng);
 		
 		sprintf(pPduFrameDesc->pPduFrmBuf,"%02X%02X%02X%02X%02X%s%02X%02X%02X%02X%s"
-		, 0, firstSmsOctet, 0, strlen(pPduFrameDesc->pDestAddr), typeOfAddr, desAddrBuf, 0, 0, pPduFrameDesc->vp, pPduFrameDesc->textLen, textStrng);		
+		, 0, firstSmsOctet, 0, (unsigned) strlen(pPduFrameDesc->pDestAddr), typeOfAddr, desAddrBuf, 0, 0, pPduFrameDesc->vp, pPduFrameDesc->textLen, textStrng);		
 	}
 	
 	/* Is last part sent? */
@@ -1317,7 +1317,7 @@ void GsmLib_DecodeSmsSubmitPduFrmt(PDU_DECODE_DESC *pPduDecodeDesc)
 			if (udhi == TRUE)
 			{
 				textLen = textLen - fillBits;
-				memcpy(pduAsciiData, &pduAsciiData[fillBits], textLen );
+				memmove(pduAsciiData, &pduAsciiData[fillBits], textLen );
 				pduAsciiData[textLen] = '\0';
 			}
 			
@@ -17,19 +17,42 @@
 #define FALSE							 0
 #define ADDR_MAX_LEN					20	 /* 10 Octets */
 #define TIME_STAMP_LEN					14	 /* 7 Octets */
+#define SMS_TEXT_MAX_LEN				160	 /* Septets of one SMS */
 
 //###########################################################################
 // @DATATYPE
 //###########################################################################
 typedef struct {
-
+	char *pSmsBuf;					/* HEX PDU string, NUL terminated */
+	uint16_t smsBufLen;				/* Length of HEX PDU string */
+	uint8_t typeOfAddr;				/* Type of Address of Originating Address */
+	char *pOrgAddr;					/* Originating Address, ADDR_MAX_LEN + 1 */
+	uint8_t orgAddrLen;				/* Length of Originating Address */
+	char *pTimeStamp;				/* Time Stamp, TIME_STAMP_LEN + 1 */
+	char *pTextMsg;					/* Text, SMS_PDU_MAX_LEN * 2 + 1 */
+	uint8_t textMsgLen;				/* Length of Text */
 } PDU_DECODE_DESC;
 
+typedef struct {
+	char *pDestAddr;				/* Destination Address, NUL terminated */
+	uint8_t isIntrNtnlNum;				/* International format of Destination Address */
+	char *pTextMsg;					/* Text in GSM 7-bit */
+	uint8_t textLen;				/* Length of Text */
+	uint8_t vp;					/* Validity Period, relative */
+	uint8_t isDlvryRprtEnble;			/* Status Report request */
+	uint8_t isConcatenatedSms;			/* Text is a part of Concatenated SMS */
+	uint8_t totalParts;				/* Number of parts of Concatenated SMS */
+	uint8_t partNum;				/* Sequence Number of the part */
+	char *pPduFrmBuf;				/* HEX PDU string */
+} PDU_FRAME_DESC;
+
 
 //###########################################################################
 // @PROTOTYPE
 //###########################################################################
+uint16_t GsmLib_FramePduDataFrmt(PDU_FRAME_DESC *pPduFrameDesc);
 void GsmLib_DecodeSmsSubmitPduFrmt(PDU_DECODE_DESC *pPduDecodeDesc);
+void GsmLib_DecodeSmsDlvryRprtPduFrmt(PDU_DECODE_DESC *pPduDecodeDesc);
 
 
 #endif	//GSMLIB_PDU_H
@@ -17,6 +17,58 @@
  *
  *	 7-JUN-2021	ALX,RRL	Added a local version of the strnlen() routine
  *
+ *	17-OCT-2026	AG	Added DecodePduDataBatch(), __hex2bin()/i_DecSemiOctet2Ascii() take
+ *				an explicit length, user data unpacked via a scratch buffer.
+ *
+ *	17-OCT-2026	AG	SSE2/AVX2 HEX codec kernels with run-time CPU dispatch,
+ *				fixed A-F nibbles conversion, non-HEX characters are rejected.
+ *
+ *	17-OCT-2026	AG	Added DecodePduDataN(), all PDU fields are checked against the PDU length.
+ *
+ *	17-OCT-2026	AG	Added DecodePduDataBin() to decode raw octets PDU with or w/o SMSC block.
+ *
+ *	17-OCT-2026	AG	GSM 7-bit to UTF-8 conversion by lookup tables instead of switch(),
+ *				ASCII-identical runs are copied in bulk (SSE2).
+ *
+ *	17-OCT-2026	AG	UTF-8 to GSM 7-bit conversion by a two-level reverse index,
+ *				EncodePduData() puts number of septets into TP-UDL.
+ *
+ *	17-OCT-2026	AG	Word-at-a-time septets unpacking (64-bit/PDEP), UDH fill bits are
+ *				skipped by the unpacker, fixed alphanumeric originator decoding.
+ *
+ *	17-OCT-2026	AG	Word-at-a-time septets packing (64-bit/PEXT) with arbitrary fill bits,
+ *				bounds-safe; concatenated GSM 7-bit parts are packed after the UDH.
+ *
+ *	17-OCT-2026	AG	Added EncodePduDataLong() to encode a long text into all parts in one call,
+ *				EncodePduData() doesn't modify the PDU descriptor, TP-UDL of 8/16-bit
+ *				concatenated messages includes the UDH.
+ *
+ *	17-OCT-2026	AG	Decoding is split into the parsing stage (compact PDU_HDR + text location)
+ *				and the materialization; added DecodePduHdr()/DecodePduHdrBin() with
+ *				user data in a caller's arena and PduHdrToDesc().
+ *
+ *	17-OCT-2026	AG	The parsing stage produces PDU_VIEW (offsets of TPDU elements), added
+ *				DecodePduView() and lazy PduView*() accessors.
+ *
+ *	17-OCT-2026	AG	PDU_F_HDR_ONLY decoding stops after the UDH, added DecodePduUsrData()
+ *				to materialize the text on demand.
+ *
+ *	17-OCT-2026	AG	UDH Information Elements are walked in one pass strictly within the UDHL,
+ *				malformed UDH is rejected with ERR_UDH, IEs are listed in the PDU_DESC.
+ *
+ *	17-OCT-2026	AG	UCS-2 User Data is decoded to UTF-8 (surrogate pairs are joined, a lone
+ *				surrogate gives U+FFFD), SSE2/AVX2 kernels for ASCII & 2-octet runs.
+ *
+ *	17-OCT-2026	AG	EncodePduData() converts UTF-8 user data of UCS2_16BIT messages to UCS-2
+ *				(70/67 units per message), SSE2/AVX2 UTF-8 -> UCS-2 kernels.
+ *
+ *	17-OCT-2026	AG	Added PduTextEstimate(): charset, length and number of parts of the text
+ *				in one pass, EncodePduDataLong() selects the charset by the same pass.
+ *
+ *	17-OCT-2026	AG	Added DecodePduDataBinBatch() for arrays of binary PDUs.
+ *
+ *	17-OCT-2026	AG	EncodePduData() checks the size of the output buffer.
+ *
  */
 
 
@@ -26,9 +78,19 @@
 #include	<stdlib.h>
 #include	<stdio.h>
 #include	<string.h>
+#include	<stddef.h>
 
 #include	"pdu.h"
 
+#if	defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define	PDU_X86_SIMD	1
+#include	<immintrin.h>
+#endif
+
+#if	defined(PDU_X86_SIMD) && defined(__x86_64__)
+#define	PDU_X86_BMI2	1						/* PDEP/PEXT are 64-bit only */
+#endif
+
 
 
 
@@ -40,6 +102,10 @@
 #define MSG_CLASS0						0x00
 #define MSG_CLASS1						0x01
 
+#define	PDU_CPU_SSE2						0x01	/* CPU features used by the codec kernels */
+#define	PDU_CPU_AVX2						0x02
+#define	PDU_CPU_BMI2						0x04
+
 //###########################################################################
 // @ENUMERATOR
 //###########################################################################
@@ -60,18 +126,36 @@ enum
 //###########################################################################
 static uint8_t i_Hex2Ascii(uint8_t hexNibble);
 static uint8_t i_Ascii2Hex(uint8_t asciiChar);
-static int	__bin2hex(unsigned char *hexBuf, int hexBufLen, unsigned char *asciiStrng);
-static uint8_t	__hex2bin(uint8_t *asciiStrng, uint8_t *hexBuf);
-static uint8_t i_DecSemiOctet2Ascii(uint8_t *decSemiOctetBuf, uint8_t *asciiStrng);
+static int	__bin2hex(const unsigned char *hexBuf, int hexBufLen, unsigned char *asciiStrng);
+static int	__hex2bin(const uint8_t *asciiStrng, int asciiLen, uint8_t *hexBuf);
+static uint8_t i_DecSemiOctet2Ascii(uint8_t *decSemiOctetBuf, int decSemiOctetLen, uint8_t *asciiStrng);
 static uint8_t i_Ascii2DecSemiOctet(uint8_t *asciiStrng, uint8_t *decSemiOctetBuf);
 
-static void	i_Gsm7BitDfltChrToUtf8Chr(uint8_t cIn, uint8_t *utf8Char, int *utf8CharLen);
-static void	i_GsmExt7BitChrToUtf8Chr(uint8_t cIn, uint8_t *utf8Char, int *utf8CharLen);
-static uint16_t	i_GsmStrToUtf8Str(uint8_t *pStrInGsm, int strInGsmLen, uint8_t *pStrOutUtf);
-static void	i_Utf8StrToGsmStr(uint8_t *cIn, uint16_t cInLen, uint8_t *gsmOut, int *gsmLen);
-
-static uint8_t i_Text2Pdu(uint8_t *pAsciiBuf, uint8_t asciiLen, uint8_t *pPduBuf);
-static int i_Pdu2Text(uint8_t *pPduBuf, uint8_t pduLen, uint8_t *pAsciiBuf);
+static int	i_GsmStrToUtf8Str(const uint8_t *pStrInGsm, int strInGsmLen, uint8_t *pStrOutUtf, int outSz);
+static int	i_Utf8StrToGsmStr(const uint8_t *cIn, int cInLen, uint8_t *gsmOut, int gsmOutSz, int *pUnmapped);
+static int	i_Utf8StrToUcs2Str(const uint8_t *cIn, int cInLen, uint8_t *ucsOut, int ucsOutSz);
+static int	i_Ucs2StrToUtf8Str(const uint8_t *ucsIn, int ucsInLen, uint8_t *pStrOutUtf, int outSz);
+
+static int i_Text2Pdu(const uint8_t *pAsciiBuf, int asciiLen, int bitOff, uint8_t *pPduBuf, int pduSz);
+static int i_Pdu2Text(const uint8_t *pPduBuf, int pduLen, int skip, int nsept, uint8_t *pAsciiBuf);
+
+/* Codec kernels, selected at run-time by __pdu_cpu_select() */
+static int	__gsm7_ascii_run_scalar(const uint8_t *pStr, int len);
+static int	__septet_unpack_scalar(const uint8_t *pPduBuf, int pduLen, int skip, int nsept, uint8_t *pOut);
+static int	__septet_pack_scalar(const uint8_t *pSept, int nsept, int bitOff, uint8_t *pOut);
+static int	__ucs2_utf8_scalar(const uint8_t *pIn, int inLen, uint8_t *pOut, int outSz);
+static int	__utf8_ucs2_scalar(const uint8_t *pIn, int inLen, uint8_t *pOut, int outSz);
+#ifdef	PDU_X86_SIMD
+static int	__gsm7_ascii_run_sse2(const uint8_t *pStr, int len) __attribute__((target("sse2")));
+static int	__ucs2_utf8_sse2(const uint8_t *pIn, int inLen, uint8_t *pOut, int outSz) __attribute__((target("sse2")));
+static int	__ucs2_utf8_avx2(const uint8_t *pIn, int inLen, uint8_t *pOut, int outSz) __attribute__((target("avx2")));
+static int	__utf8_ucs2_sse2(const uint8_t *pIn, int inLen, uint8_t *pOut, int outSz) __attribute__((target("sse2")));
+static int	__utf8_ucs2_avx2(const uint8_t *pIn, int inLen, uint8_t *pOut, int outSz) __attribute__((target("avx2")));
+#endif
+#ifdef	PDU_X86_BMI2
+static int	__septet_unpack_bmi2(const uint8_t *pPduBuf, int pduLen, int skip, int nsept, uint8_t *pOut) __attribute__((target("bmi2")));
+static int	__septet_pack_bmi2(const uint8_t *pSept, int nsept, int bitOff, uint8_t *pOut) __attribute__((target("bmi2")));
+#endif
 
 
 /*  DESCRIPTION: a local version equivalent of the C RTL strnlen() routine
@@ -110,7 +194,7 @@ static inline uint8_t i_Hex2Ascii(uint8_t hexNibble)
 	if (hexNibble <= 0x09)
 		return (hexNibble + '0');
 	else  if ((hexNibble >= 0x0A) && (hexNibble <= 0x0F))
-		return (hexNibble + 'A');
+		return (hexNibble - 0x0A + 'A');
 
 	return	0;
 }
@@ -118,7 +202,7 @@ static inline uint8_t i_Hex2Ascii(uint8_t hexNibble)
 //***************************************************************************
 // @NAME        : i_Ascii2Hex
 // @PARAM       : uint8_t asciiChar
-// @RETURNS     : hex nibble or FALSE
+// @RETURNS     : hex nibble or 0xFF for a non-hex character
 // @DESCRIPTION : This function converts ascii pack to hex nibble.
 //***************************************************************************
 static inline uint8_t i_Ascii2Hex(uint8_t asciiChar)
@@ -126,9 +210,11 @@ static inline uint8_t i_Ascii2Hex(uint8_t asciiChar)
 	if ((asciiChar >= '0') && (asciiChar <= '9'))
 		return (asciiChar - '0');
 	else  if ((asciiChar >= 'A') && (asciiChar <= 'F'))
-		return (asciiChar - 'A');
+		return (asciiChar - 'A' + 0x0A);
+	else  if ((asciiChar >= 'a') && (asciiChar <= 'f'))
+		return (asciiChar - 'a' + 0x0A);
 
-	return	0;
+	return	0xFF;
 }
 
 //***************************************************************************
@@ -138,10 +224,11 @@ static inline uint8_t i_Ascii2Hex(uint8_t asciiChar)
 // @RETURNS     : Length of Ascii string, if fails in between than returns FALSE.
 // @DESCRIPTION : This function converts series of hex data in to ascii string.
 //***************************************************************************
-static int __bin2hex(unsigned char  *pHexBuf, int hexBufLen, unsigned char *pAsciiStrng)
+static int __bin2hex_scalar(const unsigned char  *pHexBuf, int hexBufLen, unsigned char *pAsciiStrng)
 {
 int	idx = 0;
-unsigned char  *hp, hn, ln, asciiChar, *cp;
+const unsigned char  *hp;
+unsigned char  hn, ln, asciiChar, *cp;
 
 	hp = pHexBuf;
 	cp = pAsciiStrng;
@@ -168,917 +255,2277 @@ unsigned char  *hp, hn, ln, asciiChar, *cp;
 //***************************************************************************
 // @NAME        : AsciiBuf2HexBuf
 // @PARAM       : asciiStrng - Pointer to buffer string buffer.
+//				  asciiLen - length of the string in characters
 //				  hexBuf - Pointer to hex buffer.
-// @RETURNS     : Length of hex buffer, if fails in between than returns FALSE.
+// @RETURNS     : Length of hex buffer, -1 if a non-hex character has been met.
 // @DESCRIPTION : This function converts ascii string in to siries of hex data.
 //***************************************************************************
-static uint8_t __hex2bin(uint8_t *pAsciiStrng, uint8_t *pHexBuf)
+static int __hex2bin_scalar(const uint8_t *pAsciiStrng, int asciiLen, uint8_t *pHexBuf)
 {
-int	idx = 0, hidx = 0, asciiLen = 0;
-uint8_t hexData = 0, higherNibble = 0, lowerNibble = 0, asciiChar = 0;
+int	idx = 0, hidx = 0;
+uint8_t higherNibble = 0, lowerNibble = 0;
 
-	asciiLen = strlen ( (char *) pAsciiStrng);
 	asciiLen = asciiLen >> 1;
 
 	for (idx =0; idx < asciiLen; idx++)
 		{
-		/* Process higher nibble */
-		asciiChar = pAsciiStrng[idx*2];
-		higherNibble = i_Ascii2Hex(asciiChar);
-		higherNibble = higherNibble << 4;
+		higherNibble = i_Ascii2Hex(pAsciiStrng[idx*2]);		/* Process higher nibble */
+		lowerNibble = i_Ascii2Hex(pAsciiStrng[(idx*2)+1]);	/* Process lower nibble */
 
-		/* Process lower nibble */
-		asciiChar = pAsciiStrng[(idx*2)+1];
-		lowerNibble = i_Ascii2Hex(asciiChar);
+		if ( (higherNibble | lowerNibble) & 0xF0 )
+			return	-1;
 
-		/* Prepare complete hex byte */
-		hexData = higherNibble | lowerNibble;
-		pHexBuf[hidx++] = hexData;
+		pHexBuf[hidx++] = (higherNibble << 4) | lowerNibble;	/* Prepare complete hex byte */
 		}
 
 	return (hidx);
 }
 
-//***************************************************************************
-// @NAME        : i_Utf8StrToGsmStr
-// @PARAM       : uint8_t *cIn - the pointer to buffer containing UTF8 characters.
-//				  uint16_t cInLen - length of data in cIn buffer.
-//				  uint8_t *gsmOut - The pointer to buffer which carries converetd
-//								  string in Gsm character set.
-//				  uint8_t *gsmLen - The pointer to length of converetd data with
-//								  Gsm character set.
-// @RETURNS     : void
-// @DESCRIPTION : This function converts string in UTF8 character set to
-//				  Gsm cgaracter set.
-//***************************************************************************
-void i_Utf8StrToGsmStr(uint8_t *cIn, uint16_t cInLen, uint8_t *gsmOut, int *gsmLen)
+
+#ifdef	PDU_X86_SIMD
+/*  DESCRIPTION: Convert 16 HEX characters to nibbles, validate characters in the same pass.
+ *
+ *   INPUTS:
+ *	c:	16 ASCII characters
+ *	bad:	an accumulator of invalid characters mask
+ *
+ *   RETURNS:
+ *	16 nibbles, one per byte
+ */
+static inline __attribute__((target("sse2"), always_inline)) __m128i __hex_nibbles_sse2(__m128i c, __m128i *bad)
 {
-int	gsmIdx = 0, cInidx = 0;
-uint8_t charVar = 0;
+__m128i	d, l, isd, isl;
 
+	d = _mm_sub_epi8(c, _mm_set1_epi8('0'));			/* '0'...'9' -> 0...9 */
+	isd = _mm_and_si128(_mm_cmpgt_epi8(d, _mm_set1_epi8(-1)), _mm_cmpgt_epi8(_mm_set1_epi8(10), d));
 
-	while (cInidx < cInLen)
-	{
-		if (gsmIdx >= LONG_SMS_TEXT_MAX_LEN)
-		{
-			gsmIdx = LONG_SMS_TEXT_MAX_LEN;
-			break;
-		}
+	l = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));	/* 'A'/'a'...'F'/'f' -> 0...5 */
+	isl = _mm_and_si128(_mm_cmpgt_epi8(l, _mm_set1_epi8(-1)), _mm_cmpgt_epi8(_mm_set1_epi8(6), l));
 
-		charVar = cIn[cInidx++];
-		switch(charVar)
-		{
-			// Characters not listed here are equal to those in the
-			// UTF8 charset OR not present in it.
+	*bad = _mm_or_si128(*bad, _mm_andnot_si128(_mm_or_si128(isd, isl), _mm_set1_epi8(-1)));
 
-			case 0x40:
-				gsmOut[gsmIdx++] = 0;
-				break;
+	return	_mm_or_si128(_mm_and_si128(isd, d), _mm_and_si128(isl, _mm_add_epi8(l, _mm_set1_epi8(10))));
+}
 
-			case 0x24:
-				gsmOut[gsmIdx++] = 2;
-				break;
+/*  DESCRIPTION: Merge pairs of nibbles into octets: [hi, lo] -> (hi << 4 | lo) in 16-bit lanes
+ */
+static inline __attribute__((target("sse2"), always_inline)) __m128i __hex_merge_sse2(__m128i n)
+{
+	return	_mm_or_si128(_mm_slli_epi16(_mm_and_si128(n, _mm_set1_epi16(0x00FF)), 4), _mm_srli_epi16(n, 8));
+}
 
-			case 0x5F:
-				gsmOut[gsmIdx++] = 17;
-				break;
+/*  DESCRIPTION: Convert 16 nibbles (one per byte) to the HEX characters '0'...'9', 'A'...'F'
+ */
+static inline __attribute__((target("sse2"), always_inline)) __m128i __hex_ascii_sse2(__m128i n)
+{
+	return	_mm_add_epi8(_mm_add_epi8(n, _mm_set1_epi8('0')),
+			_mm_and_si128(_mm_cmpgt_epi8(n, _mm_set1_epi8(9)), _mm_set1_epi8('A' - '0' - 10)));
+}
 
-			case 0xc2:
-				switch (cIn[cInidx++])
-				{
-					case 0xA3:
-						gsmOut[gsmIdx++] = 1;
-						break;
+static __attribute__((target("sse2"))) int __hex2bin_sse2(const uint8_t *pAsciiStrng, int asciiLen, uint8_t *pHexBuf)
+{
+int	idx = 0, hidx = 0, len;
+__m128i	bad = _mm_setzero_si128(), a, b;
 
-					case 0xA5:
-						gsmOut[gsmIdx++] = 3;
-						break;
+	for (asciiLen &= ~1; idx + 32 <= asciiLen; idx += 32, hidx += 16)
+		{
+		a = __hex_nibbles_sse2(_mm_loadu_si128((const __m128i *) &pAsciiStrng[idx]), &bad);
+		b = __hex_nibbles_sse2(_mm_loadu_si128((const __m128i *) &pAsciiStrng[idx + 16]), &bad);
 
-					case 0xA4:
-						gsmOut[gsmIdx++] = 36;
-						break;
+		_mm_storeu_si128((__m128i *) &pHexBuf[hidx], _mm_packus_epi16(__hex_merge_sse2(a), __hex_merge_sse2(b)));
+		}
 
-					case 0xA1:
-						gsmOut[gsmIdx++] = 64;
-						break;
+	if ( _mm_movemask_epi8(bad) )
+		return	-1;
 
-					case 0xA7:
-						gsmOut[gsmIdx++] = 95;
-						break;
+	if ( 0 > (len = __hex2bin_scalar(&pAsciiStrng[idx], asciiLen - idx, &pHexBuf[hidx])) )
+		return	-1;
 
-					case 0xBF:
-						gsmOut[gsmIdx++] = 96;
-						break;
+	return	hidx + len;
+}
 
-					default:
-						gsmOut[gsmIdx++] = ' ';
-						break;
-				}
-				break;
+static __attribute__((target("sse2"))) int __bin2hex_sse2(const unsigned char *pHexBuf, int hexBufLen, unsigned char *pAsciiStrng)
+{
+int	idx = 0;
+__m128i	v, hn, ln;
 
-			case 0xc3:
-				switch (cIn[cInidx++])
-				{
-					case 0xA8:
-						gsmOut[gsmIdx++] = 4;
-						break;
+	for ( ; idx + 16 <= hexBufLen; idx += 16)
+		{
+		v = _mm_loadu_si128((const __m128i *) &pHexBuf[idx]);
+		hn = _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0F));
+		ln = _mm_and_si128(v, _mm_set1_epi8(0x0F));
 
-					case 0xA9:
-						gsmOut[gsmIdx++] = 5;
-						break;
+		_mm_storeu_si128((__m128i *) &pAsciiStrng[idx * 2], __hex_ascii_sse2(_mm_unpacklo_epi8(hn, ln)));
+		_mm_storeu_si128((__m128i *) &pAsciiStrng[idx * 2 + 16], __hex_ascii_sse2(_mm_unpackhi_epi8(hn, ln)));
+		}
 
-					case 0xB9:
-						gsmOut[gsmIdx++] = 6;
-						break;
+	return	idx * 2 + __bin2hex_scalar(&pHexBuf[idx], hexBufLen - idx, &pAsciiStrng[idx * 2]);
+}
 
-					case 0xAC:
-						gsmOut[gsmIdx++] = 7;
-						break;
 
-					case 0xB2:
-						gsmOut[gsmIdx++] = 8;
-						break;
+static inline __attribute__((target("avx2"), always_inline)) __m256i __hex_nibbles_avx2(__m256i c, __m256i *bad)
+{
+__m256i	d, l, isd, isl;
 
-					case 0x87:
-						gsmOut[gsmIdx++] = 9;
-						break;
+	d = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+	isd = _mm256_and_si256(_mm256_cmpgt_epi8(d, _mm256_set1_epi8(-1)), _mm256_cmpgt_epi8(_mm256_set1_epi8(10), d));
 
-					case 0x98:
-						gsmOut[gsmIdx++] = 11;
-						break;
+	l = _mm256_sub_epi8(_mm256_or_si256(c, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+	isl = _mm256_and_si256(_mm256_cmpgt_epi8(l, _mm256_set1_epi8(-1)), _mm256_cmpgt_epi8(_mm256_set1_epi8(6), l));
 
-					case 0xB8:
-						gsmOut[gsmIdx++] = 12;
-						break;
+	*bad = _mm256_or_si256(*bad, _mm256_andnot_si256(_mm256_or_si256(isd, isl), _mm256_set1_epi8(-1)));
 
-					case 0x85:
-						gsmOut[gsmIdx++] = 14;
-						break;
+	return	_mm256_or_si256(_mm256_and_si256(isd, d), _mm256_and_si256(isl, _mm256_add_epi8(l, _mm256_set1_epi8(10))));
+}
 
-					case 0xA5:
-						gsmOut[gsmIdx++] = 15;
-						break;
+static inline __attribute__((target("avx2"), always_inline)) __m256i __hex_merge_avx2(__m256i n)
+{
+	return	_mm256_or_si256(_mm256_slli_epi16(_mm256_and_si256(n, _mm256_set1_epi16(0x00FF)), 4), _mm256_srli_epi16(n, 8));
+}
 
-					case 0x86:
-						gsmOut[gsmIdx++] = 28;
-						break;
+static inline __attribute__((target("avx2"), always_inline)) __m256i __hex_ascii_avx2(__m256i n)
+{
+	return	_mm256_add_epi8(_mm256_add_epi8(n, _mm256_set1_epi8('0')),
+			_mm256_and_si256(_mm256_cmpgt_epi8(n, _mm256_set1_epi8(9)), _mm256_set1_epi8('A' - '0' - 10)));
+}
 
-					case 0xA6:
-						gsmOut[gsmIdx++] = 29;
-						break;
+static __attribute__((target("avx2"))) int __hex2bin_avx2(const uint8_t *pAsciiStrng, int asciiLen, uint8_t *pHexBuf)
+{
+int	idx = 0, hidx = 0, len;
+__m256i	bad = _mm256_setzero_si256(), a, b, v;
 
-					case 0x9F:
-						gsmOut[gsmIdx++] = 30;
-						break;
+	for (asciiLen &= ~1; idx + 64 <= asciiLen; idx += 64, hidx += 32)
+		{
+		a = __hex_nibbles_avx2(_mm256_loadu_si256((const __m256i *) &pAsciiStrng[idx]), &bad);
+		b = __hex_nibbles_avx2(_mm256_loadu_si256((const __m256i *) &pAsciiStrng[idx + 32]), &bad);
 
-					case 0x89:
-						gsmOut[gsmIdx++] = 31;
-						break;
+		v = _mm256_packus_epi16(__hex_merge_avx2(a), __hex_merge_avx2(b));	/* Packing is per 128-bit lane ... */
+		_mm256_storeu_si256((__m256i *) &pHexBuf[hidx], _mm256_permute4x64_epi64(v, 0xD8)); /* ... restore order */
+		}
 
-					case 0x84:
-						gsmOut[gsmIdx++] = 91;
-						break;
+	if ( _mm256_movemask_epi8(bad) )
+		return	-1;
 
-					case 0x96:
-						gsmOut[gsmIdx++] = 92;
-						break;
+	if ( 0 > (len = __hex2bin_sse2(&pAsciiStrng[idx], asciiLen - idx, &pHexBuf[hidx])) )
+		return	-1;
 
-					case 0x91:
-						gsmOut[gsmIdx++] = 93;
-						break;
+	return	hidx + len;
+}
 
-					case 0x9C:
-						gsmOut[gsmIdx++] = 94;
-						break;
+static __attribute__((target("avx2"))) int __bin2hex_avx2(const unsigned char *pHexBuf, int hexBufLen, unsigned char *pAsciiStrng)
+{
+int	idx = 0;
+__m256i	v, hn, ln, a, b;
 
-					case 0xA4:
-						gsmOut[gsmIdx++] = 123;
-						break;
+	for ( ; idx + 32 <= hexBufLen; idx += 32)
+		{
+		v = _mm256_loadu_si256((const __m256i *) &pHexBuf[idx]);
+		hn = _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0F));
+		ln = _mm256_and_si256(v, _mm256_set1_epi8(0x0F));
 
-					case 0xB6:
-						gsmOut[gsmIdx++] = 124;
-						break;
+		a = __hex_ascii_avx2(_mm256_unpacklo_epi8(hn, ln));		/* Octets 0-7, 16-23 */
+		b = __hex_ascii_avx2(_mm256_unpackhi_epi8(hn, ln));		/* Octets 8-15, 24-31 */
 
-					case 0xB1:
-						gsmOut[gsmIdx++] = 125;
-						break;
+		_mm256_storeu_si256((__m256i *) &pAsciiStrng[idx * 2], _mm256_permute2x128_si256(a, b, 0x20));
+		_mm256_storeu_si256((__m256i *) &pAsciiStrng[idx * 2 + 32], _mm256_permute2x128_si256(a, b, 0x31));
+		}
 
-					case 0xBC:
-						gsmOut[gsmIdx++] = 126;
-						break;
+	return	idx * 2 + __bin2hex_sse2(&pHexBuf[idx], hexBufLen - idx, &pAsciiStrng[idx * 2]);
+}
+#endif	/* PDU_X86_SIMD */
 
-					case 0xA0:
-						gsmOut[gsmIdx++] = 127;
-						break;
+/*  DESCRIPTION: Load up to 8 octets as a little-endian 64-bit word, missing octets are zero.
+ *
+ *   INPUTS:
+ *	p:	octets
+ *	avail:	number of octets available at p
+ *
+ *   RETURNS:
+ *	64-bit word
+ */
+static inline uint64_t __le64_load(const uint8_t *p, int avail)
+{
+uint64_t	v = 0;
 
-					default:
-						gsmOut[gsmIdx++] = ' ';
-						break;
-				}
-				break;
+	if ( avail > 0 )
+		memcpy(&v, p, (avail > 8) ? 8 : avail);
 
+#if	defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+	v = __builtin_bswap64(v);
+#endif
 
-			case 0xce:
-				switch (cIn[cInidx++])
-				{
-					case 0x94:
-						gsmOut[gsmIdx++] = 16;
-						break;
+	return	v;
+}
 
-					case 0xA6:
-						gsmOut[gsmIdx++] = 18;
-						break;
+/*  DESCRIPTION: Unpack septets (GSM 03.38 packing) from the octets, 8 septets per 64-bit word.
+ *
+ *   INPUTS:
+ *	pPduBuf:	packed octets
+ *	pduLen:		number of octets, nothing is read beyond
+ *	skip:		number of septets to skip at beginning
+ *	nsept:		number of septets to unpack
+ *
+ *   OUTPUS:
+ *	pOut:		septets, one per octet
+ *
+ *   RETURNS:
+ *	number of septets
+ */
+static int	__septet_unpack_scalar(const uint8_t *pPduBuf, int pduLen, int skip, int nsept, uint8_t *pOut)
+{
+int	idx, bit, j, n;
+uint64_t	v;
 
-					case 0x9B:
-						gsmOut[gsmIdx++] = 20;
-						break;
+	for (idx = 0; idx < nsept; idx += 8)
+		{
+		bit = (skip + idx) * 7;
+		v = __le64_load(&pPduBuf[bit >> 3], pduLen - (bit >> 3)) >> (bit & 7);
 
-					case 0xA9:
-						gsmOut[gsmIdx++] = 21;
-						break;
+		for (j = 0, n = ((nsept - idx) < 8) ? nsept - idx : 8; j < n; j++, v >>= 7)
+			pOut[idx + j] = v & 0x7F;
+		}
 
-					case 0xA0:
-						gsmOut[gsmIdx++] = 22;
-						break;
+	return	nsept;
+}
 
-					case 0xA8:
-						gsmOut[gsmIdx++] = 23;
-						break;
+#ifdef	PDU_X86_BMI2
+static __attribute__((target("bmi2"))) int __septet_unpack_bmi2(const uint8_t *pPduBuf, int pduLen, int skip, int nsept, uint8_t *pOut)
+{
+int	idx, bit;
+uint64_t	v;
 
-					case 0xA3:
-						gsmOut[gsmIdx++] = 24;
-						break;
+	for (idx = 0; idx < nsept; idx += 8)
+		{
+		bit = (skip + idx) * 7;
+		v = __le64_load(&pPduBuf[bit >> 3], pduLen - (bit >> 3)) >> (bit & 7);
+		v = _pdep_u64(v, 0x7F7F7F7F7F7F7F7FULL);		/* 56 bits -> 8 septets */
 
-					case 0x98:
-						gsmOut[gsmIdx++] = 25;
-						break;
+		memcpy(&pOut[idx], &v, ((nsept - idx) < 8) ? nsept - idx : 8);
+		}
 
-					case 0x9E:
-						gsmOut[gsmIdx++] = 26;
-						break;
+	return	nsept;
+}
+#endif	/* PDU_X86_BMI2 */
 
-					default:
-						gsmOut[gsmIdx++] = ' ';
-						break;
-				}
-				break;
+/*  DESCRIPTION: Store a 64-bit word as little-endian octets.
+ *
+ *   INPUTS:
+ *	v:	64-bit word
+ *	len:	number of low octets to store, 0 - 8
+ *
+ *   OUTPUS:
+ *	p:	octets
+ */
+static inline void __le64_store(uint8_t *p, uint64_t v, int len)
+{
+#if	defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+	v = __builtin_bswap64(v);
+#endif
 
-			case 0xe2:
-				if ((cIn[cInidx++] == 0x82) /*&& (cIn[cInidx++] == 0x03)*/)
-				{
-						switch (cIn[cInidx++])
-						{
-							case 0xAC:
-								gsmOut[gsmIdx++] = ESC_CHR;
-								gsmOut[gsmIdx++] = 0x65;
-								break;
-
-							default:
-								gsmOut[gsmIdx++] = ' ';
-								break;
-						}
-				}
-				break;
+	memcpy(p, &v, len);
+}
 
-			// extension table
-			case '\f':
-				gsmOut[gsmIdx++] = ESC_CHR;
-				gsmOut[gsmIdx++] = 10;
-				break; // form feed, 0x0C
+/*  DESCRIPTION: Pack septets (GSM 03.38 packing) into the octets, 8 septets per 64-bit word.
+ *
+ *   INPUTS:
+ *	pSept:		septets, one per octet
+ *	nsept:		number of septets to pack
+ *	bitOff:		number of fill bits at beginning of the first octet, 0 - 7
+ *
+ *   OUTPUS:
+ *	pOut:		packed octets, exactly (bitOff + nsept * 7 + 7) / 8 octets are written
+ *
+ *   RETURNS:
+ *	number of octets
+ */
+static int	__septet_pack_scalar(const uint8_t *pSept, int nsept, int bitOff, uint8_t *pOut)
+{
+int	idx, bit, j, n;
+uint64_t	v;
 
-			case '^':
-				gsmOut[gsmIdx++] = ESC_CHR;
-				gsmOut[gsmIdx++] = 20;
-				break;
+	pOut[0] = 0;							/* Fill bits */
 
-			case '{':
-				gsmOut[gsmIdx++] = ESC_CHR;
-				gsmOut[gsmIdx++] = 40;
-				break;
+	for (idx = 0; idx < nsept; idx += 8)
+		{
+		n = ((nsept - idx) < 8) ? nsept - idx : 8;
 
-			case '}':
-				gsmOut[gsmIdx++] = ESC_CHR;
-				gsmOut[gsmIdx++] = 41;
-				break;
+		for (v = 0, j = n; j--; )
+			v = (v << 7) | (pSept[idx + j] & 0x7F);
 
-			case '\\':
-				gsmOut[gsmIdx++] = ESC_CHR;
-				gsmOut[gsmIdx++] = 47;
-				break;
+		bit = bitOff + idx * 7;
+		v = (v << (bit & 7)) | (pOut[bit >> 3] & ((1U << (bit & 7)) - 1));
+		__le64_store(&pOut[bit >> 3], v, ((bit & 7) + n * 7 + 7) >> 3);
+		}
 
-			case '[':
-				gsmOut[gsmIdx++] = ESC_CHR;
-				gsmOut[gsmIdx++] = 60;
-				break;
+	return	(bitOff + nsept * 7 + 7) >> 3;
+}
 
-			case '~':
-				gsmOut[gsmIdx++] = ESC_CHR;
-				gsmOut[gsmIdx++] = 61;
-				break;
+#ifdef	PDU_X86_BMI2
+static __attribute__((target("bmi2"))) int __septet_pack_bmi2(const uint8_t *pSept, int nsept, int bitOff, uint8_t *pOut)
+{
+int	idx, bit, n;
+uint64_t	v;
 
-			case ']':
-				gsmOut[gsmIdx++] = ESC_CHR;
-				gsmOut[gsmIdx++] = 62;
-				break;
+	pOut[0] = 0;							/* Fill bits */
 
-			case '|':
-				gsmOut[gsmIdx++] = ESC_CHR;
-				gsmOut[gsmIdx++] = 64;
-				break;
+	for (idx = 0; idx < nsept; idx += 8)
+		{
+		n = ((nsept - idx) < 8) ? nsept - idx : 8;
+		v = _pext_u64(__le64_load(&pSept[idx], n), 0x7F7F7F7F7F7F7F7FULL);	/* 8 septets -> 56 bits */
 
-			default:
-				gsmOut[gsmIdx++] = charVar;
-				break;
+		bit = bitOff + idx * 7;
+		v = (v << (bit & 7)) | (pOut[bit >> 3] & ((1U << (bit & 7)) - 1));
+		__le64_store(&pOut[bit >> 3], v, ((bit & 7) + n * 7 + 7) >> 3);
 		}
-	}
 
-	*gsmLen = gsmIdx;
+	return	(bitOff + nsept * 7 + 7) >> 3;
 }
+#endif	/* PDU_X86_BMI2 */
 
-//***************************************************************************
-// @NAME        : i_Gsm7BitDfltChrToUtf8Chr
-// @PARAM       : char cIn - Gsm7 bit default Character.
-//				  uint8_t *utf8Char - The pointer to converted UTF character.
-//				  uint8_t *utf8CharLen - The pointer to length of converted UTF
-//				 					   character.
-// @RETURNS     : void
-// @DESCRIPTION : This function converts Gsm 7-bit default character to UTF
-//				  characetr set.
-//***************************************************************************
-void i_Gsm7BitDfltChrToUtf8Chr(uint8_t cIn, uint8_t *utf8Char, int *utf8CharLen)
+
+/*
+ * Codec kernels are selected once at run-time according to the CPU features,
+ * the pointers are initially set to resolvers which do selection on the first call.
+ * Pointers are loaded and stored atomically, decoding may start in several threads.
+ */
+#define	__PDU_KERN(kern)	__atomic_load_n(&(kern), __ATOMIC_RELAXED)
+
+static int	__hex2bin_resolve(const uint8_t *asciiStrng, int asciiLen, uint8_t *hexBuf);
+static int	__bin2hex_resolve(const unsigned char *hexBuf, int hexBufLen, unsigned char *asciiStrng);
+static int	__gsm7_ascii_run_resolve(const uint8_t *pStr, int len);
+static int	__septet_unpack_resolve(const uint8_t *pPduBuf, int pduLen, int skip, int nsept, uint8_t *pOut);
+static int	__septet_pack_resolve(const uint8_t *pSept, int nsept, int bitOff, uint8_t *pOut);
+static int	__ucs2_utf8_resolve(const uint8_t *pIn, int inLen, uint8_t *pOut, int outSz);
+static int	__utf8_ucs2_resolve(const uint8_t *pIn, int inLen, uint8_t *pOut, int outSz);
+
+static int	(*__hex2bin_kern)(const uint8_t *, int, uint8_t *) = __hex2bin_resolve;
+static int	(*__bin2hex_kern)(const unsigned char *, int, unsigned char *) = __bin2hex_resolve;
+static int	(*__gsm7_ascii_run_kern)(const uint8_t *, int) = __gsm7_ascii_run_resolve;
+static int	(*__septet_unpack_kern)(const uint8_t *, int, int, int, uint8_t *) = __septet_unpack_resolve;
+static int	(*__septet_pack_kern)(const uint8_t *, int, int, uint8_t *) = __septet_pack_resolve;
+static int	(*__ucs2_utf8_kern)(const uint8_t *, int, uint8_t *, int) = __ucs2_utf8_resolve;
+static int	(*__utf8_ucs2_kern)(const uint8_t *, int, uint8_t *, int) = __utf8_ucs2_resolve;
+
+
+/*  DESCRIPTION: Select codec kernels for a given set of CPU features, can be called
+ *	to force a particular implementation (e.g. scalar in benchmarks).
+ *
+ *   INPUTS:
+ *	cpuFlags:	a mask of PDU_CPU_* flags
+ *
+ *   OUTPUS:
+ *	NONE:
+ *
+ *   RETURNS:
+ *	NONE
+ */
+static void	__pdu_cpu_select(int cpuFlags)
 {
-int idx = 0;
+int	(*hex2bin)(const uint8_t *, int, uint8_t *) = __hex2bin_scalar;
+int	(*bin2hex)(const unsigned char *, int, unsigned char *) = __bin2hex_scalar;
+int	(*asciiRun)(const uint8_t *, int) = __gsm7_ascii_run_scalar;
+int	(*unpack)(const uint8_t *, int, int, int, uint8_t *) = __septet_unpack_scalar;
+int	(*pack)(const uint8_t *, int, int, uint8_t *) = __septet_pack_scalar;
+int	(*ucs2Utf8)(const uint8_t *, int, uint8_t *, int) = __ucs2_utf8_scalar;
+int	(*utf8Ucs2)(const uint8_t *, int, uint8_t *, int) = __utf8_ucs2_scalar;
+
+#ifdef	PDU_X86_SIMD
+	if ( cpuFlags & PDU_CPU_SSE2 )
+		{
+		hex2bin = __hex2bin_sse2;
+		bin2hex = __bin2hex_sse2;
+		asciiRun = __gsm7_ascii_run_sse2;
+		ucs2Utf8 = __ucs2_utf8_sse2;
+		utf8Ucs2 = __utf8_ucs2_sse2;
+		}
 
-	switch(cIn)
-	{
-		// Characters not listed here are equal to those in the
-		// UTF8 charset OR not present in it.
+	if ( cpuFlags & PDU_CPU_AVX2 )
+		{
+		hex2bin = __hex2bin_avx2;
+		bin2hex = __bin2hex_avx2;
+		ucs2Utf8 = __ucs2_utf8_avx2;
+		utf8Ucs2 = __utf8_ucs2_avx2;
+		}
+#endif
 
-		case 0:
-			utf8Char[idx++] = 0x40;
-			break;
+#ifdef	PDU_X86_BMI2
+	if ( cpuFlags & PDU_CPU_BMI2 )
+		{
+		unpack = __septet_unpack_bmi2;
+		pack = __septet_pack_bmi2;
+		}
+#endif
+
+	/* Every pointer is published once with the final choice: threads which resolve
+	 * concurrently store the same values, a reader sees either a resolver or a kernel */
+	__atomic_store_n(&__hex2bin_kern, hex2bin, __ATOMIC_RELAXED);
+	__atomic_store_n(&__bin2hex_kern, bin2hex, __ATOMIC_RELAXED);
+	__atomic_store_n(&__gsm7_ascii_run_kern, asciiRun, __ATOMIC_RELAXED);
+	__atomic_store_n(&__septet_unpack_kern, unpack, __ATOMIC_RELAXED);
+	__atomic_store_n(&__septet_pack_kern, pack, __ATOMIC_RELAXED);
+	__atomic_store_n(&__ucs2_utf8_kern, ucs2Utf8, __ATOMIC_RELAXED);
+	__atomic_store_n(&__utf8_ucs2_kern, utf8Ucs2, __ATOMIC_RELAXED);
+}
 
-		case 1:
-			utf8Char[idx++] = 0xc2;
-			utf8Char[idx++] = 0xA3;
-			break;
+/*  DESCRIPTION: Detect CPU features available for the codec kernels.
+ *
+ *   RETURNS:
+ *	a mask of PDU_CPU_* flags
+ */
+static int	__pdu_cpu_detect(void)
+{
+int	cpuFlags = 0;
 
-		case 2:
-			utf8Char[idx++] = 0x24;
-			break;
+#ifdef	PDU_X86_SIMD
+	__builtin_cpu_init();
 
-		case 3:
-			utf8Char[idx++] = 0xc2;
-			utf8Char[idx++] = 0xA5;
-			break;
+	cpuFlags |= __builtin_cpu_supports("sse2") ? PDU_CPU_SSE2 : 0;
+	cpuFlags |= __builtin_cpu_supports("avx2") ? PDU_CPU_AVX2 : 0;
+	cpuFlags |= __builtin_cpu_supports("bmi2") ? PDU_CPU_BMI2 : 0;
+#endif
 
-		case 4:
-			utf8Char[idx++] = 0xc3;
-			utf8Char[idx++] = 0xA8;
-			break;
+	return	cpuFlags;
+}
 
-		case 5:
-			utf8Char[idx++] = 0xc3;
-			utf8Char[idx++] = 0xA9;
-			break;
+static int	__hex2bin_resolve(const uint8_t *asciiStrng, int asciiLen, uint8_t *hexBuf)
+{
+	__pdu_cpu_select(__pdu_cpu_detect());
 
-		case 6:
-			utf8Char[idx++] = 0xc3;
-			utf8Char[idx++] = 0xB9;
-			break;
+	return	__PDU_KERN(__hex2bin_kern)(asciiStrng, asciiLen, hexBuf);
+}
 
-		case 7:
-			utf8Char[idx++] = 0xc3;
-			utf8Char[idx++] = 0xAC;
-			break;
+static int	__bin2hex_resolve(const unsigned char *hexBuf, int hexBufLen, unsigned char *asciiStrng)
+{
+	__pdu_cpu_select(__pdu_cpu_detect());
 
-		case 8:
-			utf8Char[idx++] = 0xc3;
-			utf8Char[idx++] = 0xB2;
-			break;
+	return	__PDU_KERN(__bin2hex_kern)(hexBuf, hexBufLen, asciiStrng);
+}
 
-		case 9:
-			utf8Char[idx++] = 0xc3;
-			utf8Char[idx++] = 0x87;
-			break;
+static int	__gsm7_ascii_run_resolve(const uint8_t *pStr, int len)
+{
+	__pdu_cpu_select(__pdu_cpu_detect());
 
-		case 11:
-			utf8Char[idx++] = 0xc3;
-			utf8Char[idx++] = 0x98;
-			break;
+	return	__PDU_KERN(__gsm7_ascii_run_kern)(pStr, len);
+}
 
-		case 12:
-			utf8Char[idx++] = 0xc3;
-			utf8Char[idx++] = 0xB8;
-			break;
+static int	__septet_unpack_resolve(const uint8_t *pPduBuf, int pduLen, int skip, int nsept, uint8_t *pOut)
+{
+	__pdu_cpu_select(__pdu_cpu_detect());
 
-		case 14:
-			utf8Char[idx++] = 0xc3;
-			utf8Char[idx++] = 0x85;
-			break;
+	return	__PDU_KERN(__septet_unpack_kern)(pPduBuf, pduLen, skip, nsept, pOut);
+}
 
-		case 15:
-			utf8Char[idx++] = 0xc3;
-			utf8Char[idx++] = 0xA5;
-			break;
+static int	__septet_pack_resolve(const uint8_t *pSept, int nsept, int bitOff, uint8_t *pOut)
+{
+	__pdu_cpu_select(__pdu_cpu_detect());
 
-		case 16:
-			utf8Char[idx++] = 0xce;
-			utf8Char[idx++] = 0x94;
-			break;	/* Added */
+	return	__PDU_KERN(__septet_pack_kern)(pSept, nsept, bitOff, pOut);
+}
 
-		case 17:
-			utf8Char[idx++] = 0x5F;
-			break;
+static int	__ucs2_utf8_resolve(const uint8_t *pIn, int inLen, uint8_t *pOut, int outSz)
+{
+	__pdu_cpu_select(__pdu_cpu_detect());
 
-		case 18:
-			utf8Char[idx++] = 0xce;
-			utf8Char[idx++] = 0xA6;
-			break;	/* Added */
-
-		case 19:
-			/* Pending */
-			break;	/* Added */
-
-		case 20:
-			utf8Char[idx++] = 0xce;
-			utf8Char[idx++] = 0x9B;
-			break;	/* Added */
-
-		case 21:
-			utf8Char[idx++] = 0xce;
-			utf8Char[idx++] = 0xA9;
-			break;	/* Added */
-
-		case 22:
-			utf8Char[idx++] = 0xce;
-			utf8Char[idx++] = 0xA0;
-			break;	/* Added */
-
-		case 23:
-			utf8Char[idx++] = 0xce;
-			utf8Char[idx++] = 0xA8;
-			break;	/* Added */
-
-		case 24:
-			utf8Char[idx++] = 0xce;
-			utf8Char[idx++] = 0xA3;
-			break;	/* Added */
-
-		case 25:
-			utf8Char[idx++] = 0xce;
-			utf8Char[idx++] = 0x98;
-			break;	/* Added */
-		case 26:
-			utf8Char[idx++] = 0xce;
-			utf8Char[idx++] = 0x9E;
-			break;	/* Added */
-
-		case 28:
-			utf8Char[idx++] = 0xc3;
-			utf8Char[idx++] = 0x86;
-			break;
+	return	__PDU_KERN(__ucs2_utf8_kern)(pIn, inLen, pOut, outSz);
+}
 
-		case 29:
-			utf8Char[idx++] = 0xc3;
-			utf8Char[idx++] = 0xA6;
-			break;
+static int	__utf8_ucs2_resolve(const uint8_t *pIn, int inLen, uint8_t *pOut, int outSz)
+{
+	__pdu_cpu_select(__pdu_cpu_detect());
 
-		case 30:
-			utf8Char[idx++] = 0xc3;
-			utf8Char[idx++] = 0x9F;
-			break;
+	return	__PDU_KERN(__utf8_ucs2_kern)(pIn, inLen, pOut, outSz);
+}
 
-		case 31:
-			utf8Char[idx++] = 0xc3;
-			utf8Char[idx++] = 0x89;
-			break;
+//***************************************************************************
+// @NAME        : __bin2hex / __hex2bin
+// @DESCRIPTION : Entry points to the HEX codec kernels selected at run-time.
+//***************************************************************************
+static inline int __bin2hex(const unsigned char *pHexBuf, int hexBufLen, unsigned char *pAsciiStrng)
+{
+	return	__PDU_KERN(__bin2hex_kern)(pHexBuf, hexBufLen, pAsciiStrng);
+}
 
-		case 36:
-			utf8Char[idx++] = 0xc2;
-			utf8Char[idx++] = 0xA4;
-			break; // 164 in UTF8
+static inline int __hex2bin(const uint8_t *pAsciiStrng, int asciiLen, uint8_t *pHexBuf)
+{
+	return	__PDU_KERN(__hex2bin_kern)(pAsciiStrng, asciiLen, pHexBuf);
+}
 
-		case 64:
-			utf8Char[idx++] = 0xc2;
-			utf8Char[idx++] = 0xA1;
-			break;
+/* GSM 7-bit septet to UTF-8 conversion entry */
+typedef struct
+{
+	uint8_t	len;							/* Length of the UTF-8 sequence */
+	uint8_t	utf8[3];						/* UTF-8 sequence, zero padded */
+} GSM7_UTF8_DESC;
+
+static const GSM7_UTF8_DESC	__gsm7_dflt_utf8[128] = {	/* GSM 03.38 default alphabet */
+	{ 1, { 0x40, 0x00, 0x00 } },	/* 0x00 @ */
+	{ 2, { 0xC2, 0xA3, 0x00 } },	/* 0x01 U+00A3 */
+	{ 1, { 0x24, 0x00, 0x00 } },	/* 0x02 $ */
+	{ 2, { 0xC2, 0xA5, 0x00 } },	/* 0x03 U+00A5 */
+	{ 2, { 0xC3, 0xA8, 0x00 } },	/* 0x04 U+00E8 */
+	{ 2, { 0xC3, 0xA9, 0x00 } },	/* 0x05 U+00E9 */
+	{ 2, { 0xC3, 0xB9, 0x00 } },	/* 0x06 U+00F9 */
+	{ 2, { 0xC3, 0xAC, 0x00 } },	/* 0x07 U+00EC */
+	{ 2, { 0xC3, 0xB2, 0x00 } },	/* 0x08 U+00F2 */
+	{ 2, { 0xC3, 0x87, 0x00 } },	/* 0x09 U+00C7 */
+	{ 1, { 0x0A, 0x00, 0x00 } },	/* 0x0A LF */
+	{ 2, { 0xC3, 0x98, 0x00 } },	/* 0x0B U+00D8 */
+	{ 2, { 0xC3, 0xB8, 0x00 } },	/* 0x0C U+00F8 */
+	{ 1, { 0x0D, 0x00, 0x00 } },	/* 0x0D CR */
+	{ 2, { 0xC3, 0x85, 0x00 } },	/* 0x0E U+00C5 */
+	{ 2, { 0xC3, 0xA5, 0x00 } },	/* 0x0F U+00E5 */
+	{ 2, { 0xCE, 0x94, 0x00 } },	/* 0x10 U+0394 */
+	{ 1, { 0x5F, 0x00, 0x00 } },	/* 0x11 _ */
+	{ 2, { 0xCE, 0xA6, 0x00 } },	/* 0x12 U+03A6 */
+	{ 2, { 0xCE, 0x93, 0x00 } },	/* 0x13 U+0393 */
+	{ 2, { 0xCE, 0x9B, 0x00 } },	/* 0x14 U+039B */
+	{ 2, { 0xCE, 0xA9, 0x00 } },	/* 0x15 U+03A9 */
+	{ 2, { 0xCE, 0xA0, 0x00 } },	/* 0x16 U+03A0 */
+	{ 2, { 0xCE, 0xA8, 0x00 } },	/* 0x17 U+03A8 */
+	{ 2, { 0xCE, 0xA3, 0x00 } },	/* 0x18 U+03A3 */
+	{ 2, { 0xCE, 0x98, 0x00 } },	/* 0x19 U+0398 */
+	{ 2, { 0xCE, 0x9E, 0x00 } },	/* 0x1A U+039E */
+	{ 1, { 0x20, 0x00, 0x00 } },	/* 0x1B SP */
+	{ 2, { 0xC3, 0x86, 0x00 } },	/* 0x1C U+00C6 */
+	{ 2, { 0xC3, 0xA6, 0x00 } },	/* 0x1D U+00E6 */
+	{ 2, { 0xC3, 0x9F, 0x00 } },	/* 0x1E U+00DF */
+	{ 2, { 0xC3, 0x89, 0x00 } },	/* 0x1F U+00C9 */
+	{ 1, { 0x20, 0x00, 0x00 } },	/* 0x20 SP */
+	{ 1, { 0x21, 0x00, 0x00 } },	/* 0x21 ! */
+	{ 1, { 0x22, 0x00, 0x00 } },	/* 0x22 " */
+	{ 1, { 0x23, 0x00, 0x00 } },	/* 0x23 # */
+	{ 2, { 0xC2, 0xA4, 0x00 } },	/* 0x24 U+00A4 */
+	{ 1, { 0x25, 0x00, 0x00 } },	/* 0x25 % */
+	{ 1, { 0x26, 0x00, 0x00 } },	/* 0x26 & */
+	{ 1, { 0x27, 0x00, 0x00 } },	/* 0x27 ' */
+	{ 1, { 0x28, 0x00, 0x00 } },	/* 0x28 ( */
+	{ 1, { 0x29, 0x00, 0x00 } },	/* 0x29 ) */
+	{ 1, { 0x2A, 0x00, 0x00 } },	/* 0x2A * */
+	{ 1, { 0x2B, 0x00, 0x00 } },	/* 0x2B + */
+	{ 1, { 0x2C, 0x00, 0x00 } },	/* 0x2C , */
+	{ 1, { 0x2D, 0x00, 0x00 } },	/* 0x2D - */
+	{ 1, { 0x2E, 0x00, 0x00 } },	/* 0x2E . */
+	{ 1, { 0x2F, 0x00, 0x00 } },	/* 0x2F / */
+	{ 1, { 0x30, 0x00, 0x00 } },	/* 0x30 0 */
+	{ 1, { 0x31, 0x00, 0x00 } },	/* 0x31 1 */
+	{ 1, { 0x32, 0x00, 0x00 } },	/* 0x32 2 */
+	{ 1, { 0x33, 0x00, 0x00 } },	/* 0x33 3 */
+	{ 1, { 0x34, 0x00, 0x00 } },	/* 0x34 4 */
+	{ 1, { 0x35, 0x00, 0x00 } },	/* 0x35 5 */
+	{ 1, { 0x36, 0x00, 0x00 } },	/* 0x36 6 */
+	{ 1, { 0x37, 0x00, 0x00 } },	/* 0x37 7 */
+	{ 1, { 0x38, 0x00, 0x00 } },	/* 0x38 8 */
+	{ 1, { 0x39, 0x00, 0x00 } },	/* 0x39 9 */
+	{ 1, { 0x3A, 0x00, 0x00 } },	/* 0x3A : */
+	{ 1, { 0x3B, 0x00, 0x00 } },	/* 0x3B ; */
+	{ 1, { 0x3C, 0x00, 0x00 } },	/* 0x3C < */
+	{ 1, { 0x3D, 0x00, 0x00 } },	/* 0x3D = */
+	{ 1, { 0x3E, 0x00, 0x00 } },	/* 0x3E > */
+	{ 1, { 0x3F, 0x00, 0x00 } },	/* 0x3F ? */
+	{ 2, { 0xC2, 0xA1, 0x00 } },	/* 0x40 U+00A1 */
+	{ 1, { 0x41, 0x00, 0x00 } },	/* 0x41 A */
+	{ 1, { 0x42, 0x00, 0x00 } },	/* 0x42 B */
+	{ 1, { 0x43, 0x00, 0x00 } },	/* 0x43 C */
+	{ 1, { 0x44, 0x00, 0x00 } },	/* 0x44 D */
+	{ 1, { 0x45, 0x00, 0x00 } },	/* 0x45 E */
+	{ 1, { 0x46, 0x00, 0x00 } },	/* 0x46 F */
+	{ 1, { 0x47, 0x00, 0x00 } },	/* 0x47 G */
+	{ 1, { 0x48, 0x00, 0x00 } },	/* 0x48 H */
+	{ 1, { 0x49, 0x00, 0x00 } },	/* 0x49 I */
+	{ 1, { 0x4A, 0x00, 0x00 } },	/* 0x4A J */
+	{ 1, { 0x4B, 0x00, 0x00 } },	/* 0x4B K */
+	{ 1, { 0x4C, 0x00, 0x00 } },	/* 0x4C L */
+	{ 1, { 0x4D, 0x00, 0x00 } },	/* 0x4D M */
+	{ 1, { 0x4E, 0x00, 0x00 } },	/* 0x4E N */
+	{ 1, { 0x4F, 0x00, 0x00 } },	/* 0x4F O */
+	{ 1, { 0x50, 0x00, 0x00 } },	/* 0x50 P */
+	{ 1, { 0x51, 0x00, 0x00 } },	/* 0x51 Q */
+	{ 1, { 0x52, 0x00, 0x00 } },	/* 0x52 R */
+	{ 1, { 0x53, 0x00, 0x00 } },	/* 0x53 S */
+	{ 1, { 0x54, 0x00, 0x00 } },	/* 0x54 T */
+	{ 1, { 0x55, 0x00, 0x00 } },	/* 0x55 U */
+	{ 1, { 0x56, 0x00, 0x00 } },	/* 0x56 V */
+	{ 1, { 0x57, 0x00, 0x00 } },	/* 0x57 W */
+	{ 1, { 0x58, 0x00, 0x00 } },	/* 0x58 X */
+	{ 1, { 0x59, 0x00, 0x00 } },	/* 0x59 Y */
+	{ 1, { 0x5A, 0x00, 0x00 } },	/* 0x5A Z */
+	{ 2, { 0xC3, 0x84, 0x00 } },	/* 0x5B U+00C4 */
+	{ 2, { 0xC3, 0x96, 0x00 } },	/* 0x5C U+00D6 */
+	{ 2, { 0xC3, 0x91, 0x00 } },	/* 0x5D U+00D1 */
+	{ 2, { 0xC3, 0x9C, 0x00 } },	/* 0x5E U+00DC */
+	{ 2, { 0xC2, 0xA7, 0x00 } },	/* 0x5F U+00A7 */
+	{ 2, { 0xC2, 0xBF, 0x00 } },	/* 0x60 U+00BF */
+	{ 1, { 0x61, 0x00, 0x00 } },	/* 0x61 a */
+	{ 1, { 0x62, 0x00, 0x00 } },	/* 0x62 b */
+	{ 1, { 0x63, 0x00, 0x00 } },	/* 0x63 c */
+	{ 1, { 0x64, 0x00, 0x00 } },	/* 0x64 d */
+	{ 1, { 0x65, 0x00, 0x00 } },	/* 0x65 e */
+	{ 1, { 0x66, 0x00, 0x00 } },	/* 0x66 f */
+	{ 1, { 0x67, 0x00, 0x00 } },	/* 0x67 g */
+	{ 1, { 0x68, 0x00, 0x00 } },	/* 0x68 h */
+	{ 1, { 0x69, 0x00, 0x00 } },	/* 0x69 i */
+	{ 1, { 0x6A, 0x00, 0x00 } },	/* 0x6A j */
+	{ 1, { 0x6B, 0x00, 0x00 } },	/* 0x6B k */
+	{ 1, { 0x6C, 0x00, 0x00 } },	/* 0x6C l */
+	{ 1, { 0x6D, 0x00, 0x00 } },	/* 0x6D m */
+	{ 1, { 0x6E, 0x00, 0x00 } },	/* 0x6E n */
+	{ 1, { 0x6F, 0x00, 0x00 } },	/* 0x6F o */
+	{ 1, { 0x70, 0x00, 0x00 } },	/* 0x70 p */
+	{ 1, { 0x71, 0x00, 0x00 } },	/* 0x71 q */
+	{ 1, { 0x72, 0x00, 0x00 } },	/* 0x72 r */
+	{ 1, { 0x73, 0x00, 0x00 } },	/* 0x73 s */
+	{ 1, { 0x74, 0x00, 0x00 } },	/* 0x74 t */
+	{ 1, { 0x75, 0x00, 0x00 } },	/* 0x75 u */
+	{ 1, { 0x76, 0x00, 0x00 } },	/* 0x76 v */
+	{ 1, { 0x77, 0x00, 0x00 } },	/* 0x77 w */
+	{ 1, { 0x78, 0x00, 0x00 } },	/* 0x78 x */
+	{ 1, { 0x79, 0x00, 0x00 } },	/* 0x79 y */
+	{ 1, { 0x7A, 0x00, 0x00 } },	/* 0x7A z */
+	{ 2, { 0xC3, 0xA4, 0x00 } },	/* 0x7B U+00E4 */
+	{ 2, { 0xC3, 0xB6, 0x00 } },	/* 0x7C U+00F6 */
+	{ 2, { 0xC3, 0xB1, 0x00 } },	/* 0x7D U+00F1 */
+	{ 2, { 0xC3, 0xBC, 0x00 } },	/* 0x7E U+00FC */
+	{ 2, { 0xC3, 0xA0, 0x00 } },	/* 0x7F U+00E0 */
+};
 
-		// 65-90 capital letters
-		case 91:
-			utf8Char[idx++] = 0xc3;
-			utf8Char[idx++] = 0x84;
-			break;
-
-		case 92:
-			utf8Char[idx++] = 0xc3;
-			utf8Char[idx++] = 0x96;
-			break;
+static const GSM7_UTF8_DESC	__gsm7_ext_utf8[128] = {	/* Extension table (after ESC), others are as in the default one */
+	{ 1, { 0x40, 0x00, 0x00 } },	/* 0x00 @ */
+	{ 2, { 0xC2, 0xA3, 0x00 } },	/* 0x01 U+00A3 */
+	{ 1, { 0x24, 0x00, 0x00 } },	/* 0x02 $ */
+	{ 2, { 0xC2, 0xA5, 0x00 } },	/* 0x03 U+00A5 */
+	{ 2, { 0xC3, 0xA8, 0x00 } },	/* 0x04 U+00E8 */
+	{ 2, { 0xC3, 0xA9, 0x00 } },	/* 0x05 U+00E9 */
+	{ 2, { 0xC3, 0xB9, 0x00 } },	/* 0x06 U+00F9 */
+	{ 2, { 0xC3, 0xAC, 0x00 } },	/* 0x07 U+00EC */
+	{ 2, { 0xC3, 0xB2, 0x00 } },	/* 0x08 U+00F2 */
+	{ 2, { 0xC3, 0x87, 0x00 } },	/* 0x09 U+00C7 */
+	{ 1, { 0x0C, 0x00, 0x00 } },	/* 0x0A FF */
+	{ 2, { 0xC3, 0x98, 0x00 } },	/* 0x0B U+00D8 */
+	{ 2, { 0xC3, 0xB8, 0x00 } },	/* 0x0C U+00F8 */
+	{ 1, { 0x0D, 0x00, 0x00 } },	/* 0x0D CR */
+	{ 2, { 0xC3, 0x85, 0x00 } },	/* 0x0E U+00C5 */
+	{ 2, { 0xC3, 0xA5, 0x00 } },	/* 0x0F U+00E5 */
+	{ 2, { 0xCE, 0x94, 0x00 } },	/* 0x10 U+0394 */
+	{ 1, { 0x5F, 0x00, 0x00 } },	/* 0x11 _ */
+	{ 2, { 0xCE, 0xA6, 0x00 } },	/* 0x12 U+03A6 */
+	{ 2, { 0xCE, 0x93, 0x00 } },	/* 0x13 U+0393 */
+	{ 1, { 0x5E, 0x00, 0x00 } },	/* 0x14 ^ */
+	{ 2, { 0xCE, 0xA9, 0x00 } },	/* 0x15 U+03A9 */
+	{ 2, { 0xCE, 0xA0, 0x00 } },	/* 0x16 U+03A0 */
+	{ 2, { 0xCE, 0xA8, 0x00 } },	/* 0x17 U+03A8 */
+	{ 2, { 0xCE, 0xA3, 0x00 } },	/* 0x18 U+03A3 */
+	{ 2, { 0xCE, 0x98, 0x00 } },	/* 0x19 U+0398 */
+	{ 2, { 0xCE, 0x9E, 0x00 } },	/* 0x1A U+039E */
+	{ 1, { 0x20, 0x00, 0x00 } },	/* 0x1B SP */
+	{ 2, { 0xC3, 0x86, 0x00 } },	/* 0x1C U+00C6 */
+	{ 2, { 0xC3, 0xA6, 0x00 } },	/* 0x1D U+00E6 */
+	{ 2, { 0xC3, 0x9F, 0x00 } },	/* 0x1E U+00DF */
+	{ 2, { 0xC3, 0x89, 0x00 } },	/* 0x1F U+00C9 */
+	{ 1, { 0x20, 0x00, 0x00 } },	/* 0x20 SP */
+	{ 1, { 0x21, 0x00, 0x00 } },	/* 0x21 ! */
+	{ 1, { 0x22, 0x00, 0x00 } },	/* 0x22 " */
+	{ 1, { 0x23, 0x00, 0x00 } },	/* 0x23 # */
+	{ 2, { 0xC2, 0xA4, 0x00 } },	/* 0x24 U+00A4 */
+	{ 1, { 0x25, 0x00, 0x00 } },	/* 0x25 % */
+	{ 1, { 0x26, 0x00, 0x00 } },	/* 0x26 & */
+	{ 1, { 0x27, 0x00, 0x00 } },	/* 0x27 ' */
+	{ 1, { 0x7B, 0x00, 0x00 } },	/* 0x28 { */
+	{ 1, { 0x7D, 0x00, 0x00 } },	/* 0x29 } */
+	{ 1, { 0x2A, 0x00, 0x00 } },	/* 0x2A * */
+	{ 1, { 0x2B, 0x00, 0x00 } },	/* 0x2B + */
+	{ 1, { 0x2C, 0x00, 0x00 } },	/* 0x2C , */
+	{ 1, { 0x2D, 0x00, 0x00 } },	/* 0x2D - */
+	{ 1, { 0x2E, 0x00, 0x00 } },	/* 0x2E . */
+	{ 1, { 0x5C, 0x00, 0x00 } },	/* 0x2F backslash */
+	{ 1, { 0x30, 0x00, 0x00 } },	/* 0x30 0 */
+	{ 1, { 0x31, 0x00, 0x00 } },	/* 0x31 1 */
+	{ 1, { 0x32, 0x00, 0x00 } },	/* 0x32 2 */
+	{ 1, { 0x33, 0x00, 0x00 } },	/* 0x33 3 */
+	{ 1, { 0x34, 0x00, 0x00 } },	/* 0x34 4 */
+	{ 1, { 0x35, 0x00, 0x00 } },	/* 0x35 5 */
+	{ 1, { 0x36, 0x00, 0x00 } },	/* 0x36 6 */
+	{ 1, { 0x37, 0x00, 0x00 } },	/* 0x37 7 */
+	{ 1, { 0x38, 0x00, 0x00 } },	/* 0x38 8 */
+	{ 1, { 0x39, 0x00, 0x00 } },	/* 0x39 9 */
+	{ 1, { 0x3A, 0x00, 0x00 } },	/* 0x3A : */
+	{ 1, { 0x3B, 0x00, 0x00 } },	/* 0x3B ; */
+	{ 1, { 0x5B, 0x00, 0x00 } },	/* 0x3C [ */
+	{ 1, { 0x7E, 0x00, 0x00 } },	/* 0x3D ~ */
+	{ 1, { 0x5D, 0x00, 0x00 } },	/* 0x3E ] */
+	{ 1, { 0x3F, 0x00, 0x00 } },	/* 0x3F ? */
+	{ 1, { 0x7C, 0x00, 0x00 } },	/* 0x40 | */
+	{ 1, { 0x41, 0x00, 0x00 } },	/* 0x41 A */
+	{ 1, { 0x42, 0x00, 0x00 } },	/* 0x42 B */
+	{ 1, { 0x43, 0x00, 0x00 } },	/* 0x43 C */
+	{ 1, { 0x44, 0x00, 0x00 } },	/* 0x44 D */
+	{ 1, { 0x45, 0x00, 0x00 } },	/* 0x45 E */
+	{ 1, { 0x46, 0x00, 0x00 } },	/* 0x46 F */
+	{ 1, { 0x47, 0x00, 0x00 } },	/* 0x47 G */
+	{ 1, { 0x48, 0x00, 0x00 } },	/* 0x48 H */
+	{ 1, { 0x49, 0x00, 0x00 } },	/* 0x49 I */
+	{ 1, { 0x4A, 0x00, 0x00 } },	/* 0x4A J */
+	{ 1, { 0x4B, 0x00, 0x00 } },	/* 0x4B K */
+	{ 1, { 0x4C, 0x00, 0x00 } },	/* 0x4C L */
+	{ 1, { 0x4D, 0x00, 0x00 } },	/* 0x4D M */
+	{ 1, { 0x4E, 0x00, 0x00 } },	/* 0x4E N */
+	{ 1, { 0x4F, 0x00, 0x00 } },	/* 0x4F O */
+	{ 1, { 0x50, 0x00, 0x00 } },	/* 0x50 P */
+	{ 1, { 0x51, 0x00, 0x00 } },	/* 0x51 Q */
+	{ 1, { 0x52, 0x00, 0x00 } },	/* 0x52 R */
+	{ 1, { 0x53, 0x00, 0x00 } },	/* 0x53 S */
+	{ 1, { 0x54, 0x00, 0x00 } },	/* 0x54 T */
+	{ 1, { 0x55, 0x00, 0x00 } },	/* 0x55 U */
+	{ 1, { 0x56, 0x00, 0x00 } },	/* 0x56 V */
+	{ 1, { 0x57, 0x00, 0x00 } },	/* 0x57 W */
+	{ 1, { 0x58, 0x00, 0x00 } },	/* 0x58 X */
+	{ 1, { 0x59, 0x00, 0x00 } },	/* 0x59 Y */
+	{ 1, { 0x5A, 0x00, 0x00 } },	/* 0x5A Z */
+	{ 2, { 0xC3, 0x84, 0x00 } },	/* 0x5B U+00C4 */
+	{ 2, { 0xC3, 0x96, 0x00 } },	/* 0x5C U+00D6 */
+	{ 2, { 0xC3, 0x91, 0x00 } },	/* 0x5D U+00D1 */
+	{ 2, { 0xC3, 0x9C, 0x00 } },	/* 0x5E U+00DC */
+	{ 2, { 0xC2, 0xA7, 0x00 } },	/* 0x5F U+00A7 */
+	{ 2, { 0xC2, 0xBF, 0x00 } },	/* 0x60 U+00BF */
+	{ 1, { 0x61, 0x00, 0x00 } },	/* 0x61 a */
+	{ 1, { 0x62, 0x00, 0x00 } },	/* 0x62 b */
+	{ 1, { 0x63, 0x00, 0x00 } },	/* 0x63 c */
+	{ 1, { 0x64, 0x00, 0x00 } },	/* 0x64 d */
+	{ 3, { 0xE2, 0x82, 0xAC } },	/* 0x65 U+20AC */
+	{ 1, { 0x66, 0x00, 0x00 } },	/* 0x66 f */
+	{ 1, { 0x67, 0x00, 0x00 } },	/* 0x67 g */
+	{ 1, { 0x68, 0x00, 0x00 } },	/* 0x68 h */
+	{ 1, { 0x69, 0x00, 0x00 } },	/* 0x69 i */
+	{ 1, { 0x6A, 0x00, 0x00 } },	/* 0x6A j */
+	{ 1, { 0x6B, 0x00, 0x00 } },	/* 0x6B k */
+	{ 1, { 0x6C, 0x00, 0x00 } },	/* 0x6C l */
+	{ 1, { 0x6D, 0x00, 0x00 } },	/* 0x6D m */
+	{ 1, { 0x6E, 0x00, 0x00 } },	/* 0x6E n */
+	{ 1, { 0x6F, 0x00, 0x00 } },	/* 0x6F o */
+	{ 1, { 0x70, 0x00, 0x00 } },	/* 0x70 p */
+	{ 1, { 0x71, 0x00, 0x00 } },	/* 0x71 q */
+	{ 1, { 0x72, 0x00, 0x00 } },	/* 0x72 r */
+	{ 1, { 0x73, 0x00, 0x00 } },	/* 0x73 s */
+	{ 1, { 0x74, 0x00, 0x00 } },	/* 0x74 t */
+	{ 1, { 0x75, 0x00, 0x00 } },	/* 0x75 u */
+	{ 1, { 0x76, 0x00, 0x00 } },	/* 0x76 v */
+	{ 1, { 0x77, 0x00, 0x00 } },	/* 0x77 w */
+	{ 1, { 0x78, 0x00, 0x00 } },	/* 0x78 x */
+	{ 1, { 0x79, 0x00, 0x00 } },	/* 0x79 y */
+	{ 1, { 0x7A, 0x00, 0x00 } },	/* 0x7A z */
+	{ 2, { 0xC3, 0xA4, 0x00 } },	/* 0x7B U+00E4 */
+	{ 2, { 0xC3, 0xB6, 0x00 } },	/* 0x7C U+00F6 */
+	{ 2, { 0xC3, 0xB1, 0x00 } },	/* 0x7D U+00F1 */
+	{ 2, { 0xC3, 0xBC, 0x00 } },	/* 0x7E U+00FC */
+	{ 2, { 0xC3, 0xA0, 0x00 } },	/* 0x7F U+00E0 */
+};
 
-		case 93:
-			utf8Char[idx++] = 0xc3;
-			utf8Char[idx++] = 0x91;
-			break;
+/* Septets which are the same characters in UTF-8: 0x20-0x23, 0x25-0x3F, 0x41-0x5A, 0x61-0x7A */
+static const uint32_t	__gsm7_ascii_map[4] = { 0x00000000, 0xFFFFFFEF, 0x07FFFFFE, 0x07FFFFFE };
 
-		case 94:
-			utf8Char[idx++] = 0xc3;
-			utf8Char[idx++] = 0x9C;
-			break;
+#define	__GSM7_IS_ASCII(c)	( ((c) < 0x80) && ((__gsm7_ascii_map[(c) >> 5] >> ((c) & 0x1F)) & 1) )
 
-		case 95:
-			utf8Char[idx++] = 0xc2;
-			utf8Char[idx++] = 0xA7;
-			break;
 
-		case 96:
-			utf8Char[idx++] = 0xc2;
-			utf8Char[idx++] = 0xBF;
-			break;
+/*  DESCRIPTION: Count leading characters which have the same code in GSM 7-bit
+ *	default alphabet and in ASCII/UTF-8, so such runs can be copied as is in
+ *	both directions.
+ *
+ *   INPUTS:
+ *	pStr:	a string of septets or UTF-8 characters
+ *	len:	length of the string
+ *
+ *   RETURNS:
+ *	length of the run
+ */
+static int	__gsm7_ascii_run_scalar(const uint8_t *pStr, int len)
+{
+int	idx;
 
-		// 97-122 small letters
-		case 123:
-			utf8Char[idx++] = 0xc3;
-			utf8Char[idx++] = 0xA4;
-			break;
+	for (idx = 0; (idx < len) && __GSM7_IS_ASCII(pStr[idx]); idx++);
 
-		case 124:
-			utf8Char[idx++] = 0xc3;
-			utf8Char[idx++] = 0xB6;
-			break;
+	return	idx;
+}
 
-		case 125:
-			utf8Char[idx++] = 0xc3;
-			utf8Char[idx++] = 0xB1;
-			break;
+#ifdef	PDU_X86_SIMD
+static __attribute__((target("sse2"))) int __gsm7_ascii_run_sse2(const uint8_t *pStr, int len)
+{
+int	idx = 0;
+unsigned	mask;
+__m128i	c, in, out;
 
-		case 126:
-			utf8Char[idx++] = 0xc3;
-			utf8Char[idx++] = 0xBC;
-			break;
+	for ( ; idx + 16 <= len; idx += 16)
+		{
+		c = _mm_loadu_si128((const __m128i *) &pStr[idx]);
 
-		case 127:
-			utf8Char[idx++] = 0xc3;
-			utf8Char[idx++] = 0xA0;
-			break;
+		in = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8(0x1F)), _mm_cmpgt_epi8(_mm_set1_epi8(0x7B), c));
+		out = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8(0x24)), _mm_cmpeq_epi8(c, _mm_set1_epi8(0x40))),
+			_mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8(0x5A)), _mm_cmpgt_epi8(_mm_set1_epi8(0x61), c)));
 
-		default:
-			utf8Char[idx++] = cIn;
-			break;
-	}
+		if ( 0xFFFF != (mask = _mm_movemask_epi8(_mm_andnot_si128(out, in))) )
+			return	idx + __builtin_ctz(~mask);
+		}
 
-	*utf8CharLen = idx;
+	return	idx + __gsm7_ascii_run_scalar(&pStr[idx], len - idx);
 }
+#endif	/* PDU_X86_SIMD */
 
 //***************************************************************************
-// @NAME        : i_GsmExt7BitChrToUtf8Chr
-// @PARAM       : char cIn - Gsm extended 7-bit default Character.
-//				  uint8_t *utf8Char - The pointer to converted UTF character.
-//				  uint8_t *utf8CharLen - The pointer to length of converted UTF
-//				 					   character.
-// @RETURNS     : void
-// @DESCRIPTION : This function converts Gsm extended 7-bit character to UTF
-//				  characetr set.
+// @NAME        : i_GsmStrToUtf8Str
+// @PARAM       : uint8_t *pStrInGsm - The pointer to string with Gsm character set.
+//				  uint8_t strInGsmLen - length of string with gsm character set..
+//				  uint8_t *pStrOutUtf - The pointer to buffer containing converted
+//									  UTF8 character set.
+//				  int outSz - size of the output buffer including NUL
+// @RETURNS     : Length of the UTF-8 string
+// @DESCRIPTION : This function converts Gsm 7-bit characters to UTF8 characters,
+//				  runs of ASCII-identical septets are copied in bulk, other ones
+//				  are converted by the lookup tables.
 //***************************************************************************
-void i_GsmExt7BitChrToUtf8Chr(uint8_t cIn, uint8_t *utf8Char, int *utf8CharLen)
+static int i_GsmStrToUtf8Str(const uint8_t *pStrInGsm, int strInGsmLen, uint8_t *pStrOutUtf, int outSz)
 {
-int idx = 0;
+int	index = 0, cnvrtdStrIndex = 0, run;
+const GSM7_UTF8_DESC *chr;
 
-	switch(cIn)
-	{
-		// Characters not listed here are equal to those in the
-		// UTF8 charset OR not present in it.
+	for (outSz -= 1; index < strInGsmLen; )				/* Reserve a room for the NUL */
+		{
+		if ( __GSM7_IS_ASCII(pStrInGsm[index]) )
+			{
+			run = __PDU_KERN(__gsm7_ascii_run_kern)(&pStrInGsm[index], strInGsmLen - index);
+			run = (run > (outSz - cnvrtdStrIndex)) ? outSz - cnvrtdStrIndex : run;
 
-		// extension table
-		case 10:
-			utf8Char[idx++] = '\f';
-			break; // form feed, 0x0C
+			memcpy(&pStrOutUtf[cnvrtdStrIndex], &pStrInGsm[index], run);
+			cnvrtdStrIndex += run;
 
-		case 20:
-			utf8Char[idx++] = '^';
-			break;
+			if ( (index += run) >= strInGsmLen || cnvrtdStrIndex >= outSz )
+				break;
+			}
 
-		case 40:
-			utf8Char[idx++] = '{';
-			break;
+		if ( pStrInGsm[index] == ESC_CHR )
+			{
+			if ( ++index >= strInGsmLen )				/* Dangling ESC */
+				break;
 
-		case 41:
-			utf8Char[idx++] = '}';
-			break;
+			chr = &__gsm7_ext_utf8[pStrInGsm[index++] & 0x7F];
+			}
+		else	chr = &__gsm7_dflt_utf8[pStrInGsm[index++] & 0x7F];
 
-		case 47:
-			utf8Char[idx++] = '\\';
+		if ( (cnvrtdStrIndex + chr->len) > outSz )
 			break;
 
-		case 60:
-			utf8Char[idx++] = '[';
-			break;
+		if ( (outSz - cnvrtdStrIndex) >= (int) sizeof(chr->utf8) )
+			memcpy(&pStrOutUtf[cnvrtdStrIndex], chr->utf8, sizeof(chr->utf8));
+		else	memcpy(&pStrOutUtf[cnvrtdStrIndex], chr->utf8, chr->len);
 
-		case 61:
-			utf8Char[idx++] = '~';
-			break;
+		cnvrtdStrIndex += chr->len;
+		}
 
-		case 62:
-			utf8Char[idx++] = ']';
-			break;
+	pStrOutUtf[cnvrtdStrIndex] = '\0';
 
-		case 64:
-			utf8Char[idx++] = '|';
-			break;
+	return (cnvrtdStrIndex);
+}
 
-		case 101:
-			utf8Char[idx++] = 0xe2;
-			utf8Char[idx++] = 0x82;
-			utf8Char[idx++] = 0xAC;
-			break; // 164 in UTF8
+#define	GSM7_ESC		0x80				/* The septet is from the extension table */
+#define	GSM7_NONE		0xFF				/* No such character in GSM 7-bit alphabet */
 
-		default:
-			utf8Char[idx++] = cIn;
-			break;
-	}
+/* Level 1: page of 128 code points -> index of the page in the level 2 table, 0 - no GSM characters */
+static const uint8_t	__utf8_gsm7_l1[0x42] = {
+	[0x00] = 1,		/* U+0000 - U+007F */
+	[0x01] = 2,		/* U+0080 - U+00FF */
+	[0x07] = 3,		/* U+0380 - U+03FF */
+	[0x41] = 4,		/* U+2080 - U+20FF */
+};
 
-	*utf8CharLen = idx;
-}
+/* Level 2: septet | GSM7_ESC for the extension table, GSM7_NONE if the code point is not in GSM 7-bit */
+static const uint8_t	__utf8_gsm7_l2[5][128] = {
+	{							/* Unmapped page */
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+	},
+	{							/* U+0000 - U+007F */
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, 0x0A, GSM7_NONE, GSM7_ESC | 0x0A, 0x0D, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		0x20, 0x21, 0x22, 0x23, 0x02, 0x25, 0x26, 0x27,
+		0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F,
+		0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
+		0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0x3E, 0x3F,
+		0x00, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47,
+		0x48, 0x49, 0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F,
+		0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57,
+		0x58, 0x59, 0x5A, GSM7_ESC | 0x3C, GSM7_ESC | 0x2F, GSM7_ESC | 0x3E, GSM7_ESC | 0x14, 0x11,
+		GSM7_NONE, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67,
+		0x68, 0x69, 0x6A, 0x6B, 0x6C, 0x6D, 0x6E, 0x6F,
+		0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77,
+		0x78, 0x79, 0x7A, GSM7_ESC | 0x28, GSM7_ESC | 0x40, GSM7_ESC | 0x29, GSM7_ESC | 0x3D, GSM7_NONE,
+	},
+	{							/* U+0080 - U+00FF */
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, 0x40, GSM7_NONE, 0x01, 0x24, 0x03, GSM7_NONE, 0x5F,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, 0x60,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, 0x5B, 0x0E, 0x1C, 0x09,
+		GSM7_NONE, 0x1F, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, 0x5D, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, 0x5C, GSM7_NONE,
+		0x0B, GSM7_NONE, GSM7_NONE, GSM7_NONE, 0x5E, GSM7_NONE, GSM7_NONE, 0x1E,
+		0x7F, GSM7_NONE, GSM7_NONE, GSM7_NONE, 0x7B, 0x0F, 0x1D, GSM7_NONE,
+		0x04, 0x05, GSM7_NONE, GSM7_NONE, 0x07, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, 0x7D, 0x08, GSM7_NONE, GSM7_NONE, GSM7_NONE, 0x7C, GSM7_NONE,
+		0x0C, 0x06, GSM7_NONE, GSM7_NONE, 0x7E, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+	},
+	{							/* U+0380 - U+03FF */
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, 0x13, 0x10, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		0x19, GSM7_NONE, GSM7_NONE, 0x14, GSM7_NONE, GSM7_NONE, 0x1A, GSM7_NONE,
+		0x16, GSM7_NONE, GSM7_NONE, 0x18, GSM7_NONE, GSM7_NONE, 0x12, GSM7_NONE,
+		0x17, 0x15, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+	},
+	{							/* U+2080 - U+20FF */
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_ESC | 0x65, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+		GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE, GSM7_NONE,
+	},
+};
 
-//***************************************************************************
-// @NAME        : i_GsmStrToUtf8Str
-// @PARAM       : uint8_t *pStrInGsm - The pointer to string with Gsm character set.
-//				  uint8_t strInGsmLen - length of string with gsm character set..
-//				  uint8_t *pStrOutUtf - The pointer to buffer containing converted
-//									  UTF8 character set.
-// @RETURNS     : void
-// @DESCRIPTION : This function converts Gsm 7-bit characters to UTF8 characters.
-//***************************************************************************
-uint16_t i_GsmStrToUtf8Str(uint8_t *pStrInGsm, int strInGsmLen, uint8_t *pStrOutUtf)
+/*  DESCRIPTION: Decode one UTF-8 character, a malformed or truncated sequence is
+ *	consumed by one octet and returned as U+FFFD.
+ *
+ *   INPUTS:
+ *	pStr:	UTF-8 string
+ *	len:	number of octets available
+ *
+ *   OUTPUS:
+ *	pCp:	Unicode code point
+ *
+ *   RETURNS:
+ *	number of octets consumed
+ */
+static inline int __utf8_cp(const uint8_t *pStr, int len, uint32_t *pCp)
 {
-int index = 0, utf8CharLen = 0, cnvrtdStrIndex = 0;
+uint32_t	cp, c = pStr[0];
+
+	if ( c < 0x80 )
+		return	*pCp = c, 1;
 
-	for (index = 0; index < strInGsmLen; index++)
+	if ( (c >= 0xC2) && (c <= 0xDF) && (len >= 2) && ((pStr[1] & 0xC0) == 0x80) )
+		return	*pCp = ((c & 0x1F) << 6) | (pStr[1] & 0x3F), 2;
+
+	if ( (c >= 0xE0) && (c <= 0xEF) && (len >= 3) && ((pStr[1] & 0xC0) == 0x80) && ((pStr[2] & 0xC0) == 0x80) )
 		{
-		if (pStrInGsm[index] == ESC_CHR)
-			{
-			index++;
-			i_GsmExt7BitChrToUtf8Chr(pStrInGsm[index], &pStrOutUtf[cnvrtdStrIndex], &utf8CharLen);
-			}
-		else	i_Gsm7BitDfltChrToUtf8Chr(pStrInGsm[index], &pStrOutUtf[cnvrtdStrIndex], &utf8CharLen);
+		cp = ((c & 0x0F) << 12) | ((pStr[1] & 0x3F) << 6) | (pStr[2] & 0x3F);
+
+		if ( (cp >= 0x800) && ((cp < 0xD800) || (cp > 0xDFFF)) )
+			return	*pCp = cp, 3;
+		}
 
-		cnvrtdStrIndex += utf8CharLen;
+	if ( (c >= 0xF0) && (c <= 0xF4) && (len >= 4) && ((pStr[1] & 0xC0) == 0x80)
+		&& ((pStr[2] & 0xC0) == 0x80) && ((pStr[3] & 0xC0) == 0x80) )
+		{
+		cp = ((c & 0x07) << 18) | ((pStr[1] & 0x3F) << 12) | ((pStr[2] & 0x3F) << 6) | (pStr[3] & 0x3F);
 
+		if ( (cp >= 0x10000) && (cp <= 0x10FFFF) )
+			return	*pCp = cp, 4;
 		}
 
-	if (cnvrtdStrIndex > 550)
-		cnvrtdStrIndex = 550;
+	return	*pCp = 0xFFFD, 1;
+}
 
-	pStrOutUtf[cnvrtdStrIndex] = '\0';
+/*  DESCRIPTION: Look up a Unicode code point in the GSM 7-bit reverse index.
+ *
+ *   RETURNS:
+ *	septet, septet | GSM7_ESC or GSM7_NONE
+ */
+static inline uint8_t __gsm7_lookup(uint32_t cp)
+{
+	if ( cp >= (sizeof(__utf8_gsm7_l1) << 7) )
+		return	GSM7_NONE;
 
-	return (cnvrtdStrIndex);
+	return	__utf8_gsm7_l2[__utf8_gsm7_l1[cp >> 7]][cp & 0x7F];
 }
 
 //***************************************************************************
-// @NAME        : i_DecSemiOctet2Ascii
-// @PARAM       : decSemiOctetBuf - Pointer to decimal semi octet buffer.
-//				  asciiStrng - Pointer to ascii buffer.
-// @RETURNS     : void.
-// @DESCRIPTION : This function converts decimal semi octet in to ascii.
+// @NAME        : i_Utf8StrToGsmStr
+// @PARAM       : uint8_t *cIn - the pointer to buffer containing UTF8 characters.
+//				  int cInLen - length of data in cIn buffer.
+//				  uint8_t *gsmOut - The pointer to buffer which carries converetd
+//								  string in Gsm character set.
+//				  int gsmOutSz - size of the gsmOut buffer in septets
+//				  int *pUnmapped - number of characters are not in GSM 7-bit, may be NULL
+// @RETURNS     : Number of septets in the gsmOut
+// @DESCRIPTION : This function converts string in UTF8 character set to
+//				  Gsm cgaracter set. ASCII runs are passed through in bulk, other
+//				  characters are looked up in the reverse index, characters
+//				  which are not in GSM 7-bit are replaced with space. An escape
+//				  sequence is never split at the end of the output buffer.
 //***************************************************************************
-static uint8_t i_DecSemiOctet2Ascii(uint8_t *pDecSemiOctetBuf, uint8_t *pAsciiStrng)
+static int i_Utf8StrToGsmStr(const uint8_t *cIn, int cInLen, uint8_t *gsmOut, int gsmOutSz, int *pUnmapped)
 {
-int	idx, loopCnt, decSemiOctetLen;
-uint8_t asciiChar, asciiNextChar;
-
-
-	decSemiOctetLen = strlen ( (char *) pDecSemiOctetBuf);
-	loopCnt = decSemiOctetLen >> 1;
-
-	for (idx = 0; idx < loopCnt; idx++)
-	{
-		asciiChar = pDecSemiOctetBuf[idx*2];
-		asciiNextChar = pDecSemiOctetBuf[(idx*2) + 1];
+int	gsmIdx = 0, cInidx = 0, run, unmapped = 0;
+uint32_t	cp;
+uint8_t	gsm;
 
-		pAsciiStrng[idx*2] = asciiNextChar;
-		if (idx == (loopCnt - 1))
+	while ( (cInidx < cInLen) && (gsmIdx < gsmOutSz) )
 		{
-			if (asciiChar == 'F')
+		if ( __GSM7_IS_ASCII(cIn[cInidx]) )
 			{
-				pAsciiStrng[(idx*2) + 1] = '\0';
-				return (decSemiOctetLen - 1);
+			run = __PDU_KERN(__gsm7_ascii_run_kern)(&cIn[cInidx], cInLen - cInidx);
+			run = (run > (gsmOutSz - gsmIdx)) ? gsmOutSz - gsmIdx : run;
+
+			memcpy(&gsmOut[gsmIdx], &cIn[cInidx], run);
+			gsmIdx += run;
+			cInidx += run;
+			continue;
 			}
-			else
+
+		cInidx += __utf8_cp(&cIn[cInidx], cInLen - cInidx, &cp);
+
+		if ( GSM7_NONE == (gsm = __gsm7_lookup(cp)) )
+			gsm = ' ', unmapped++;
+
+		if ( gsm & GSM7_ESC )
 			{
-				pAsciiStrng[(idx*2) + 1] = asciiChar;
+			if ( (gsmIdx + 2) > gsmOutSz )
+				break;
+
+			gsmOut[gsmIdx++] = ESC_CHR;
 			}
+
+		gsmOut[gsmIdx++] = gsm & 0x7F;
 		}
-		else
-		{
-			pAsciiStrng[(idx*2) + 1] = asciiChar;
-		}
-	}
 
-	pAsciiStrng[idx*2] = '\0';
+	if ( pUnmapped )
+		*pUnmapped = unmapped;
 
-	return (decSemiOctetLen);
+	return	gsmIdx;
 }
 
+/* UTF-8 -> UCS-2 kernels: UTF-8 in, UTF-16BE code units out, characters beyond BMP give
+ * a surrogate pair, invalid sequences give U+FFFD; <outSz> is the room in octets, a surrogate
+ * pair is never split at the end of the output
+ */
+
+/*
+ *   DESCRIPTION: Convert one character.
+ *
+ *   INPUTS:
+ *	pIn:	UTF-8 octets
+ *	inLen:	number of octets
+ *	pIdx:	offset of the character, is advanced
+ *	pOut:	output position
+ *	room:	octets left in the output
+ *
+ *   RETURNS:
+ *	number of UCS-2 octets, 0 - no room
+ */
+static inline int	__utf8_ucs2_chr(const uint8_t *pIn, int inLen, int *pIdx, uint8_t *pOut, int room)
+{
+uint32_t	cp;
+int	n = __utf8_cp(&pIn[*pIdx], inLen - *pIdx, &cp);
 
-//***************************************************************************
-// @NAME        : i_Ascii2DecSemiOctet
-// @PARAM       : asciiStrng - Pointer to ascii buffer.
-//				  decSemiOctetBuf - Pointer to decimal semi octet buffer.
-// @RETURNS     : void.
-// @DESCRIPTION : This function converts ascii in to decimal semi octet.
-//***************************************************************************
-static uint8_t i_Ascii2DecSemiOctet(uint8_t *pAsciiStrng, uint8_t *pDecSemiOctetBuf)
+	if ( room < ((cp > 0xFFFF) ? 4 : 2) )
+		return	0;
+
+	*pIdx += n;
+
+	if ( cp <= 0xFFFF )
+		{
+		pOut[0] = cp >> 8;
+		pOut[1] = cp & 0xFF;
+		return	2;
+		}
+
+	cp -= 0x10000;
+	pOut[0] = 0xD8 | (cp >> 18);
+	pOut[1] = (cp >> 10) & 0xFF;
+	pOut[2] = 0xDC | ((cp >> 8) & 0x03);
+	pOut[3] = cp & 0xFF;
+	return	4;
+}
+
+static int	__utf8_ucs2_scalar(const uint8_t *pIn, int inLen, uint8_t *pOut, int outSz)
 {
-	uint8_t idx = 0;
-	uint8_t asciiChar = 0;
-	uint8_t asciiNextChar = 0;
-	uint8_t asciiLen= 0;
-	uint8_t loopCnt = 0;
-	uint8_t isToAddF = 0;
+int	idx = 0, o = 0, n;
 
-	asciiLen = strlen ( (char *) pAsciiStrng);
+	while ( (idx < inLen) && (n = __utf8_ucs2_chr(pIn, inLen, &idx, &pOut[o], outSz - o)) )
+		o += n;
 
-	if ((asciiLen % 2) != 0)
-	{
-		asciiLen++;
-		isToAddF = TRUE;
-	}
-	loopCnt = asciiLen >> 1;
+	return	o;
+}
 
-	for (idx = 0; idx < loopCnt; idx++)
-	{
-		asciiChar = pAsciiStrng[idx*2];
-		if (idx == (loopCnt - 1))
+#ifdef	PDU_X86_SIMD
+/* SSE2: blocks of 16 octets of ASCII or of 8 two-octet sequences (Cyrillic, Greek, ...)
+ * are converted at once, the ASCII prefix of other blocks is widened and the rest of
+ * the block is converted character by character
+ */
+static __attribute__((target("sse2"))) int __utf8_ucs2_sse2(const uint8_t *pIn, int inLen, uint8_t *pOut, int outSz)
+{
+int	idx = 0, o = 0, end, n;
+unsigned	mask;
+__m128i	v, u, zero = _mm_setzero_si128();
+
+	while ( (idx + 16 <= inLen) && (o + 32 <= outSz) )
 		{
-			if (isToAddF == TRUE)
+		v = _mm_loadu_si128((const __m128i *) &pIn[idx]);
+
+		/* Zero high octets first: big-endian units */
+		_mm_storeu_si128((__m128i *) &pOut[o], _mm_unpacklo_epi8(zero, v));
+		_mm_storeu_si128((__m128i *) &pOut[o + 16], _mm_unpackhi_epi8(zero, v));
+
+		if ( !(mask = _mm_movemask_epi8(v)) )
 			{
-				asciiNextChar = 'F';
+			idx += 16, o += 32;
+			continue;
 			}
-			else
+
+		/* Lead C2-DF at even, trail 80-BF at odd offsets: 5 + 6 bits of the unit */
+		if ( (0xFFFF == _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(v, _mm_set1_epi16((short) 0xC0E0)),
+			_mm_set1_epi16((short) 0x80C0))))
+			&& !_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(v, _mm_set1_epi16(0x1E)), zero)) )
 			{
-				asciiNextChar = pAsciiStrng[(idx*2) + 1];
+			u = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(v, _mm_set1_epi16(0x1F)), 6),
+				_mm_and_si128(_mm_srli_epi16(v, 8), _mm_set1_epi16(0x3F)));
+			_mm_storeu_si128((__m128i *) &pOut[o], _mm_or_si128(_mm_slli_epi16(u, 8), _mm_srli_epi16(u, 8)));
+			idx += 16, o += 16;
+			continue;
 			}
-		}
-		else
-		{
-			asciiNextChar = pAsciiStrng[(idx*2) + 1];
-		}
 
-		pDecSemiOctetBuf[idx*2] = asciiNextChar;
-		pDecSemiOctetBuf[(idx*2) + 1] = asciiChar;
-	}
-	pDecSemiOctetBuf[idx*2] = '\0';
+		n = __builtin_ctz(mask);					/* ASCII prefix has been stored */
+		end = idx + 16;
+		idx += n, o += n * 2;
 
-	return (asciiLen);
+		for ( ; idx < end; o += n)					/* A sequence may end past the block */
+			if ( !(n = __utf8_ucs2_chr(pIn, inLen, &idx, &pOut[o], outSz - o)) )
+				return	o;
+		}
+
+	return	o + __utf8_ucs2_scalar(&pIn[idx], inLen - idx, &pOut[o], outSz - o);
 }
 
+/* Compaction of 8 units to big-endian: units of the set bits are moved to the front */
+static const uint8_t	__utf8_ucs2_shuf[256][16] __attribute__((aligned(16))) = {
+	{ 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x00 */
+	{ 0x01, 0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x01 */
+	{ 0x03, 0x02, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x02 */
+	{ 0x01, 0x00, 0x03, 0x02, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x03 */
+	{ 0x05, 0x04, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x04 */
+	{ 0x01, 0x00, 0x05, 0x04, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x05 */
+	{ 0x03, 0x02, 0x05, 0x04, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x06 */
+	{ 0x01, 0x00, 0x03, 0x02, 0x05, 0x04, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x07 */
+	{ 0x07, 0x06, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x08 */
+	{ 0x01, 0x00, 0x07, 0x06, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x09 */
+	{ 0x03, 0x02, 0x07, 0x06, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x0A */
+	{ 0x01, 0x00, 0x03, 0x02, 0x07, 0x06, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x0B */
+	{ 0x05, 0x04, 0x07, 0x06, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x0C */
+	{ 0x01, 0x00, 0x05, 0x04, 0x07, 0x06, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x0D */
+	{ 0x03, 0x02, 0x05, 0x04, 0x07, 0x06, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x0E */
+	{ 0x01, 0x00, 0x03, 0x02, 0x05, 0x04, 0x07, 0x06, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x0F */
+	{ 0x09, 0x08, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x10 */
+	{ 0x01, 0x00, 0x09, 0x08, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x11 */
+	{ 0x03, 0x02, 0x09, 0x08, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x12 */
+	{ 0x01, 0x00, 0x03, 0x02, 0x09, 0x08, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x13 */
+	{ 0x05, 0x04, 0x09, 0x08, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x14 */
+	{ 0x01, 0x00, 0x05, 0x04, 0x09, 0x08, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x15 */
+	{ 0x03, 0x02, 0x05, 0x04, 0x09, 0x08, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x16 */
+	{ 0x01, 0x00, 0x03, 0x02, 0x05, 0x04, 0x09, 0x08, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x17 */
+	{ 0x07, 0x06, 0x09, 0x08, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x18 */
+	{ 0x01, 0x00, 0x07, 0x06, 0x09, 0x08, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x19 */
+	{ 0x03, 0x02, 0x07, 0x06, 0x09, 0x08, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x1A */
+	{ 0x01, 0x00, 0x03, 0x02, 0x07, 0x06, 0x09, 0x08, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x1B */
+	{ 0x05, 0x04, 0x07, 0x06, 0x09, 0x08, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x1C */
+	{ 0x01, 0x00, 0x05, 0x04, 0x07, 0x06, 0x09, 0x08, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x1D */
+	{ 0x03, 0x02, 0x05, 0x04, 0x07, 0x06, 0x09, 0x08, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x1E */
+	{ 0x01, 0x00, 0x03, 0x02, 0x05, 0x04, 0x07, 0x06, 0x09, 0x08, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x1F */
+	{ 0x0B, 0x0A, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x20 */
+	{ 0x01, 0x00, 0x0B, 0x0A, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x21 */
+	{ 0x03, 0x02, 0x0B, 0x0A, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x22 */
+	{ 0x01, 0x00, 0x03, 0x02, 0x0B, 0x0A, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x23 */
+	{ 0x05, 0x04, 0x0B, 0x0A, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x24 */
+	{ 0x01, 0x00, 0x05, 0x04, 0x0B, 0x0A, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x25 */
+	{ 0x03, 0x02, 0x05, 0x04, 0x0B, 0x0A, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x26 */
+	{ 0x01, 0x00, 0x03, 0x02, 0x05, 0x04, 0x0B, 0x0A, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x27 */
+	{ 0x07, 0x06, 0x0B, 0x0A, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x28 */
+	{ 0x01, 0x00, 0x07, 0x06, 0x0B, 0x0A, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x29 */
+	{ 0x03, 0x02, 0x07, 0x06, 0x0B, 0x0A, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x2A */
+	{ 0x01, 0x00, 0x03, 0x02, 0x07, 0x06, 0x0B, 0x0A, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x2B */
+	{ 0x05, 0x04, 0x07, 0x06, 0x0B, 0x0A, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x2C */
+	{ 0x01, 0x00, 0x05, 0x04, 0x07, 0x06, 0x0B, 0x0A, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x2D */
+	{ 0x03, 0x02, 0x05, 0x04, 0x07, 0x06, 0x0B, 0x0A, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x2E */
+	{ 0x01, 0x00, 0x03, 0x02, 0x05, 0x04, 0x07, 0x06, 0x0B, 0x0A, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x2F */
+	{ 0x09, 0x08, 0x0B, 0x0A, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x30 */
+	{ 0x01, 0x00, 0x09, 0x08, 0x0B, 0x0A, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x31 */
+	{ 0x03, 0x02, 0x09, 0x08, 0x0B, 0x0A, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x32 */
+	{ 0x01, 0x00, 0x03, 0x02, 0x09, 0x08, 0x0B, 0x0A, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x33 */
+	{ 0x05, 0x04, 0x09, 0x08, 0x0B, 0x0A, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x34 */
+	{ 0x01, 0x00, 0x05, 0x04, 0x09, 0x08, 0x0B, 0x0A, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x35 */
+	{ 0x03, 0x02, 0x05, 0x04, 0x09, 0x08, 0x0B, 0x0A, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x36 */
+	{ 0x01, 0x00, 0x03, 0x02, 0x05, 0x04, 0x09, 0x08, 0x0B, 0x0A, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x37 */
+	{ 0x07, 0x06, 0x09, 0x08, 0x0B, 0x0A, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x38 */
+	{ 0x01, 0x00, 0x07, 0x06, 0x09, 0x08, 0x0B, 0x0A, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x39 */
+	{ 0x03, 0x02, 0x07, 0x06, 0x09, 0x08, 0x0B, 0x0A, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x3A */
+	{ 0x01, 0x00, 0x03, 0x02, 0x07, 0x06, 0x09, 0x08, 0x0B, 0x0A, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x3B */
+	{ 0x05, 0x04, 0x07, 0x06, 0x09, 0x08, 0x0B, 0x0A, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x3C */
+	{ 0x01, 0x00, 0x05, 0x04, 0x07, 0x06, 0x09, 0x08, 0x0B, 0x0A, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x3D */
+	{ 0x03, 0x02, 0x05, 0x04, 0x07, 0x06, 0x09, 0x08, 0x0B, 0x0A, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x3E */
+	{ 0x01, 0x00, 0x03, 0x02, 0x05, 0x04, 0x07, 0x06, 0x09, 0x08, 0x0B, 0x0A, 0x80, 0x80, 0x80, 0x80 },	/* 0x3F */
+	{ 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x40 */
+	{ 0x01, 0x00, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x41 */
+	{ 0x03, 0x02, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x42 */
+	{ 0x01, 0x00, 0x03, 0x02, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x43 */
+	{ 0x05, 0x04, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x44 */
+	{ 0x01, 0x00, 0x05, 0x04, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x45 */
+	{ 0x03, 0x02, 0x05, 0x04, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x46 */
+	{ 0x01, 0x00, 0x03, 0x02, 0x05, 0x04, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x47 */
+	{ 0x07, 0x06, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x48 */
+	{ 0x01, 0x00, 0x07, 0x06, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x49 */
+	{ 0x03, 0x02, 0x07, 0x06, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x4A */
+	{ 0x01, 0x00, 0x03, 0x02, 0x07, 0x06, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x4B */
+	{ 0x05, 0x04, 0x07, 0x06, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x4C */
+	{ 0x01, 0x00, 0x05, 0x04, 0x07, 0x06, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x4D */
+	{ 0x03, 0x02, 0x05, 0x04, 0x07, 0x06, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x4E */
+	{ 0x01, 0x00, 0x03, 0x02, 0x05, 0x04, 0x07, 0x06, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x4F */
+	{ 0x09, 0x08, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x50 */
+	{ 0x01, 0x00, 0x09, 0x08, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x51 */
+	{ 0x03, 0x02, 0x09, 0x08, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x52 */
+	{ 0x01, 0x00, 0x03, 0x02, 0x09, 0x08, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x53 */
+	{ 0x05, 0x04, 0x09, 0x08, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x54 */
+	{ 0x01, 0x00, 0x05, 0x04, 0x09, 0x08, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x55 */
+	{ 0x03, 0x02, 0x05, 0x04, 0x09, 0x08, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x56 */
+	{ 0x01, 0x00, 0x03, 0x02, 0x05, 0x04, 0x09, 0x08, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x57 */
+	{ 0x07, 0x06, 0x09, 0x08, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x58 */
+	{ 0x01, 0x00, 0x07, 0x06, 0x09, 0x08, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x59 */
+	{ 0x03, 0x02, 0x07, 0x06, 0x09, 0x08, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x5A */
+	{ 0x01, 0x00, 0x03, 0x02, 0x07, 0x06, 0x09, 0x08, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x5B */
+	{ 0x05, 0x04, 0x07, 0x06, 0x09, 0x08, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x5C */
+	{ 0x01, 0x00, 0x05, 0x04, 0x07, 0x06, 0x09, 0x08, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x5D */
+	{ 0x03, 0x02, 0x05, 0x04, 0x07, 0x06, 0x09, 0x08, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x5E */
+	{ 0x01, 0x00, 0x03, 0x02, 0x05, 0x04, 0x07, 0x06, 0x09, 0x08, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80 },	/* 0x5F */
+	{ 0x0B, 0x0A, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x60 */
+	{ 0x01, 0x00, 0x0B, 0x0A, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x61 */
+	{ 0x03, 0x02, 0x0B, 0x0A, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x62 */
+	{ 0x01, 0x00, 0x03, 0x02, 0x0B, 0x0A, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x63 */
+	{ 0x05, 0x04, 0x0B, 0x0A, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x64 */
+	{ 0x01, 0x00, 0x05, 0x04, 0x0B, 0x0A, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x65 */
+	{ 0x03, 0x02, 0x05, 0x04, 0x0B, 0x0A, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x66 */
+	{ 0x01, 0x00, 0x03, 0x02, 0x05, 0x04, 0x0B, 0x0A, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x67 */
+	{ 0x07, 0x06, 0x0B, 0x0A, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x68 */
+	{ 0x01, 0x00, 0x07, 0x06, 0x0B, 0x0A, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x69 */
+	{ 0x03, 0x02, 0x07, 0x06, 0x0B, 0x0A, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x6A */
+	{ 0x01, 0x00, 0x03, 0x02, 0x07, 0x06, 0x0B, 0x0A, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x6B */
+	{ 0x05, 0x04, 0x07, 0x06, 0x0B, 0x0A, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x6C */
+	{ 0x01, 0x00, 0x05, 0x04, 0x07, 0x06, 0x0B, 0x0A, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x6D */
+	{ 0x03, 0x02, 0x05, 0x04, 0x07, 0x06, 0x0B, 0x0A, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x6E */
+	{ 0x01, 0x00, 0x03, 0x02, 0x05, 0x04, 0x07, 0x06, 0x0B, 0x0A, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80 },	/* 0x6F */
+	{ 0x09, 0x08, 0x0B, 0x0A, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x70 */
+	{ 0x01, 0x00, 0x09, 0x08, 0x0B, 0x0A, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x71 */
+	{ 0x03, 0x02, 0x09, 0x08, 0x0B, 0x0A, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x72 */
+	{ 0x01, 0x00, 0x03, 0x02, 0x09, 0x08, 0x0B, 0x0A, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x73 */
+	{ 0x05, 0x04, 0x09, 0x08, 0x0B, 0x0A, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x74 */
+	{ 0x01, 0x00, 0x05, 0x04, 0x09, 0x08, 0x0B, 0x0A, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x75 */
+	{ 0x03, 0x02, 0x05, 0x04, 0x09, 0x08, 0x0B, 0x0A, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x76 */
+	{ 0x01, 0x00, 0x03, 0x02, 0x05, 0x04, 0x09, 0x08, 0x0B, 0x0A, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80 },	/* 0x77 */
+	{ 0x07, 0x06, 0x09, 0x08, 0x0B, 0x0A, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x78 */
+	{ 0x01, 0x00, 0x07, 0x06, 0x09, 0x08, 0x0B, 0x0A, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x79 */
+	{ 0x03, 0x02, 0x07, 0x06, 0x09, 0x08, 0x0B, 0x0A, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x7A */
+	{ 0x01, 0x00, 0x03, 0x02, 0x07, 0x06, 0x09, 0x08, 0x0B, 0x0A, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80 },	/* 0x7B */
+	{ 0x05, 0x04, 0x07, 0x06, 0x09, 0x08, 0x0B, 0x0A, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x7C */
+	{ 0x01, 0x00, 0x05, 0x04, 0x07, 0x06, 0x09, 0x08, 0x0B, 0x0A, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80 },	/* 0x7D */
+	{ 0x03, 0x02, 0x05, 0x04, 0x07, 0x06, 0x09, 0x08, 0x0B, 0x0A, 0x0D, 0x0C, 0x80, 0x80, 0x80, 0x80 },	/* 0x7E */
+	{ 0x01, 0x00, 0x03, 0x02, 0x05, 0x04, 0x07, 0x06, 0x09, 0x08, 0x0B, 0x0A, 0x0D, 0x0C, 0x80, 0x80 },	/* 0x7F */
+	{ 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x80 */
+	{ 0x01, 0x00, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x81 */
+	{ 0x03, 0x02, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x82 */
+	{ 0x01, 0x00, 0x03, 0x02, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x83 */
+	{ 0x05, 0x04, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x84 */
+	{ 0x01, 0x00, 0x05, 0x04, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x85 */
+	{ 0x03, 0x02, 0x05, 0x04, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x86 */
+	{ 0x01, 0x00, 0x03, 0x02, 0x05, 0x04, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x87 */
+	{ 0x07, 0x06, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x88 */
+	{ 0x01, 0x00, 0x07, 0x06, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x89 */
+	{ 0x03, 0x02, 0x07, 0x06, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x8A */
+	{ 0x01, 0x00, 0x03, 0x02, 0x07, 0x06, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x8B */
+	{ 0x05, 0x04, 0x07, 0x06, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x8C */
+	{ 0x01, 0x00, 0x05, 0x04, 0x07, 0x06, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x8D */
+	{ 0x03, 0x02, 0x05, 0x04, 0x07, 0x06, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x8E */
+	{ 0x01, 0x00, 0x03, 0x02, 0x05, 0x04, 0x07, 0x06, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x8F */
+	{ 0x09, 0x08, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x90 */
+	{ 0x01, 0x00, 0x09, 0x08, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x91 */
+	{ 0x03, 0x02, 0x09, 0x08, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x92 */
+	{ 0x01, 0x00, 0x03, 0x02, 0x09, 0x08, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x93 */
+	{ 0x05, 0x04, 0x09, 0x08, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x94 */
+	{ 0x01, 0x00, 0x05, 0x04, 0x09, 0x08, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x95 */
+	{ 0x03, 0x02, 0x05, 0x04, 0x09, 0x08, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x96 */
+	{ 0x01, 0x00, 0x03, 0x02, 0x05, 0x04, 0x09, 0x08, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x97 */
+	{ 0x07, 0x06, 0x09, 0x08, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x98 */
+	{ 0x01, 0x00, 0x07, 0x06, 0x09, 0x08, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x99 */
+	{ 0x03, 0x02, 0x07, 0x06, 0x09, 0x08, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x9A */
+	{ 0x01, 0x00, 0x03, 0x02, 0x07, 0x06, 0x09, 0x08, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x9B */
+	{ 0x05, 0x04, 0x07, 0x06, 0x09, 0x08, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x9C */
+	{ 0x01, 0x00, 0x05, 0x04, 0x07, 0x06, 0x09, 0x08, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x9D */
+	{ 0x03, 0x02, 0x05, 0x04, 0x07, 0x06, 0x09, 0x08, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x9E */
+	{ 0x01, 0x00, 0x03, 0x02, 0x05, 0x04, 0x07, 0x06, 0x09, 0x08, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0x9F */
+	{ 0x0B, 0x0A, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xA0 */
+	{ 0x01, 0x00, 0x0B, 0x0A, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xA1 */
+	{ 0x03, 0x02, 0x0B, 0x0A, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xA2 */
+	{ 0x01, 0x00, 0x03, 0x02, 0x0B, 0x0A, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xA3 */
+	{ 0x05, 0x04, 0x0B, 0x0A, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xA4 */
+	{ 0x01, 0x00, 0x05, 0x04, 0x0B, 0x0A, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xA5 */
+	{ 0x03, 0x02, 0x05, 0x04, 0x0B, 0x0A, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xA6 */
+	{ 0x01, 0x00, 0x03, 0x02, 0x05, 0x04, 0x0B, 0x0A, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xA7 */
+	{ 0x07, 0x06, 0x0B, 0x0A, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xA8 */
+	{ 0x01, 0x00, 0x07, 0x06, 0x0B, 0x0A, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xA9 */
+	{ 0x03, 0x02, 0x07, 0x06, 0x0B, 0x0A, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xAA */
+	{ 0x01, 0x00, 0x03, 0x02, 0x07, 0x06, 0x0B, 0x0A, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xAB */
+	{ 0x05, 0x04, 0x07, 0x06, 0x0B, 0x0A, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xAC */
+	{ 0x01, 0x00, 0x05, 0x04, 0x07, 0x06, 0x0B, 0x0A, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xAD */
+	{ 0x03, 0x02, 0x05, 0x04, 0x07, 0x06, 0x0B, 0x0A, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xAE */
+	{ 0x01, 0x00, 0x03, 0x02, 0x05, 0x04, 0x07, 0x06, 0x0B, 0x0A, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xAF */
+	{ 0x09, 0x08, 0x0B, 0x0A, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xB0 */
+	{ 0x01, 0x00, 0x09, 0x08, 0x0B, 0x0A, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xB1 */
+	{ 0x03, 0x02, 0x09, 0x08, 0x0B, 0x0A, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xB2 */
+	{ 0x01, 0x00, 0x03, 0x02, 0x09, 0x08, 0x0B, 0x0A, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xB3 */
+	{ 0x05, 0x04, 0x09, 0x08, 0x0B, 0x0A, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xB4 */
+	{ 0x01, 0x00, 0x05, 0x04, 0x09, 0x08, 0x0B, 0x0A, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xB5 */
+	{ 0x03, 0x02, 0x05, 0x04, 0x09, 0x08, 0x0B, 0x0A, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xB6 */
+	{ 0x01, 0x00, 0x03, 0x02, 0x05, 0x04, 0x09, 0x08, 0x0B, 0x0A, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xB7 */
+	{ 0x07, 0x06, 0x09, 0x08, 0x0B, 0x0A, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xB8 */
+	{ 0x01, 0x00, 0x07, 0x06, 0x09, 0x08, 0x0B, 0x0A, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xB9 */
+	{ 0x03, 0x02, 0x07, 0x06, 0x09, 0x08, 0x0B, 0x0A, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xBA */
+	{ 0x01, 0x00, 0x03, 0x02, 0x07, 0x06, 0x09, 0x08, 0x0B, 0x0A, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xBB */
+	{ 0x05, 0x04, 0x07, 0x06, 0x09, 0x08, 0x0B, 0x0A, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xBC */
+	{ 0x01, 0x00, 0x05, 0x04, 0x07, 0x06, 0x09, 0x08, 0x0B, 0x0A, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xBD */
+	{ 0x03, 0x02, 0x05, 0x04, 0x07, 0x06, 0x09, 0x08, 0x0B, 0x0A, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xBE */
+	{ 0x01, 0x00, 0x03, 0x02, 0x05, 0x04, 0x07, 0x06, 0x09, 0x08, 0x0B, 0x0A, 0x0F, 0x0E, 0x80, 0x80 },	/* 0xBF */
+	{ 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xC0 */
+	{ 0x01, 0x00, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xC1 */
+	{ 0x03, 0x02, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xC2 */
+	{ 0x01, 0x00, 0x03, 0x02, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xC3 */
+	{ 0x05, 0x04, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xC4 */
+	{ 0x01, 0x00, 0x05, 0x04, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xC5 */
+	{ 0x03, 0x02, 0x05, 0x04, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xC6 */
+	{ 0x01, 0x00, 0x03, 0x02, 0x05, 0x04, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xC7 */
+	{ 0x07, 0x06, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xC8 */
+	{ 0x01, 0x00, 0x07, 0x06, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xC9 */
+	{ 0x03, 0x02, 0x07, 0x06, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xCA */
+	{ 0x01, 0x00, 0x03, 0x02, 0x07, 0x06, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xCB */
+	{ 0x05, 0x04, 0x07, 0x06, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xCC */
+	{ 0x01, 0x00, 0x05, 0x04, 0x07, 0x06, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xCD */
+	{ 0x03, 0x02, 0x05, 0x04, 0x07, 0x06, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xCE */
+	{ 0x01, 0x00, 0x03, 0x02, 0x05, 0x04, 0x07, 0x06, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xCF */
+	{ 0x09, 0x08, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xD0 */
+	{ 0x01, 0x00, 0x09, 0x08, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xD1 */
+	{ 0x03, 0x02, 0x09, 0x08, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xD2 */
+	{ 0x01, 0x00, 0x03, 0x02, 0x09, 0x08, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xD3 */
+	{ 0x05, 0x04, 0x09, 0x08, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xD4 */
+	{ 0x01, 0x00, 0x05, 0x04, 0x09, 0x08, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xD5 */
+	{ 0x03, 0x02, 0x05, 0x04, 0x09, 0x08, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xD6 */
+	{ 0x01, 0x00, 0x03, 0x02, 0x05, 0x04, 0x09, 0x08, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xD7 */
+	{ 0x07, 0x06, 0x09, 0x08, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xD8 */
+	{ 0x01, 0x00, 0x07, 0x06, 0x09, 0x08, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xD9 */
+	{ 0x03, 0x02, 0x07, 0x06, 0x09, 0x08, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xDA */
+	{ 0x01, 0x00, 0x03, 0x02, 0x07, 0x06, 0x09, 0x08, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xDB */
+	{ 0x05, 0x04, 0x07, 0x06, 0x09, 0x08, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xDC */
+	{ 0x01, 0x00, 0x05, 0x04, 0x07, 0x06, 0x09, 0x08, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xDD */
+	{ 0x03, 0x02, 0x05, 0x04, 0x07, 0x06, 0x09, 0x08, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xDE */
+	{ 0x01, 0x00, 0x03, 0x02, 0x05, 0x04, 0x07, 0x06, 0x09, 0x08, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80 },	/* 0xDF */
+	{ 0x0B, 0x0A, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xE0 */
+	{ 0x01, 0x00, 0x0B, 0x0A, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xE1 */
+	{ 0x03, 0x02, 0x0B, 0x0A, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xE2 */
+	{ 0x01, 0x00, 0x03, 0x02, 0x0B, 0x0A, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xE3 */
+	{ 0x05, 0x04, 0x0B, 0x0A, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xE4 */
+	{ 0x01, 0x00, 0x05, 0x04, 0x0B, 0x0A, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xE5 */
+	{ 0x03, 0x02, 0x05, 0x04, 0x0B, 0x0A, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xE6 */
+	{ 0x01, 0x00, 0x03, 0x02, 0x05, 0x04, 0x0B, 0x0A, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xE7 */
+	{ 0x07, 0x06, 0x0B, 0x0A, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xE8 */
+	{ 0x01, 0x00, 0x07, 0x06, 0x0B, 0x0A, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xE9 */
+	{ 0x03, 0x02, 0x07, 0x06, 0x0B, 0x0A, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xEA */
+	{ 0x01, 0x00, 0x03, 0x02, 0x07, 0x06, 0x0B, 0x0A, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xEB */
+	{ 0x05, 0x04, 0x07, 0x06, 0x0B, 0x0A, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xEC */
+	{ 0x01, 0x00, 0x05, 0x04, 0x07, 0x06, 0x0B, 0x0A, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xED */
+	{ 0x03, 0x02, 0x05, 0x04, 0x07, 0x06, 0x0B, 0x0A, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xEE */
+	{ 0x01, 0x00, 0x03, 0x02, 0x05, 0x04, 0x07, 0x06, 0x0B, 0x0A, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80 },	/* 0xEF */
+	{ 0x09, 0x08, 0x0B, 0x0A, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xF0 */
+	{ 0x01, 0x00, 0x09, 0x08, 0x0B, 0x0A, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xF1 */
+	{ 0x03, 0x02, 0x09, 0x08, 0x0B, 0x0A, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xF2 */
+	{ 0x01, 0x00, 0x03, 0x02, 0x09, 0x08, 0x0B, 0x0A, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xF3 */
+	{ 0x05, 0x04, 0x09, 0x08, 0x0B, 0x0A, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xF4 */
+	{ 0x01, 0x00, 0x05, 0x04, 0x09, 0x08, 0x0B, 0x0A, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xF5 */
+	{ 0x03, 0x02, 0x05, 0x04, 0x09, 0x08, 0x0B, 0x0A, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xF6 */
+	{ 0x01, 0x00, 0x03, 0x02, 0x05, 0x04, 0x09, 0x08, 0x0B, 0x0A, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80 },	/* 0xF7 */
+	{ 0x07, 0x06, 0x09, 0x08, 0x0B, 0x0A, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xF8 */
+	{ 0x01, 0x00, 0x07, 0x06, 0x09, 0x08, 0x0B, 0x0A, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xF9 */
+	{ 0x03, 0x02, 0x07, 0x06, 0x09, 0x08, 0x0B, 0x0A, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xFA */
+	{ 0x01, 0x00, 0x03, 0x02, 0x07, 0x06, 0x09, 0x08, 0x0B, 0x0A, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80 },	/* 0xFB */
+	{ 0x05, 0x04, 0x07, 0x06, 0x09, 0x08, 0x0B, 0x0A, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xFC */
+	{ 0x01, 0x00, 0x05, 0x04, 0x07, 0x06, 0x09, 0x08, 0x0B, 0x0A, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80 },	/* 0xFD */
+	{ 0x03, 0x02, 0x05, 0x04, 0x07, 0x06, 0x09, 0x08, 0x0B, 0x0A, 0x0D, 0x0C, 0x0F, 0x0E, 0x80, 0x80 },	/* 0xFE */
+	{ 0x01, 0x00, 0x03, 0x02, 0x05, 0x04, 0x07, 0x06, 0x09, 0x08, 0x0B, 0x0A, 0x0D, 0x0C, 0x0F, 0x0E },	/* 0xFF */
+};
 
-//***************************************************************************
-// @NAME        : i_TextToPdu
-// @PARAM       : asciiBuf- Pointer to ascii buffer containing text data.
-//				  pduBuf - Pointer to pdu buffer(for converted pdu data).
-// @RETURNS     : uint8_t,pdu data length.
-// @DESCRIPTION : This function converts Text data(7bit) to pdu data(8bit).
-//***************************************************************************
-static uint8_t i_Text2Pdu(uint8_t *pAsciiBuf, uint8_t asciiLen, uint8_t *pPduBuf)
+/*
+ *   DESCRIPTION: Convert 16 octets of ASCII & 2-octet sequences mixed: a unit is made
+ *	at every offset assuming a sequence starts there, units at trail octets are
+ *	dropped by PSHUFB. A lead octet at the end of the block is left for the next one.
+ *
+ *   INPUTS:
+ *	pIn:	UTF-8 octets, 17 octets are read
+ *	pOut:	output position, room for 32 octets
+ *
+ *   OUTPUS:
+ *	pLen:	number of UCS-2 octets
+ *
+ *   RETURNS:
+ *	number of UTF-8 octets consumed, 0 - the block is not of ASCII & 2-octet sequences
+ */
+static inline __attribute__((target("avx2"))) int __utf8_ucs2_mix16(const uint8_t *pIn, uint8_t *pOut, int *pLen)
 {
-int	idx = 0, index = 0, pduIndex = 0;
-uint8_t procChar = 0;
-uint8_t procNextChar = 0;
-uint8_t procVariable = 0;
-uint8_t tempVariable;
-uint8_t asciiChar = 0;
+__m128i	v = _mm_loadu_si128((const __m128i *) pIn), next = _mm_loadu_si128((const __m128i *) &pIn[1]), lane, u, lead;
+unsigned	trail, leads, keep;
+int	n = 16, i, len = 0;
 
-	for (idx = 0; idx < asciiLen; idx++)
-		{
-		asciiChar = pAsciiBuf[idx];
-		procChar = asciiChar >> index;
+	if ( _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(_mm_and_si128(v, _mm_set1_epi8((char) 0xE0)), _mm_set1_epi8((char) 0xE0)),
+		_mm_cmpeq_epi8(_mm_and_si128(v, _mm_set1_epi8((char) 0xFE)), _mm_set1_epi8((char) 0xC0)))) )
+		return	0;							/* 3/4-octet leads, C0/C1 */
 
-		if (index != 7)
-			{
-			procNextChar = pAsciiBuf[idx + 1];
-			tempVariable = procNextChar;
-			procVariable = 0xFF << (index + 1);
-			tempVariable = tempVariable & (~procVariable);
-			tempVariable = tempVariable << (7 - index);
+	trail = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(v, _mm_set1_epi8((char) 0xC0)), _mm_set1_epi8((char) 0x80)));
+	leads = _mm_movemask_epi8(v) & ~trail;
 
-			pPduBuf[pduIndex++] = procChar | tempVariable;
-			}
+	if ( leads & 0x8000 )
+		n = 15, leads &= 0x7FFF;
 
-		index++;
-			if (index > 7)	index = 0;
+	if ( trail != ((leads << 1) & 0xFFFF) )					/* Every lead is followed by a trail */
+		return	0;
+
+	keep = ~trail & ((1u << n) - 1);
+
+	for (i = 0; i < 2; i++)
+		{
+		lane = i ? _mm_unpackhi_epi8(v, next) : _mm_unpacklo_epi8(v, next);	/* Octet and the next one */
+		lead = _mm_cmpeq_epi16(_mm_and_si128(lane, _mm_set1_epi16(0xE0)), _mm_set1_epi16(0xC0));
+		u = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(lane, _mm_set1_epi16(0x1F)), 6),
+			_mm_and_si128(_mm_srli_epi16(lane, 8), _mm_set1_epi16(0x3F)));
+		u = _mm_blendv_epi8(_mm_and_si128(lane, _mm_set1_epi16(0xFF)), u, lead);
+
+		u = _mm_shuffle_epi8(u, _mm_load_si128((const __m128i *) __utf8_ucs2_shuf[(keep >> (i * 8)) & 0xFF]));
+		_mm_storeu_si128((__m128i *) &pOut[len], u);
+		len += 2 * __builtin_popcount((keep >> (i * 8)) & 0xFF);
 		}
 
-	return (pduIndex);
+	*pLen = len;
+
+	return	n;
 }
 
-//***************************************************************************
-// @NAME        : i_PduToText
-// @PARAM       : pduBuf - Pointer to pdu buffer(for converted pdu data).
-//				: pduLen - length of pdu data.
-//				  asciiBuf- Pointer to ascii buffer containing text data.
-// @RETURNS     : uint8_t,pdu data length.
-// @DESCRIPTION : This function converts pdu data(8bit) to text data(7bit).
-//***************************************************************************
-static int i_Pdu2Text(uint8_t *pPduBuf, uint8_t pduLen, uint8_t *pAsciiBuf)
+/* AVX2: as SSE2 with blocks of 32 octets, ASCII mixed with 2-octet sequences is
+ * converted 16 octets at once
+ */
+static __attribute__((target("avx2"))) int __utf8_ucs2_avx2(const uint8_t *pIn, int inLen, uint8_t *pOut, int outSz)
 {
-int	idx = 0, index = 0;
-uint8_t asciiIndex = 0;
-uint8_t procByte = 0;
-uint8_t procPrevByte = 0;
-uint8_t procVariable = 0;
-uint8_t tempVariable = 0;
-uint8_t pduByte = 0;
+int	idx = 0, o = 0, end, n, len;
+unsigned	mask;
+__m256i	v, u, lo, hi, zero = _mm256_setzero_si256();
 
-
-	for (idx = 0; idx < pduLen; idx++)
+	while ( (idx + 32 <= inLen) && (o + 64 <= outSz) )
 		{
-		pduByte = pPduBuf[idx];
-		procByte = pduByte & (0xFF >> (index + 1));
-		procByte = procByte << index;
+		v = _mm256_loadu_si256((const __m256i *) &pIn[idx]);
+
+		lo = _mm256_unpacklo_epi8(zero, v);				/* Octets 0-7, 16-23 */
+		hi = _mm256_unpackhi_epi8(zero, v);				/* Octets 8-15, 24-31 */
+		_mm256_storeu_si256((__m256i *) &pOut[o], _mm256_permute2x128_si256(lo, hi, 0x20));
+		_mm256_storeu_si256((__m256i *) &pOut[o + 32], _mm256_permute2x128_si256(lo, hi, 0x31));
 
-		if (idx > 0)
+		if ( !(mask = _mm256_movemask_epi8(v)) )
 			{
-			procPrevByte = pPduBuf[idx - 1];
-			tempVariable = procPrevByte;
-			procVariable = 0xFF >> index;
-			tempVariable = tempVariable & (~procVariable);
-			tempVariable = tempVariable >> (7 - (index - 1));
+			idx += 32, o += 64;
+			continue;
 			}
-		else	tempVariable = 0;
 
-		pAsciiBuf[asciiIndex++] = procByte | tempVariable;
+		if ( (0xFFFFFFFF == (unsigned) _mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_and_si256(v,
+			_mm256_set1_epi16((short) 0xC0E0)), _mm256_set1_epi16((short) 0x80C0))))
+			&& !_mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_and_si256(v, _mm256_set1_epi16(0x1E)), zero)) )
+			{
+			u = _mm256_or_si256(_mm256_slli_epi16(_mm256_and_si256(v, _mm256_set1_epi16(0x1F)), 6),
+				_mm256_and_si256(_mm256_srli_epi16(v, 8), _mm256_set1_epi16(0x3F)));
+			_mm256_storeu_si256((__m256i *) &pOut[o], _mm256_or_si256(_mm256_slli_epi16(u, 8), _mm256_srli_epi16(u, 8)));
+			idx += 32, o += 32;
+			continue;
+			}
 
-		if (index == 6)
+		if ( (n = __utf8_ucs2_mix16(&pIn[idx], &pOut[o], &len)) )
 			{
-			if (idx == (pduLen - 1))
-				{
-				if ((pduByte >> 1) != 0)
-					pAsciiBuf[asciiIndex++] = pduByte >> 1;
-				}
-			else	pAsciiBuf[asciiIndex++] = pduByte >> 1;
+			idx += n, o += len;
+			continue;
 			}
 
-		index++;
-		if (index  > 6)
-			index = 0;
+		n = __builtin_ctz(mask);
+		end = idx + 32;
+		idx += n, o += n * 2;
+
+		for ( ; idx < end; o += n)
+			if ( !(n = __utf8_ucs2_chr(pIn, inLen, &idx, &pOut[o], outSz - o)) )
+				return	o;
 		}
 
-	pAsciiBuf[asciiIndex] = '\0';
+	_mm256_zeroupper();							/* No AVX-SSE transition penalty in the tail */
 
-	return (asciiIndex);
+	return	o + __utf8_ucs2_sse2(&pIn[idx], inLen - idx, &pOut[o], outSz - o);
 }
+#endif	/* PDU_X86_SIMD */
 
 //***************************************************************************
-// @NAME        : DecodePduData
-// @PARAM       : pGsmPduStr-Reference To PDU String,
-//				  gsmPduStrLen-Length of PDU String,
-//				  PDU_DECODE_DESC-Object Pointer
-// @RETURNS     : TRUE/FALSE
-// @DESCRIPTION : This function extracts Pdu String data & fills relevant parameters in Descriptor
-//				  if fails then return FALSE.
+// @NAME        : i_Utf8StrToUcs2Str
+// @PARAM       : uint8_t *cIn - the pointer to buffer containing UTF8 characters.
+//				  int cInLen - length of data in cIn buffer.
+//				  uint8_t *ucsOut - The pointer to buffer which carries converted
+//								  string in UCS-2 (big-endian) character set.
+//				  int ucsOutSz - size of the ucsOut buffer in octets
+// @RETURNS     : Number of octets in the ucsOut
+// @DESCRIPTION : This function converts string in UTF8 character set to
+//				  UCS-2 as it's carried by the TP-UD. Characters beyond BMP are
+//				  encoded as surrogate pairs (UTF-16), a surrogate pair is never
+//				  split at the end of the output buffer. ASCII and 2-octet runs
+//				  are converted in bulk by the kernel selected for the CPU.
 //***************************************************************************
-int	DecodePduData(unsigned char *pdu, PDU_DESC *pdsc, int *pError)
+static int i_Utf8StrToUcs2Str(const uint8_t *cIn, int cInLen, uint8_t *ucsOut, int ucsOutSz)
 {
- int	idx = 0, length = 0, addrLen = 0, asciiLen = 0;
- uint8_t npi = 0;
- uint8_t udl = 0;
- unsigned char  obuf[SMS_PDU_MAX_LEN];
- uint8_t oct = 0;
- uint8_t grpId = 0;
+	return	__PDU_KERN(__utf8_ucs2_kern)(cIn, cInLen, ucsOut, ucsOutSz);
+}
 
-	memset(pdsc, 0, sizeof(PDU_DESC));					/* Zeroing output structure */
+/* UCS-2 -> UTF-8 kernels: UTF-16BE code units in, UTF-8 out, a surrogate pair gives one 4-octet
+ * character, a lone surrogate is replaced with U+FFFD; <outSz> is the room w/o NUL, a character
+ * is never split at the end of the output
+ */
+#define	__UCS2_UNIT(p)		( ((p)[0] << 8) | (p)[1] )
+#define	__UCS2_IS_HIGH(u)	( ((u) & 0xFC00) == 0xD800 )
+#define	__UCS2_IS_LOW(u)	( ((u) & 0xFC00) == 0xDC00 )
 
-	__hex2bin(pdu, obuf);						/* Converting whole Ascii String to Hex String */
+/*
+ *   DESCRIPTION: Convert one character: a code unit or a surrogate pair.
+ *
+ *   INPUTS:
+ *	pIn:	UCS-2 octets
+ *	inLen:	number of octets, even
+ *	pIdx:	offset of the character, is advanced
+ *	pOut:	output position
+ *	room:	octets left in the output
+ *
+ *   RETURNS:
+ *	number of UTF-8 octets, 0 - no room, the offset is not advanced
+ */
+static inline int	__ucs2_utf8_chr(const uint8_t *pIn, int inLen, int *pIdx, uint8_t *pOut, int room)
+{
+uint32_t	cp = __UCS2_UNIT(&pIn[*pIdx]), lo;
 
-	pdsc->smscAddrLen = obuf[idx++];					/* Service center Number Length */
+	if ( cp < 0x80 )
+		{
+		if ( room < 1 )
+			return	0;
 
-	pdsc->smscTypeOfAddr = obuf[idx++];					/* Service Center Type of Address (Eg: 91 , 81) */
+		pOut[0] = (uint8_t) cp;
+		return	*pIdx += 2, 1;
+		}
 
-	npi = pdsc->smscTypeOfAddr & 0x0F;					/* Numbering Plan Identification */
+	if ( cp < 0x800 )
+		{
+		if ( room < 2 )
+			return	0;
 
-	pdsc->smscTypeOfAddr = (pdsc->smscTypeOfAddr & 0x70) >> 4;		/* Type of Number */
+		pOut[0] = 0xC0 | (cp >> 6);
+		pOut[1] = 0x80 | (cp & 0x3F);
+		return	*pIdx += 2, 2;
+		}
 
-										/* Service Center Number */
-	addrLen = pdsc->smscAddrLen - 1;					/* Subtracting Type of Addr octet length */
-	__bin2hex(&obuf[idx], addrLen, pdsc->smscAddr);
-	pdsc->smscAddrLen = i_DecSemiOctet2Ascii(pdsc->smscAddr, pdsc->smscAddr);/* Internal Swapping */
-	idx += addrLen;
+	if ( __UCS2_IS_HIGH(cp) && (*pIdx + 4 <= inLen) && __UCS2_IS_LOW(lo = __UCS2_UNIT(&pIn[*pIdx + 2])) )
+		{
+		if ( room < 4 )
+			return	0;
+
+		cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+		pOut[0] = 0xF0 | (cp >> 18);
+		pOut[1] = 0x80 | ((cp >> 12) & 0x3F);
+		pOut[2] = 0x80 | ((cp >> 6) & 0x3F);
+		pOut[3] = 0x80 | (cp & 0x3F);
+		return	*pIdx += 4, 4;
+		}
 
-	/* First Octet of SMS_DELIVER PDU */
-	pdsc->firstOct = obuf[idx++];
-	if ((pdsc->firstOct & 0x40) == USER_DATA_HEADER_INDICATION)
-		pdsc->isHeaderPrsnt = TRUE;
+	if ( room < 3 )
+		return	0;
 
-	/* Message Type Indicator */
-	switch (pdsc->firstOct & 0x03)
+	cp = (__UCS2_IS_HIGH(cp) || __UCS2_IS_LOW(cp)) ? 0xFFFD : cp;		/* Lone surrogate */
+	pOut[0] = 0xE0 | (cp >> 12);
+	pOut[1] = 0x80 | ((cp >> 6) & 0x3F);
+	pOut[2] = 0x80 | (cp & 0x3F);
+	return	*pIdx += 2, 3;
+}
+
+static int	__ucs2_utf8_scalar(const uint8_t *pIn, int inLen, uint8_t *pOut, int outSz)
+{
+int	idx = 0, o = 0, n;
+
+	while ( (idx < inLen) && (n = __ucs2_utf8_chr(pIn, inLen, &idx, &pOut[o], outSz - o)) )
+		o += n;
+
+	return	o;
+}
+
+#ifdef	PDU_X86_SIMD
+/* SSE2: blocks of 8 code units which are all ASCII or all 2-octet characters (Cyrillic,
+ * Greek, ...) are converted at once, other blocks character by character
+ */
+static __attribute__((target("sse2"))) int __ucs2_utf8_sse2(const uint8_t *pIn, int inLen, uint8_t *pOut, int outSz)
+{
+int	idx = 0, o = 0, end, n;
+__m128i	v, u, zero = _mm_setzero_si128();
+
+	while ( (idx + 16 <= inLen) && (o + 16 <= outSz) )
+		{
+		v = _mm_loadu_si128((const __m128i *) &pIn[idx]);
+		u = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));		/* Big-endian units */
+
+		if ( 0xFFFF == _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(u, _mm_set1_epi16((short) 0xFF80)), zero)) )
+			{
+			_mm_storel_epi64((__m128i *) &pOut[o], _mm_packus_epi16(u, u));
+			idx += 16, o += 8;
+			continue;
+			}
+
+		if ( (0xFFFF == _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(u, _mm_set1_epi16((short) 0xF800)), zero)))
+			&& !_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(u, _mm_set1_epi16((short) 0xFF80)), zero)) )
+			{
+			/* Lead octet in the low byte, trail octet in the high byte of each unit */
+			v = _mm_or_si128(_mm_or_si128(_mm_srli_epi16(u, 6), _mm_set1_epi16(0xC0)),
+				_mm_slli_epi16(_mm_or_si128(_mm_and_si128(u, _mm_set1_epi16(0x3F)), _mm_set1_epi16(0x80)), 8));
+			_mm_storeu_si128((__m128i *) &pOut[o], v);
+			idx += 16, o += 16;
+			continue;
+			}
+
+		for (end = idx + 16; idx < end; o += n)			/* A pair may end past the block */
+			if ( !(n = __ucs2_utf8_chr(pIn, inLen, &idx, &pOut[o], outSz - o)) )
+				return	o;
+		}
+
+	return	o + __ucs2_utf8_scalar(&pIn[idx], inLen - idx, &pOut[o], outSz - o);
+}
+
+/* Compaction of 8 units in the 2-octet form: ASCII unit (bit is set) keeps its low octet only */
+static const uint8_t	__ucs2_utf8_shuf[256][16] __attribute__((aligned(16))) = {
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F },	/* 0x00 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80 },	/* 0x01 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80 },	/* 0x02 */
+	{ 0x00, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80 },	/* 0x03 */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80 },	/* 0x04 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80 },	/* 0x05 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80 },	/* 0x06 */
+	{ 0x00, 0x02, 0x04, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x07 */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80 },	/* 0x08 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80 },	/* 0x09 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80 },	/* 0x0A */
+	{ 0x00, 0x02, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x0B */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80 },	/* 0x0C */
+	{ 0x00, 0x02, 0x03, 0x04, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x0D */
+	{ 0x00, 0x01, 0x02, 0x04, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x0E */
+	{ 0x00, 0x02, 0x04, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x0F */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80 },	/* 0x10 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80 },	/* 0x11 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80 },	/* 0x12 */
+	{ 0x00, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x13 */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x06, 0x07, 0x08, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80 },	/* 0x14 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x06, 0x07, 0x08, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x15 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x06, 0x07, 0x08, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x16 */
+	{ 0x00, 0x02, 0x04, 0x06, 0x07, 0x08, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x17 */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80 },	/* 0x18 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x19 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x08, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x1A */
+	{ 0x00, 0x02, 0x04, 0x05, 0x06, 0x08, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x1B */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x06, 0x08, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x1C */
+	{ 0x00, 0x02, 0x03, 0x04, 0x06, 0x08, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x1D */
+	{ 0x00, 0x01, 0x02, 0x04, 0x06, 0x08, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x1E */
+	{ 0x00, 0x02, 0x04, 0x06, 0x08, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x1F */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80 },	/* 0x20 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80 },	/* 0x21 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80 },	/* 0x22 */
+	{ 0x00, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x23 */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80 },	/* 0x24 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x25 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x26 */
+	{ 0x00, 0x02, 0x04, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x27 */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80 },	/* 0x28 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x29 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x2A */
+	{ 0x00, 0x02, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x2B */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x2C */
+	{ 0x00, 0x02, 0x03, 0x04, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x2D */
+	{ 0x00, 0x01, 0x02, 0x04, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x2E */
+	{ 0x00, 0x02, 0x04, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x2F */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80 },	/* 0x30 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x31 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x32 */
+	{ 0x00, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x33 */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x06, 0x07, 0x08, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x34 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x06, 0x07, 0x08, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x35 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x06, 0x07, 0x08, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x36 */
+	{ 0x00, 0x02, 0x04, 0x06, 0x07, 0x08, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x37 */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x38 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x39 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x08, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x3A */
+	{ 0x00, 0x02, 0x04, 0x05, 0x06, 0x08, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x3B */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x06, 0x08, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x3C */
+	{ 0x00, 0x02, 0x03, 0x04, 0x06, 0x08, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x3D */
+	{ 0x00, 0x01, 0x02, 0x04, 0x06, 0x08, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x3E */
+	{ 0x00, 0x02, 0x04, 0x06, 0x08, 0x0A, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x3F */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0E, 0x0F, 0x80 },	/* 0x40 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0E, 0x0F, 0x80, 0x80 },	/* 0x41 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0E, 0x0F, 0x80, 0x80 },	/* 0x42 */
+	{ 0x00, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x43 */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0E, 0x0F, 0x80, 0x80 },	/* 0x44 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x45 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x46 */
+	{ 0x00, 0x02, 0x04, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x47 */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0E, 0x0F, 0x80, 0x80 },	/* 0x48 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x49 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x4A */
+	{ 0x00, 0x02, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x4B */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x4C */
+	{ 0x00, 0x02, 0x03, 0x04, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x4D */
+	{ 0x00, 0x01, 0x02, 0x04, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x4E */
+	{ 0x00, 0x02, 0x04, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x4F */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0A, 0x0B, 0x0C, 0x0E, 0x0F, 0x80, 0x80 },	/* 0x50 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0A, 0x0B, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x51 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0A, 0x0B, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x52 */
+	{ 0x00, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0A, 0x0B, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x53 */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x06, 0x07, 0x08, 0x0A, 0x0B, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x54 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x06, 0x07, 0x08, 0x0A, 0x0B, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x55 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x06, 0x07, 0x08, 0x0A, 0x0B, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x56 */
+	{ 0x00, 0x02, 0x04, 0x06, 0x07, 0x08, 0x0A, 0x0B, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x57 */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x0A, 0x0B, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x58 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x0A, 0x0B, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x59 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x08, 0x0A, 0x0B, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x5A */
+	{ 0x00, 0x02, 0x04, 0x05, 0x06, 0x08, 0x0A, 0x0B, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x5B */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x06, 0x08, 0x0A, 0x0B, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x5C */
+	{ 0x00, 0x02, 0x03, 0x04, 0x06, 0x08, 0x0A, 0x0B, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x5D */
+	{ 0x00, 0x01, 0x02, 0x04, 0x06, 0x08, 0x0A, 0x0B, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x5E */
+	{ 0x00, 0x02, 0x04, 0x06, 0x08, 0x0A, 0x0B, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x5F */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0E, 0x0F, 0x80, 0x80 },	/* 0x60 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x61 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x62 */
+	{ 0x00, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x63 */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x64 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x65 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x66 */
+	{ 0x00, 0x02, 0x04, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x67 */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x68 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x69 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x6A */
+	{ 0x00, 0x02, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x6B */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x6C */
+	{ 0x00, 0x02, 0x03, 0x04, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x6D */
+	{ 0x00, 0x01, 0x02, 0x04, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x6E */
+	{ 0x00, 0x02, 0x04, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x6F */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0A, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80 },	/* 0x70 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0A, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x71 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0A, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x72 */
+	{ 0x00, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0A, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x73 */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x06, 0x07, 0x08, 0x0A, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x74 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x06, 0x07, 0x08, 0x0A, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x75 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x06, 0x07, 0x08, 0x0A, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x76 */
+	{ 0x00, 0x02, 0x04, 0x06, 0x07, 0x08, 0x0A, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x77 */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x0A, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80 },	/* 0x78 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x0A, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x79 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x08, 0x0A, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x7A */
+	{ 0x00, 0x02, 0x04, 0x05, 0x06, 0x08, 0x0A, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x7B */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x06, 0x08, 0x0A, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x7C */
+	{ 0x00, 0x02, 0x03, 0x04, 0x06, 0x08, 0x0A, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x7D */
+	{ 0x00, 0x01, 0x02, 0x04, 0x06, 0x08, 0x0A, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x7E */
+	{ 0x00, 0x02, 0x04, 0x06, 0x08, 0x0A, 0x0C, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x7F */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80 },	/* 0x80 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80 },	/* 0x81 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80 },	/* 0x82 */
+	{ 0x00, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80 },	/* 0x83 */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80 },	/* 0x84 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80 },	/* 0x85 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80 },	/* 0x86 */
+	{ 0x00, 0x02, 0x04, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0x87 */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80 },	/* 0x88 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80 },	/* 0x89 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80 },	/* 0x8A */
+	{ 0x00, 0x02, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0x8B */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80 },	/* 0x8C */
+	{ 0x00, 0x02, 0x03, 0x04, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0x8D */
+	{ 0x00, 0x01, 0x02, 0x04, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0x8E */
+	{ 0x00, 0x02, 0x04, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x8F */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80 },	/* 0x90 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80 },	/* 0x91 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80 },	/* 0x92 */
+	{ 0x00, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0x93 */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x06, 0x07, 0x08, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80 },	/* 0x94 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x06, 0x07, 0x08, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0x95 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x06, 0x07, 0x08, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0x96 */
+	{ 0x00, 0x02, 0x04, 0x06, 0x07, 0x08, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x97 */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80 },	/* 0x98 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0x99 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x08, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0x9A */
+	{ 0x00, 0x02, 0x04, 0x05, 0x06, 0x08, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x9B */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x06, 0x08, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0x9C */
+	{ 0x00, 0x02, 0x03, 0x04, 0x06, 0x08, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x9D */
+	{ 0x00, 0x01, 0x02, 0x04, 0x06, 0x08, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x9E */
+	{ 0x00, 0x02, 0x04, 0x06, 0x08, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0x9F */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80 },	/* 0xA0 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80 },	/* 0xA1 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80 },	/* 0xA2 */
+	{ 0x00, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xA3 */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80 },	/* 0xA4 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xA5 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xA6 */
+	{ 0x00, 0x02, 0x04, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xA7 */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80 },	/* 0xA8 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xA9 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xAA */
+	{ 0x00, 0x02, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xAB */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xAC */
+	{ 0x00, 0x02, 0x03, 0x04, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xAD */
+	{ 0x00, 0x01, 0x02, 0x04, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xAE */
+	{ 0x00, 0x02, 0x04, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xAF */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80 },	/* 0xB0 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xB1 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xB2 */
+	{ 0x00, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xB3 */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x06, 0x07, 0x08, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xB4 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x06, 0x07, 0x08, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xB5 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x06, 0x07, 0x08, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xB6 */
+	{ 0x00, 0x02, 0x04, 0x06, 0x07, 0x08, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xB7 */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xB8 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xB9 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x08, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xBA */
+	{ 0x00, 0x02, 0x04, 0x05, 0x06, 0x08, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xBB */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x06, 0x08, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xBC */
+	{ 0x00, 0x02, 0x03, 0x04, 0x06, 0x08, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xBD */
+	{ 0x00, 0x01, 0x02, 0x04, 0x06, 0x08, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xBE */
+	{ 0x00, 0x02, 0x04, 0x06, 0x08, 0x0A, 0x0C, 0x0D, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xBF */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0E, 0x80, 0x80 },	/* 0xC0 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0E, 0x80, 0x80, 0x80 },	/* 0xC1 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0E, 0x80, 0x80, 0x80 },	/* 0xC2 */
+	{ 0x00, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xC3 */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0E, 0x80, 0x80, 0x80 },	/* 0xC4 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xC5 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xC6 */
+	{ 0x00, 0x02, 0x04, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xC7 */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0E, 0x80, 0x80, 0x80 },	/* 0xC8 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xC9 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xCA */
+	{ 0x00, 0x02, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xCB */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xCC */
+	{ 0x00, 0x02, 0x03, 0x04, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xCD */
+	{ 0x00, 0x01, 0x02, 0x04, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xCE */
+	{ 0x00, 0x02, 0x04, 0x06, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xCF */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0A, 0x0B, 0x0C, 0x0E, 0x80, 0x80, 0x80 },	/* 0xD0 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0A, 0x0B, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xD1 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0A, 0x0B, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xD2 */
+	{ 0x00, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0A, 0x0B, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xD3 */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x06, 0x07, 0x08, 0x0A, 0x0B, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xD4 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x06, 0x07, 0x08, 0x0A, 0x0B, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xD5 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x06, 0x07, 0x08, 0x0A, 0x0B, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xD6 */
+	{ 0x00, 0x02, 0x04, 0x06, 0x07, 0x08, 0x0A, 0x0B, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xD7 */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x0A, 0x0B, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xD8 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x0A, 0x0B, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xD9 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x08, 0x0A, 0x0B, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xDA */
+	{ 0x00, 0x02, 0x04, 0x05, 0x06, 0x08, 0x0A, 0x0B, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xDB */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x06, 0x08, 0x0A, 0x0B, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xDC */
+	{ 0x00, 0x02, 0x03, 0x04, 0x06, 0x08, 0x0A, 0x0B, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xDD */
+	{ 0x00, 0x01, 0x02, 0x04, 0x06, 0x08, 0x0A, 0x0B, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xDE */
+	{ 0x00, 0x02, 0x04, 0x06, 0x08, 0x0A, 0x0B, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xDF */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0E, 0x80, 0x80, 0x80 },	/* 0xE0 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xE1 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xE2 */
+	{ 0x00, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xE3 */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xE4 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xE5 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xE6 */
+	{ 0x00, 0x02, 0x04, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xE7 */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xE8 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xE9 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xEA */
+	{ 0x00, 0x02, 0x04, 0x05, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xEB */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xEC */
+	{ 0x00, 0x02, 0x03, 0x04, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xED */
+	{ 0x00, 0x01, 0x02, 0x04, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xEE */
+	{ 0x00, 0x02, 0x04, 0x06, 0x08, 0x09, 0x0A, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xEF */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0A, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80 },	/* 0xF0 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0A, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xF1 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0A, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xF2 */
+	{ 0x00, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0A, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xF3 */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x06, 0x07, 0x08, 0x0A, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xF4 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x06, 0x07, 0x08, 0x0A, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xF5 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x06, 0x07, 0x08, 0x0A, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xF6 */
+	{ 0x00, 0x02, 0x04, 0x06, 0x07, 0x08, 0x0A, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xF7 */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x0A, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xF8 */
+	{ 0x00, 0x02, 0x03, 0x04, 0x05, 0x06, 0x08, 0x0A, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xF9 */
+	{ 0x00, 0x01, 0x02, 0x04, 0x05, 0x06, 0x08, 0x0A, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xFA */
+	{ 0x00, 0x02, 0x04, 0x05, 0x06, 0x08, 0x0A, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xFB */
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x06, 0x08, 0x0A, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xFC */
+	{ 0x00, 0x02, 0x03, 0x04, 0x06, 0x08, 0x0A, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xFD */
+	{ 0x00, 0x01, 0x02, 0x04, 0x06, 0x08, 0x0A, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xFE */
+	{ 0x00, 0x02, 0x04, 0x06, 0x08, 0x0A, 0x0C, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },	/* 0xFF */
+};
+
+/* AVX2: blocks of 16 code units: all ASCII are packed, mixed ASCII & 2-octet characters are
+ * made in the 2-octet form and compacted by PSHUFB, other blocks character by character
+ */
+static __attribute__((target("avx2"))) int __ucs2_utf8_avx2(const uint8_t *pIn, int inLen, uint8_t *pOut, int outSz)
+{
+int	idx = 0, o = 0, end, n;
+unsigned	ascii, twoOct;
+__m256i	v, u, t;
+__m128i	h;
+const __m256i	swap = _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+			1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+
+	while ( (idx + 32 <= inLen) && (o + 32 <= outSz) )
+		{
+		v = _mm256_loadu_si256((const __m256i *) &pIn[idx]);
+		u = _mm256_shuffle_epi8(v, swap);
+
+		/* Two bits per unit: ASCII, fits 2 octets */
+		ascii = _mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_and_si256(u, _mm256_set1_epi16((short) 0xFF80)),
+			_mm256_setzero_si256()));
+		twoOct = _mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_and_si256(u, _mm256_set1_epi16((short) 0xF800)),
+			_mm256_setzero_si256()));
+
+		if ( ascii == 0xFFFFFFFF )
+			{
+			t = _mm256_permute4x64_epi64(_mm256_packus_epi16(u, u), 0xD8);
+			_mm_storeu_si128((__m128i *) &pOut[o], _mm256_castsi256_si128(t));
+			idx += 32, o += 16;
+			continue;
+			}
+
+		if ( twoOct == 0xFFFFFFFF )
+			{
+			t = _mm256_or_si256(_mm256_or_si256(_mm256_srli_epi16(u, 6), _mm256_set1_epi16(0xC0)),
+				_mm256_slli_epi16(_mm256_or_si256(_mm256_and_si256(u, _mm256_set1_epi16(0x3F)),
+				_mm256_set1_epi16(0x80)), 8));
+			v = _mm256_cmpeq_epi16(_mm256_and_si256(u, _mm256_set1_epi16((short) 0xFF80)), _mm256_setzero_si256());
+			t = _mm256_blendv_epi8(t, u, v);
+
+			/* One bit per unit: units 0-7 in bits 0-7, units 8-15 in bits 16-23 */
+			ascii = _mm256_movemask_epi8(_mm256_packs_epi16(v, _mm256_setzero_si256()));
+			ascii = (ascii & 0xFF) | ((ascii >> 8) & 0xFF00);
+			h = _mm_shuffle_epi8(_mm256_castsi256_si128(t), _mm_load_si128((const __m128i *) __ucs2_utf8_shuf[ascii & 0xFF]));
+			_mm_storeu_si128((__m128i *) &pOut[o], h);
+			o += 16 - __builtin_popcount(ascii & 0xFF);
+
+			h = _mm_shuffle_epi8(_mm256_extracti128_si256(t, 1), _mm_load_si128((const __m128i *) __ucs2_utf8_shuf[ascii >> 8]));
+			_mm_storeu_si128((__m128i *) &pOut[o], h);
+			o += 16 - __builtin_popcount(ascii >> 8);
+
+			idx += 32;
+			continue;
+			}
+
+		for (end = idx + 32; idx < end; o += n)
+			if ( !(n = __ucs2_utf8_chr(pIn, inLen, &idx, &pOut[o], outSz - o)) )
+				return	o;
+		}
+
+	_mm256_zeroupper();							/* No AVX-SSE transition penalty in the tail */
+
+	return	o + __ucs2_utf8_sse2(&pIn[idx], inLen - idx, &pOut[o], outSz - o);
+}
+#endif	/* PDU_X86_SIMD */
+
+//***************************************************************************
+// @NAME        : i_Ucs2StrToUtf8Str
+// @PARAM       : uint8_t *ucsIn - UCS-2 (big-endian, UTF-16 surrogate pairs) string
+//				  int ucsInLen - length of the string in octets
+//				  uint8_t *pStrOutUtf - The pointer to buffer containing converted
+//									  UTF8 character set.
+//				  int outSz - size of the output buffer including NUL
+// @RETURNS     : Length of the UTF-8 string
+// @DESCRIPTION : This function converts UCS-2 as it's carried by the TP-UD to UTF-8,
+//				  a trailing odd octet is ignored, a lone surrogate gives U+FFFD.
+//***************************************************************************
+static int i_Ucs2StrToUtf8Str(const uint8_t *ucsIn, int ucsInLen, uint8_t *pStrOutUtf, int outSz)
+{
+int	len = __PDU_KERN(__ucs2_utf8_kern)(ucsIn, ucsInLen & ~1, pStrOutUtf, outSz - 1);
+
+	pStrOutUtf[len] = '\0';
+
+	return	len;
+}
+
+//***************************************************************************
+// @NAME        : i_DecSemiOctet2Ascii
+// @PARAM       : decSemiOctetBuf - Pointer to decimal semi octet buffer.
+//				  decSemiOctetLen - length of the semi octet string
+//				  asciiStrng - Pointer to ascii buffer.
+// @RETURNS     : void.
+// @DESCRIPTION : This function converts decimal semi octet in to ascii.
+//***************************************************************************
+static uint8_t i_DecSemiOctet2Ascii(uint8_t *pDecSemiOctetBuf, int decSemiOctetLen, uint8_t *pAsciiStrng)
+{
+int	idx, loopCnt;
+uint8_t asciiChar, asciiNextChar;
+
+
+	loopCnt = decSemiOctetLen >> 1;
+
+	for (idx = 0; idx < loopCnt; idx++)
+	{
+		asciiChar = pDecSemiOctetBuf[idx*2];
+		asciiNextChar = pDecSemiOctetBuf[(idx*2) + 1];
+
+		pAsciiStrng[idx*2] = asciiNextChar;
+		if (idx == (loopCnt - 1))
+		{
+			if (asciiChar == 'F')
+			{
+				pAsciiStrng[(idx*2) + 1] = '\0';
+				return (decSemiOctetLen - 1);
+			}
+			else
+			{
+				pAsciiStrng[(idx*2) + 1] = asciiChar;
+			}
+		}
+		else
+		{
+			pAsciiStrng[(idx*2) + 1] = asciiChar;
+		}
+	}
+
+	pAsciiStrng[idx*2] = '\0';
+
+	return (decSemiOctetLen);
+}
+
+
+//***************************************************************************
+// @NAME        : i_Ascii2DecSemiOctet
+// @PARAM       : asciiStrng - Pointer to ascii buffer.
+//				  decSemiOctetBuf - Pointer to decimal semi octet buffer.
+// @RETURNS     : void.
+// @DESCRIPTION : This function converts ascii in to decimal semi octet.
+//***************************************************************************
+static uint8_t i_Ascii2DecSemiOctet(uint8_t *pAsciiStrng, uint8_t *pDecSemiOctetBuf)
+{
+	uint8_t idx = 0;
+	uint8_t asciiChar = 0;
+	uint8_t asciiNextChar = 0;
+	uint8_t asciiLen= 0;
+	uint8_t loopCnt = 0;
+	uint8_t isToAddF = 0;
+
+	asciiLen = strlen ( (char *) pAsciiStrng);
+
+	if ((asciiLen % 2) != 0)
+	{
+		asciiLen++;
+		isToAddF = TRUE;
+	}
+	loopCnt = asciiLen >> 1;
+
+	for (idx = 0; idx < loopCnt; idx++)
+	{
+		asciiChar = pAsciiStrng[idx*2];
+		if (idx == (loopCnt - 1))
+		{
+			if (isToAddF == TRUE)
+			{
+				asciiNextChar = 'F';
+			}
+			else
+			{
+				asciiNextChar = pAsciiStrng[(idx*2) + 1];
+			}
+		}
+		else
+		{
+			asciiNextChar = pAsciiStrng[(idx*2) + 1];
+		}
+
+		pDecSemiOctetBuf[idx*2] = asciiNextChar;
+		pDecSemiOctetBuf[(idx*2) + 1] = asciiChar;
+	}
+	pDecSemiOctetBuf[idx*2] = '\0';
+
+	return (asciiLen);
+}
+
+
+//***************************************************************************
+// @NAME        : i_TextToPdu
+// @PARAM       : asciiBuf- Pointer to ascii buffer containing text data.
+//				  asciiLen - number of septets
+//				  bitOff - number of fill bits before the first septet, 0 - 7
+//				  pduBuf - Pointer to pdu buffer(for converted pdu data).
+//				  pduSz - size of pdu buffer
+// @RETURNS     : int,pdu data length.
+// @DESCRIPTION : This function converts Text data(7bit) to pdu data(8bit). The work
+//				  is done by a kernel selected at run-time, which packs 8 septets
+//				  into 7 octets per step. Septets which don't fit into the pdu
+//				  buffer are dropped, nothing is written beyond pduSz.
+//***************************************************************************
+static int i_Text2Pdu(const uint8_t *pAsciiBuf, int asciiLen, int bitOff, uint8_t *pPduBuf, int pduSz)
+{
+	if ( ((bitOff + asciiLen * 7 + 7) >> 3) > pduSz )		/* Don't go beyond the buffer */
+		asciiLen = (pduSz * 8 - bitOff) / 7;
+
+	if ( (asciiLen <= 0) && !bitOff )
+		return	0;
+
+	return	__PDU_KERN(__septet_pack_kern)(pAsciiBuf, (asciiLen > 0) ? asciiLen : 0, bitOff, pPduBuf);
+}
+
+//***************************************************************************
+// @NAME        : i_PduToText
+// @PARAM       : pduBuf - Pointer to pdu buffer(for converted pdu data).
+//				: pduLen - length of pdu data.
+//				  skip - number of septets to skip (UDH and fill bits)
+//				  nsept - number of septets to unpack
+//				  asciiBuf- Pointer to ascii buffer containing text data, nsept + 1 octets
+// @RETURNS     : Number of septets
+// @DESCRIPTION : This function converts pdu data(8bit) to text data(7bit). The work
+//				  is done by a kernel selected at run-time, which unpacks 8 septets
+//				  from a 64-bit word per step starting at any septet boundary, so
+//				  the UDH fill bits are skipped natively.
+//***************************************************************************
+static int i_Pdu2Text(const uint8_t *pPduBuf, int pduLen, int skip, int nsept, uint8_t *pAsciiBuf)
+{
+	if ( ((skip + nsept) * 7) > (pduLen * 8) )			/* Don't go beyond the PDU */
+		nsept = (pduLen * 8) / 7 - skip;
+
+	nsept = (nsept > 0) ? __PDU_KERN(__septet_unpack_kern)(pPduBuf, pduLen, skip, nsept, pAsciiBuf) : 0;
+
+	pAsciiBuf[nsept] = '\0';
+
+	return	nsept;
+}
+
+/*  DESCRIPTION: Prepare the PDU descriptor for decoding. Only the header fields and
+ *	the tail after user data are zeroed, the user data buffer is just terminated,
+ *	so we don't touch ~640 bytes of text per a decoded message.
+ *
+ *   INPUTS:
+ *	pdsc:	a PDU descriptor to be reset
+ *
+ *   OUTPUS:
+ *	NONE:
+ *
+ *   RETURNS:
+ *	NONE
+ */
+static	inline void __pdsc_reset(PDU_DESC *pdsc)
+{
+	memset(pdsc, 0, offsetof(PDU_DESC, usrData));
+	pdsc->usrData[0] = '\0';
+	memset(&pdsc->udhLen, 0, sizeof(PDU_DESC) - offsetof(PDU_DESC, udhLen));
+}
+
+/* PDU_HDR must stay in one cache line */
+typedef char	__pdu_hdr_size_check[(sizeof(PDU_HDR) <= 64) ? 1 : -1];
+
+/* Check that <n> more octets are available in the PDU, return ERR_PDU_LENGTH otherwise */
+#define	__PDU_NEED(n)	if ( (idx + (n)) > olen ) return *pError = ERR_PDU_LENGTH, (FALSE)
+
+//***************************************************************************
+// @NAME        : __pdu_parse
+// @PARAM       : obuf - PDU in binary (octets) form
+//				  olen - number of octets in the obuf
+//				  flags - PDU_F_* flags
+//				  view - view to be filled
+//				  pError - error code on failure
+// @RETURNS     : TRUE/FALSE
+// @DESCRIPTION : This function parses PDU octets & records offsets of the TPDU elements,
+//				  nothing is copied or converted. Every element is checked against
+//				  the olen, so nothing is read beyond the PDU.
+//***************************************************************************
+static int	__pdu_parse(const unsigned char *obuf, int olen, int flags, PDU_VIEW *view, int *pError)
+{
+ int	idx = 0, addrLen = 0;
+ uint8_t npi = 0;
+ uint8_t udl = 0;
+ uint8_t grpId = 0;
+ uint8_t toa, dcs;
+
+	memset(view, PDU_VIEW_NONE, sizeof(PDU_VIEW));
+	view->pdu = obuf;
+	view->len = olen;
+	view->usrDataFormat = view->flags = 0;
+	view->udOctets = view->udSkip = view->udCount = 0;
+
+	if ( !(flags & PDU_F_NO_SMSC) )						/* TPDU only - no SMSC address block */
+		{
+		__PDU_NEED(1);
+		view->sca = idx;
+		addrLen = obuf[idx++];						/* Service center Number Length */
+		}
+
+	if ( addrLen )								/* Zero length - SMSC stored on phone is used */
+		{
+		if ( (addrLen - 1) > (ADDR_OCTET_MAX_LEN / 2) )
+			return	*pError = ERR_PDU_LENGTH, (FALSE);
+
+		__PDU_NEED(addrLen);
+		idx += addrLen;							/* Type of Address & Service Center Number */
+		}
+
+	/* First Octet of SMS_DELIVER PDU */
+	__PDU_NEED(1);
+	view->fo = idx;
+	if ((obuf[idx++] & 0x40) == USER_DATA_HEADER_INDICATION)
+		view->flags |= PDU_HDR_F_UDH;
+
+	/* Message Type Indicator */
+	switch (obuf[view->fo] & 0x03)
 		{
 		case MSG_TYPE_SMS_DELIVER:
-			pdsc->msgType = MSG_TYPE_SMS_DELIVER;
+			view->msgType = MSG_TYPE_SMS_DELIVER;
 			break;
 
 		case MSG_TYPE_SMS_STATUS_REPORT:				/* Message Reference Number TP-MR of SMS_STATUS_REPORT PDU */
-			pdsc->msgType = MSG_TYPE_SMS_STATUS_REPORT;
-			pdsc->msgRefNo = obuf[idx++];
+			view->msgType = MSG_TYPE_SMS_STATUS_REPORT;
+			__PDU_NEED(1);
+			view->mr = idx++;
 			break;
 
 		default:
@@ -1088,16 +2535,18 @@ int	DecodePduData(unsigned char *pdu, PDU_DESC *pdsc, int *pError)
 		}
 
 
-	pdsc->phoneAddrLen = obuf[idx++];					/* Phone Number Length */
+	__PDU_NEED(2);
+	view->oa = idx;
+	addrLen = obuf[idx++];							/* Phone Number Length */
 
-	pdsc->phoneTypeOfAddr = obuf[idx++];					/* Phone Number Type of Address (Eg: 91 , 81) */
+	if ( addrLen > ADDR_OCTET_MAX_LEN )
+		return	*pError = ERR_PDU_LENGTH, (FALSE);
 
-	npi = pdsc->phoneTypeOfAddr & 0x0F;					/* Numbering Plan Identification */
+	toa = obuf[idx++];							/* Phone Number Type of Address (Eg: 91 , 81) */
 
-	pdsc->phoneTypeOfAddr = (pdsc->phoneTypeOfAddr & 0x70) >> 4;		/* Type of Number */
+	npi = toa & 0x0F;							/* Numbering Plan Identification */
 
-
-	switch (pdsc->phoneTypeOfAddr)						/* Check type of number */
+	switch ((toa & 0x70) >> 4)						/* Check type of number */
 		{
 		case NUM_TYPE_UNKNOWN:
 		case NUM_TYPE_INTERNATIONAL:
@@ -1108,24 +2557,9 @@ int	DecodePduData(unsigned char *pdu, PDU_DESC *pdsc, int *pError)
 				*pError = ERR_PHONE_NUM_PLAN;
 				return (FALSE);
 				}
-			/** Phone Number (Source Address) */
-			if (((addrLen = pdsc->phoneAddrLen) % 2) != 0)
-				{
-				/** Eg: For "46708251358" Number Length will be 11 ("6407281553F8") */
-				/** Eg: For "9898907249" Number Length will be 12 ("8989092794") */
-				addrLen++;
-				}
-
-			addrLen = addrLen >> 1; // addrLen / 2
-			__bin2hex(&obuf[idx], addrLen, pdsc->phoneAddr);
-			i_DecSemiOctet2Ascii(pdsc->phoneAddr, pdsc->phoneAddr); // Internal Swapping
-			idx = idx + addrLen;
 			break;
 
 		case NUM_TYPE_ALPHANUMERIC:
-			addrLen = pdsc->phoneAddrLen; // length is in terms of Ascii characters
-			addrLen = addrLen >> 1; // addrLen / 2
-			pdsc->phoneAddrLen = i_Pdu2Text(&obuf[idx], addrLen, pdsc->phoneAddr);
 			break;
 
 		default:
@@ -1133,33 +2567,41 @@ int	DecodePduData(unsigned char *pdu, PDU_DESC *pdsc, int *pError)
 			break;
 		}
 
-	 if (pdsc->msgType == MSG_TYPE_SMS_DELIVER)
+	/** Phone Number (Source Address), length is in terms of semi-octets */
+	/** Eg: For "46708251358" Number Length will be 11 ("6407281553F8") */
+	addrLen = (addrLen + 1) >> 1;
+	__PDU_NEED(addrLen);
+	idx = idx + addrLen;
+
+	 if (view->msgType == MSG_TYPE_SMS_DELIVER)
 		{
-		pdsc->protocolId = obuf[idx++];					/* Protocol Identifier */
+		__PDU_NEED(2);
+		view->pid = idx;						/* Protocol Identifier */
 
-		if (pdsc->protocolId != 0x00)
+		if (obuf[idx++] != 0x00)
 			return	*pError = ERR_PROTOCOL_ID, (FALSE);
 
-		pdsc->dataCodeScheme = obuf[idx++];				/* Data Coding Scheme */
-		grpId = pdsc->dataCodeScheme & 0xF0;
+		view->dcs = idx;						/* Data Coding Scheme */
+		dcs = obuf[idx++];
+		grpId = dcs & 0xF0;
 
 		switch (grpId)
 			{
 			case GROUP1_WITH_MSG_CLASS:
 			case GROUP1_WITH_NO_MSG_CLASS:
 				/** Check Character Set */
-				switch ((pdsc->dataCodeScheme & 0x0C) >> 2)
+				switch ((dcs & 0x0C) >> 2)
 					{
 					case GSM_7BIT:
-						pdsc->usrDataFormat = GSM_7BIT;
+						view->usrDataFormat = GSM_7BIT;
 						break;
 
 					case ANSI_8BIT:
-						pdsc->usrDataFormat = ANSI_8BIT;
+						view->usrDataFormat = ANSI_8BIT;
 						break;
 
 					case UCS2_16BIT:
-						pdsc->usrDataFormat = UCS2_16BIT;
+						view->usrDataFormat = UCS2_16BIT;
 						break;
 
 					default:
@@ -1169,26 +2611,26 @@ int	DecodePduData(unsigned char *pdu, PDU_DESC *pdsc, int *pError)
 
 				if (grpId == GROUP1_WITH_MSG_CLASS)
 				/** Special case consideration Flash Messsage */
-					if ((pdsc->dataCodeScheme & 0x03) == MSG_CLASS0)
-						pdsc->isFlashMsg = TRUE;
+					if ((dcs & 0x03) == MSG_CLASS0)
+						view->flags |= PDU_HDR_F_FLASH;
 				break;
 
 			case GROUP2_WITH_MSG_CLASS:
 				/** Special case consideration Flash Messsage */
-				if ((pdsc->dataCodeScheme & 0x03) == MSG_CLASS0)
-					 pdsc->isFlashMsg = TRUE;
+				if ((dcs & 0x03) == MSG_CLASS0)
+					 view->flags |= PDU_HDR_F_FLASH;
 
-				switch ((pdsc->dataCodeScheme & 0x04) >> 2)
+				switch ((dcs & 0x04) >> 2)
 					{
 					case GSM_7BIT:
-						pdsc->usrDataFormat = GSM_7BIT;
+						view->usrDataFormat = GSM_7BIT;
 						break;
 
 					case ANSI_8BIT:
-						pdsc->usrDataFormat = ANSI_8BIT;
+						view->usrDataFormat = ANSI_8BIT;
 						/** Special case consideration WAP_PUSH Messsage */
-						if ((pdsc->dataCodeScheme & 0x03) == MSG_CLASS1)
-							pdsc->isWapPushMsg = TRUE;
+						if ((dcs & 0x03) == MSG_CLASS1)
+							view->flags |= PDU_HDR_F_WAP_PUSH;
 						break;
 					 }
 				 break;
@@ -1201,197 +2643,846 @@ int	DecodePduData(unsigned char *pdu, PDU_DESC *pdsc, int *pError)
 		}
 
 
-	__bin2hex(&obuf[idx], TIME_STAMP_LEN, pdsc->timeStamp);				/* Service Center Time Stamp */
-	i_DecSemiOctet2Ascii(pdsc->timeStamp, pdsc->timeStamp);					/* Internal Swapping */
-
-	pdsc->date.year = (pdsc->timeStamp[0] - '0') * 10 + (pdsc->timeStamp[1] - '0');
-	pdsc->date.month = (pdsc->timeStamp[2] - '0') * 10 + (pdsc->timeStamp[3] - '0');
-	pdsc->date.day = (pdsc->timeStamp[4] - '0') * 10 + (pdsc->timeStamp[5] - '0');
-
-	pdsc->time.hour = (pdsc->timeStamp[6] - '0') * 10 + (pdsc->timeStamp[7] - '0');
-	pdsc->time.minute = (pdsc->timeStamp[8] - '0') * 10 + (pdsc->timeStamp[9] - '0');
-	pdsc->time.second = (pdsc->timeStamp[10] - '0') * 10 + (pdsc->timeStamp[11] - '0');
-
+	__PDU_NEED(TIME_STAMP_LEN);
+	view->scts = idx;							/* Service Center Time Stamp */
 	idx += TIME_STAMP_LEN;
 
-	if (pdsc->msgType == MSG_TYPE_SMS_STATUS_REPORT)
+	if (view->msgType == MSG_TYPE_SMS_STATUS_REPORT)
 		{
-		/** Discharge Time Stamp */
-		__bin2hex(&obuf[idx], TIME_STAMP_LEN, pdsc->dischrgTimeStamp);
-		i_DecSemiOctet2Ascii(pdsc->dischrgTimeStamp, pdsc->dischrgTimeStamp); // Internal Swapping
-		idx += TIME_STAMP_LEN;
-
-		/** Status of SMS */
-		pdsc->smsSts = obuf[idx++];
-
-		pdsc->smsSts = (pdsc->smsSts == 0x00) ? MSG_DELIVERY_SUCCESS : MSG_DELIVERY_FAIL;
+		/** Discharge Time Stamp, Status of SMS */
+		__PDU_NEED(TIME_STAMP_LEN + 1);
+		view->dt = idx;
+		view->st = idx + TIME_STAMP_LEN;
 
 		return (TRUE);
 		}
 
 	/* User Data Length */
-	pdsc->usrDataLen = obuf[idx++];
-	udl = pdsc->usrDataLen;
-
-	/* User Data */
+	__PDU_NEED(1);
+	view->udl = idx;
+	udl = obuf[idx++];
 
-	/*****************************************************************************
-	* Below section of code process user data header information
-	*****************************************************************************/
-
-	if (pdsc->isHeaderPrsnt) 		// Check whether Header Present
+	/* Check that the User Data fits into the PDU */
+	if (view->usrDataFormat == GSM_7BIT)
 		{
-		pdsc->udhLen = obuf[idx++];
-
-		for (length = idx; length < (idx + pdsc->udhLen); length += idx)
-			{
-			pdsc->udhInfoType = obuf[idx++];
-			pdsc->udhInfoLen = obuf[idx++];
-
-			if (pdsc->udhInfoType == IE_CONCATENATED_MSG) // whether Concatenated Message
-				{
-				pdsc->isConcatenatedMsg = TRUE;
-				pdsc->concateMsgRefNo = obuf[idx++];
-				pdsc->concateTotalParts = obuf[idx++];
-				pdsc->concateCurntPart = obuf[idx++];
-				}
-			else if (pdsc->udhInfoType == IE_PORT_ADDR_8BIT) // Port Address 8bit
-				{
-				pdsc->srcPortAddr = obuf[idx++];
-				pdsc->destPortAddr = obuf[idx++];
-				}
-			else if (pdsc->udhInfoType == IE_PORT_ADDR_16BIT) // Port Address 16bit
-				{
-				pdsc->srcPortAddr = obuf[idx++];
-				pdsc->srcPortAddr = pdsc->srcPortAddr << 8;
-				pdsc->srcPortAddr |= obuf[idx++];
-
-				pdsc->destPortAddr = obuf[idx++];
-				pdsc->destPortAddr = pdsc->destPortAddr << 8;
-				pdsc->destPortAddr |= obuf[idx++];
-				}
-			else	idx = idx + pdsc->udhInfoLen; // Ignoring other Header Information
-			}
+		if ( udl > SMS_GSM7BIT_MAX_LEN )
+			return	*pError = ERR_PDU_LENGTH, (FALSE);
 
-		if (pdsc->usrDataFormat == GSM_7BIT)
-			{
-			uint8_t fillBitsNum = 0;
-			uint8_t udhSeptet = 0;
-
-			/* Derive number of octet to be filled */
-			fillBitsNum = ((1 + pdsc->udhLen) * 8) % 7;
-			fillBitsNum = 7 - fillBitsNum;
+		view->udOctets = (udl * 7 + 7) / 8;
+		}
+	else	{
+		if ( udl > SMS_PDU_USER_DATA_MAX_LEN )
+			return	*pError = ERR_PDU_LENGTH, (FALSE);
 
-			udhSeptet = (((1 + pdsc->udhLen) * 8) + fillBitsNum) / 7;
-			udl -= udhSeptet;
-			}
+		view->udOctets = udl;
 		}
 
-	 /* Extract user data */
-	if (pdsc->usrDataFormat == GSM_7BIT)
+	__PDU_NEED(view->udOctets);
+
+	if (view->flags & PDU_HDR_F_UDH) 	// Check whether Header Present
 		{
-		oct = (udl*7) / 8;
+		__PDU_NEED(1);
+		view->udh = idx;
 
-		if ( (udl = (udl*7) % 8) )
-			oct++;	 // Deriving no. of octes from septets
+		if (view->usrDataFormat == GSM_7BIT)
+			/* Septets occupied by the UDH including fill bits */
+			view->udSkip = (((1 + obuf[idx]) * 8) + 6) / 7;
+		else	view->udSkip = 1 + obuf[idx];
 
-		udl = oct;
-		asciiLen = i_Pdu2Text(&obuf[idx], udl, pdsc->usrData);
-		pdsc->usrDataLen = i_GsmStrToUtf8Str(pdsc->usrData, asciiLen, pdsc->usrData);
-		}
-	else 	{ // for 8/16bit data
-		memcpy(pdsc->usrData, &obuf[idx], pdsc->usrDataLen);
-		pdsc->usrData[pdsc->usrDataLen] = '\0';
+		if ( view->udSkip > udl )
+			return	*pError = ERR_PDU_LENGTH, (FALSE);
+
+		__PDU_NEED(1 + obuf[idx]);
 		}
 
+	view->udCount = udl - view->udSkip;
+
 	return (TRUE);
 }
 
-//***********************************************************************************************
-// @NAME        : EncodePduData
-// @PARAM       : pGsmPduStr-Reference To PDU String
-//				  gsmPduStrLen-Length of PDU String,
-//				  PDU_ENCODE_DESC-Object Pointer
+//***************************************************************************
+// @NAME        : __pdu_udh_parse
+// @PARAM       : view - PDU view with the UDH
+//				  hdr - header, UDH fields to be filled
+//				  ies - list of the Information Elements to be filled, may be NULL
+//				  pIeNum - number of the Information Elements in the list
+//				  pError - error code on failure
 // @RETURNS     : TRUE/FALSE
-// @DESCRIPTION : This function extracts PDU data from Descriptor & Prepares PDU String
-//				  if fails then return FALSE.
-//***********************************udl= udl - udhSeptet;****************************************
-int	EncodePduData(PDU_DESC *pdsc, unsigned char *pdu, int pdusz, int *tpdulen)
+// @DESCRIPTION : This function walks the Information Elements of the UDH in one pass,
+//				  every IE must lie within the UDHL; the concatenation & port address
+//				  IEs must have their fixed lengths. The last IE is kept in
+//				  udhInfoType/udhInfoLen, the first PDU_UDH_IE_MAX go to the list.
+//***************************************************************************
+static int	__pdu_udh_parse(const PDU_VIEW *view, PDU_HDR *hdr, PDU_UDH_IE_DESC *ies, uint8_t *pIeNum, int *pError)
 {
-int	idx, tidx, addrLen, gsmLen;
-unsigned char  obuf[SMS_PDU_MAX_LEN + 1], *tpdu;
+const unsigned char *udh = &view->pdu[view->udh + 1];			/* The view has checked the UDHL fits */
+int	idx, udhLen = udh[-1], ieLen;
 
-	*tpdulen = idx = tidx = addrLen = gsmLen = 0;
+	hdr->udhLen = udhLen;
 
-	if (pdsc->smscAddrLen != 0)					/* Check whether Service Centre Present */
+	for (idx = 0; idx < udhLen; idx += 2 + ieLen)
 		{
-		if ((pdsc->smscAddrLen % 2) != 0)			/* Service center Number Length */
-			pdsc->smscAddrLen++;
+		if ( (idx + 2 > udhLen) || (idx + 2 + (ieLen = udh[idx + 1]) > udhLen) )	/* IE is out of the UDH */
+			return	*pError = ERR_UDH, (FALSE);
 
-		pdsc->smscAddrLen = 1 + (pdsc->smscAddrLen / 2);	/* Adding length of Type of Addr */
-		obuf[idx++] = pdsc->smscAddrLen;
+		hdr->udhInfoType = udh[idx];
+		hdr->udhInfoLen = ieLen;
 
-		if (pdsc->smscTypeOfAddr == NUM_TYPE_INTERNATIONAL)	/* Service Center Type of Address (Eg: 91 , 81) */
-			obuf[idx++] = 0x91;
-		else if (pdsc->smscTypeOfAddr == NUM_TYPE_NATIONAL)
-			obuf[idx++] = 0xA1;
-		else	obuf[idx++] = 0x81;				/* Unknown */
+		if ( ies && (*pIeNum < PDU_UDH_IE_MAX) )
+			{
+			ies[*pIeNum].type = udh[idx];
+			ies[*pIeNum].off = 1 + idx + 2;
+			ies[*pIeNum].len = ieLen;
+			(*pIeNum)++;
+			}
 
+		switch ( udh[idx] )
+			{
+			case	IE_CONCATENATED_MSG:
+				if ( ieLen != IE_CONCATENATED_MSG_LEN )
+					return	*pError = ERR_UDH, (FALSE);
+
+				hdr->flags |= PDU_HDR_F_CONCAT;
+				hdr->concateMsgRefNo = udh[idx + 2];
+				hdr->concateTotalParts = udh[idx + 3];
+				hdr->concateCurntPart = udh[idx + 4];
+				break;
 
-		i_Ascii2DecSemiOctet(pdsc->smscAddr, pdsc->smscAddr);	/* Service Center Number */
-		addrLen = __hex2bin(pdsc->smscAddr, &obuf[idx]);
-		idx = idx + addrLen;
+			case	IE_PORT_ADDR_8BIT:
+				if ( ieLen != 2 )
+					return	*pError = ERR_UDH, (FALSE);
+
+				hdr->srcPortAddr = udh[idx + 2];
+				hdr->destPortAddr = udh[idx + 3];
+				break;
+
+			case	IE_PORT_ADDR_16BIT:
+				if ( ieLen != 4 )
+					return	*pError = ERR_UDH, (FALSE);
+
+				hdr->srcPortAddr = (udh[idx + 2] << 8) | udh[idx + 3];
+				hdr->destPortAddr = (udh[idx + 4] << 8) | udh[idx + 5];
+				break;
+
+			default:						/* Other IEs are skipped */
+				break;
+			}
 		}
-	else	obuf[idx++] = 0x00;					/* SMSC stored on phone is used */
 
-	/* So at this point TP-SCA field has been formed , we can fix TPDU area for the future use*/
-	tpdu = &obuf[idx];
+	return	TRUE;
+}
+
+#undef	__PDU_NEED
+
+/*  DESCRIPTION: Fill the compact header from the view: numeric fields, addresses and
+ *	time stamps as is (semi-octets), UDH Information Elements.
+ *
+ *   INPUTS:
+ *	view:	PDU view
+ *
+ *   OUTPUS:
+ *	hdr:	compact header, user data fields are not set
+ *	ies:	list of the UDH Information Elements, may be NULL
+ *	pIeNum:	number of the Information Elements in the list
+ *	pError:	error code on failure
+ *
+ *   RETURNS:
+ *	TRUE/FALSE
+ */
+static int	__pdu_view2hdr(const PDU_VIEW *view, PDU_HDR *hdr, PDU_UDH_IE_DESC *ies, uint8_t *pIeNum, int *pError)
+{
+const unsigned char *obuf = view->pdu;
+
+	memset(hdr, 0, sizeof(PDU_HDR));
+
+	if ( (view->sca != PDU_VIEW_NONE) && obuf[view->sca] )
+		{
+		hdr->smscTypeOfAddr = (obuf[view->sca + 1] & 0x70) >> 4;	/* Service Center Type of Number */
+		hdr->smscAddrLen = obuf[view->sca] - 1;				/* Subtracting Type of Addr octet length */
+		memcpy(hdr->smscAddr, &obuf[view->sca + 2], hdr->smscAddrLen);
+		}
+
+	hdr->msgType = view->msgType;
+	hdr->firstOct = obuf[view->fo];
+	hdr->flags = view->flags;
+	hdr->usrDataFormat = view->usrDataFormat;
+
+	if ( view->mr != PDU_VIEW_NONE )
+		hdr->msgRefNo = obuf[view->mr];
+
+	hdr->phoneAddrLen = obuf[view->oa];
+	hdr->phoneTypeOfAddr = (obuf[view->oa + 1] & 0x70) >> 4;
+	memcpy(hdr->phoneAddr, &obuf[view->oa + 2], (hdr->phoneAddrLen + 1) >> 1);
+
+	if ( view->dcs != PDU_VIEW_NONE )
+		{
+		hdr->protocolId = obuf[view->pid];
+		hdr->dataCodeScheme = obuf[view->dcs];
+		}
+
+	memcpy(hdr->timeStamp, &obuf[view->scts], TIME_STAMP_LEN);
+
+	if ( view->dt != PDU_VIEW_NONE )
+		{
+		memcpy(hdr->dischrgTimeStamp, &obuf[view->dt], TIME_STAMP_LEN);
+		hdr->smsSts = (obuf[view->st] == 0x00) ? MSG_DELIVERY_SUCCESS : MSG_DELIVERY_FAIL;
+		}
+
+	if ( view->udh != PDU_VIEW_NONE )
+		return	__pdu_udh_parse(view, hdr, ies, pIeNum, pError);
+
+	return	TRUE;
+}
+
+/*  DESCRIPTION: Convert the text of the view: GSM 7-bit is unpacked and converted
+ *	to UTF-8, UCS-2 is converted to UTF-8, 8-bit data is copied as is.
+ *
+ *   INPUTS:
+ *	view:		PDU view
+ *	outSz:		size of the output buffer including NUL
+ *	sbuf:		scratch buffer for unpacked septets, SMS_GSM7BIT_MAX_LEN + 1 octets
+ *
+ *   OUTPUS:
+ *	out:		NUL-terminated text
+ *
+ *   RETURNS:
+ *	length of the text w/o NUL
+ */
+static int	__pdu_ud_text(const PDU_VIEW *view, unsigned char *out, int outSz, uint8_t *sbuf)
+{
+int	len;
+
+	if ( view->udl == PDU_VIEW_NONE )					/* No User Data */
+		return	out[0] = '\0', 0;
+
+	if (view->usrDataFormat == GSM_7BIT)
+		{
+		/* Unpack from the start of User Data skipping the UDH septets, septets go to the scratch, UTF-8 expands */
+		len = i_Pdu2Text(&view->pdu[view->udl + 1], view->udOctets, view->udSkip, view->udCount, sbuf);
+
+		return	i_GsmStrToUtf8Str(sbuf, len, out, outSz);
+		}
+
+	if (view->usrDataFormat == UCS2_16BIT)					/* the UDH is skipped, up to 3 octets per unit */
+		return	i_Ucs2StrToUtf8Str(&view->pdu[view->udl + 1 + view->udSkip], view->udCount, out, outSz);
+
+	len = (view->udCount < outSz) ? view->udCount : outSz - 1;		/* for 8bit data, the UDH is skipped */
+	memcpy(out, &view->pdu[view->udl + 1 + view->udSkip], len);
+	out[len] = '\0';
+
+	return	len;
+}
+
+/*  DESCRIPTION: Expand the compact header into the PDU descriptor (except user data):
+ *	addresses and time stamps are converted to strings.
+ *
+ *   INPUTS:
+ *	hdr:	compact header
+ *	sbuf:	scratch buffer for unpacked septets, SMS_GSM7BIT_MAX_LEN + 1 octets
+ *
+ *   OUTPUS:
+ *	pdsc:	PDU descriptor, is supposed to be reset by caller
+ */
+static void	__pdu_hdr2desc(const PDU_HDR *hdr, PDU_DESC *pdsc, uint8_t *sbuf)
+{
+int	length, addrLen, asciiLen;
+
+	pdsc->smscTypeOfAddr = hdr->smscTypeOfAddr;
+
+	if ( hdr->smscAddrLen )							/* Service Center Number */
+		{
+		length = __bin2hex(hdr->smscAddr, hdr->smscAddrLen, pdsc->smscAddr);
+		pdsc->smscAddrLen = i_DecSemiOctet2Ascii(pdsc->smscAddr, length, pdsc->smscAddr);/* Internal Swapping */
+		}
+
+	pdsc->firstOct = hdr->firstOct;
+	pdsc->isHeaderPrsnt = !!(hdr->flags & PDU_HDR_F_UDH);
+	pdsc->msgType = hdr->msgType;
+	pdsc->msgRefNo = hdr->msgRefNo;
+
+	pdsc->phoneAddrLen = hdr->phoneAddrLen;					/* Phone Number (Source Address) */
+	pdsc->phoneTypeOfAddr = hdr->phoneTypeOfAddr;
+	addrLen = (hdr->phoneAddrLen + 1) >> 1;
+
+	if ( hdr->phoneTypeOfAddr == NUM_TYPE_ALPHANUMERIC )
+		{
+		asciiLen = i_Pdu2Text(hdr->phoneAddr, addrLen, 0, (hdr->phoneAddrLen * 4) / 7, sbuf);
+		pdsc->phoneAddrLen = i_GsmStrToUtf8Str(sbuf, asciiLen, pdsc->phoneAddr, sizeof(pdsc->phoneAddr));
+		}
+	else	{
+		length = __bin2hex(hdr->phoneAddr, addrLen, pdsc->phoneAddr);
+		i_DecSemiOctet2Ascii(pdsc->phoneAddr, length, pdsc->phoneAddr); // Internal Swapping
+		}
+
+	pdsc->protocolId = hdr->protocolId;
+	pdsc->dataCodeScheme = hdr->dataCodeScheme;
+	pdsc->usrDataFormat = hdr->usrDataFormat;
+	pdsc->isFlashMsg = !!(hdr->flags & PDU_HDR_F_FLASH);
+	pdsc->isWapPushMsg = !!(hdr->flags & PDU_HDR_F_WAP_PUSH);
+
+	__bin2hex(hdr->timeStamp, TIME_STAMP_LEN, pdsc->timeStamp);		/* Service Center Time Stamp */
+	i_DecSemiOctet2Ascii(pdsc->timeStamp, TIME_STAMP_LEN * 2, pdsc->timeStamp);		/* Internal Swapping */
+
+	pdsc->date.year = (pdsc->timeStamp[0] - '0') * 10 + (pdsc->timeStamp[1] - '0');
+	pdsc->date.month = (pdsc->timeStamp[2] - '0') * 10 + (pdsc->timeStamp[3] - '0');
+	pdsc->date.day = (pdsc->timeStamp[4] - '0') * 10 + (pdsc->timeStamp[5] - '0');
+
+	pdsc->time.hour = (pdsc->timeStamp[6] - '0') * 10 + (pdsc->timeStamp[7] - '0');
+	pdsc->time.minute = (pdsc->timeStamp[8] - '0') * 10 + (pdsc->timeStamp[9] - '0');
+	pdsc->time.second = (pdsc->timeStamp[10] - '0') * 10 + (pdsc->timeStamp[11] - '0');
+
+	if (hdr->msgType == MSG_TYPE_SMS_STATUS_REPORT)
+		{
+		/** Discharge Time Stamp */
+		__bin2hex(hdr->dischrgTimeStamp, TIME_STAMP_LEN, pdsc->dischrgTimeStamp);
+		i_DecSemiOctet2Ascii(pdsc->dischrgTimeStamp, TIME_STAMP_LEN * 2, pdsc->dischrgTimeStamp); // Internal Swapping
+
+		pdsc->smsSts = hdr->smsSts;
+		}
+
+	pdsc->udhLen = hdr->udhLen;
+	pdsc->udhInfoType = hdr->udhInfoType;
+	pdsc->udhInfoLen = hdr->udhInfoLen;
+	pdsc->isConcatenatedMsg = !!(hdr->flags & PDU_HDR_F_CONCAT);
+	pdsc->concateMsgRefNo = hdr->concateMsgRefNo;
+	pdsc->concateTotalParts = hdr->concateTotalParts;
+	pdsc->concateCurntPart = hdr->concateCurntPart;
+	pdsc->srcPortAddr = hdr->srcPortAddr;
+	pdsc->destPortAddr = hdr->destPortAddr;
+}
+
+//***************************************************************************
+// @NAME        : __pdu_decode
+// @PARAM       : obuf - PDU in binary (octets) form
+//				  olen - number of octets in the obuf
+//				  flags - PDU_F_* flags
+//				  pdsc - PDU descriptor to be filled
+//				  sbuf - scratch buffer for unpacked septets, SMS_GSM7BIT_MAX_LEN + 1 octets
+//				  pError - error code on failure
+// @RETURNS     : TRUE/FALSE
+// @DESCRIPTION : This function parses PDU octets & fills relevant parameters in Descriptor,
+//				  the descriptor is supposed to be reset by caller. User Data is not
+//				  converted if PDU_F_HDR_ONLY is set.
+//***************************************************************************
+static int	__pdu_decode(const unsigned char *obuf, int olen, int flags, PDU_DESC *pdsc, uint8_t *sbuf, int *pError)
+{
+PDU_VIEW	view;
+PDU_HDR	hdr;
+
+	if ( !__pdu_parse(obuf, olen, flags, &view, pError) || !__pdu_view2hdr(&view, &hdr, pdsc->udhIe, &pdsc->udhIeNum, pError) )
+		return	FALSE;
+
+	__pdu_hdr2desc(&hdr, pdsc, sbuf);
+
+	if ( !(flags & PDU_F_HDR_ONLY) )					/* Text is materialized on demand */
+		pdsc->usrDataLen = __pdu_ud_text(&view, pdsc->usrData, sizeof(pdsc->usrData), sbuf);
+
+	return	TRUE;
+}
+
+//***************************************************************************
+// @NAME        : __pdu_decode_hdr
+// @PARAM       : obuf - PDU in binary (octets) form
+//				  olen - number of octets in the obuf
+//				  flags - PDU_F_* flags
+//				  hdr - compact header to be filled
+//				  arena - storage for the user data
+//				  pError - error code on failure
+// @RETURNS     : TRUE/FALSE
+// @DESCRIPTION : Common part of the compact header decoders, the arena must have room
+//				  for the worst case text: 2 octets of UTF-8 per septet, 3 octets per
+//				  UCS-2 unit or 1 octet per octet, plus 1; nothing is consumed on failure. With PDU_F_HDR_ONLY
+//				  the arena is not touched and may be NULL.
+//***************************************************************************
+static int	__pdu_decode_hdr(const unsigned char *obuf, int olen, int flags, PDU_HDR *hdr, PDU_ARENA *arena, int *pError)
+{
+PDU_VIEW	view;
+uint8_t	sbuf[SMS_GSM7BIT_MAX_LEN + 1];
+size_t	need;
+
+	if ( !__pdu_parse(obuf, olen, flags, &view, pError) || !__pdu_view2hdr(&view, hdr, NULL, NULL, pError) )
+		return	FALSE;
+
+	if ( flags & PDU_F_HDR_ONLY )						/* Arena is not used */
+		return	TRUE;
+
+	need = (view.usrDataFormat == GSM_7BIT) ? view.udCount * 2 : (view.usrDataFormat == UCS2_16BIT)
+		? (view.udCount / 2) * 3 : view.udCount;
+	need += 1;
+
+	if ( (arena->used + need > arena->size) || (arena->used > UINT32_MAX) )
+		return	*pError = ERR_NO_MEMORY, (FALSE);
+
+	hdr->usrDataOff = (uint32_t) arena->used;
+	hdr->usrDataLen = __pdu_ud_text(&view, &arena->buf[arena->used], need, sbuf);
+	arena->used += hdr->usrDataLen;
+
+	return	TRUE;
+}
+
+//***************************************************************************
+// @NAME        : __pdu_decode_hex
+// @PARAM       : pdu - HEX PDU string, NUL is not required
+//				  len - length of the HEX string
+//				  pdsc - PDU descriptor to be filled
+//				  obuf - scratch buffer for PDU octets, SMS_PDU_MAX_LEN octets
+//				  sbuf - scratch buffer for unpacked septets, SMS_GSM7BIT_MAX_LEN + 1 octets
+//				  pError - error code on failure
+// @RETURNS     : TRUE/FALSE
+// @DESCRIPTION : Common part of the HEX PDU decoders: check length, convert and parse.
+//***************************************************************************
+static int	__pdu_decode_hex(const uint8_t *pdu, size_t len, PDU_DESC *pdsc, unsigned char *obuf, uint8_t *sbuf, int *pError)
+{
+int	olen;
+
+	__pdsc_reset(pdsc);							/* Zeroing output structure */
+
+	if ( (len > SMS_PDU_MAX_LEN * 2) || (len & 1) )				/* Reject over-length or odd input up front */
+		return	*pError = ERR_PDU_LENGTH, (FALSE);
+
+	if ( 0 > (olen = __hex2bin(pdu, (int) len, obuf)) )			/* Converting whole Ascii String to Hex String */
+		return	*pError = ERR_HEX_DATA, (FALSE);
+
+	return	__pdu_decode(obuf, olen, 0, pdsc, sbuf, pError);
+}
+
+//***************************************************************************
+// @NAME        : DecodePduData
+// @PARAM       : pGsmPduStr-Reference To PDU String,
+//				  gsmPduStrLen-Length of PDU String,
+//				  PDU_DECODE_DESC-Object Pointer
+// @RETURNS     : TRUE/FALSE
+// @DESCRIPTION : This function extracts Pdu String data & fills relevant parameters in Descriptor
+//				  if fails then return FALSE.
+//***************************************************************************
+int	DecodePduData(unsigned char *pdu, PDU_DESC *pdsc, int *pError)
+{
+	/* Scan one character more than allowed so an over-length PDU is rejected */
+	return	DecodePduDataN(pdu, __strnlen((char *) pdu, SMS_PDU_MAX_LEN * 2 + 1), pdsc, pError);
+}
+
+//***************************************************************************
+// @NAME        : DecodePduDataN
+// @PARAM       : pdu - HEX PDU string, NUL is not required
+//				  len - length of the HEX string in characters
+//				  pdsc - PDU descriptor to be filled
+//				  pError - error code on failure
+// @RETURNS     : TRUE/FALSE
+// @DESCRIPTION : This function decodes a length-delimited HEX PDU (e.g. a slice of
+//				  a ring buffer) without copying and without strlen() on the input.
+//***************************************************************************
+int	DecodePduDataN(const uint8_t *pdu, size_t len, PDU_DESC *pdsc, int *pError)
+{
+unsigned char	obuf[SMS_PDU_MAX_LEN];
+uint8_t	sbuf[SMS_GSM7BIT_MAX_LEN + 1];
 
-	pdsc->firstOct |= MSG_TYPE_SMS_SUBMIT;				/* First Octet of SMS_SUBMIT PDU */
-	pdsc->firstOct |= pdsc->vldtPrdFrmt;
+	return	__pdu_decode_hex(pdu, len, pdsc, obuf, sbuf, pError);
+}
 
-	if (pdsc->isConcatenatedMsg)
+//***************************************************************************
+// @NAME        : DecodePduDataBin
+// @PARAM       : pdu - PDU octets
+//				  len - number of octets
+//				  flags - PDU_F_NO_SMSC if the PDU starts with TPDU,
+//				  PDU_F_HDR_ONLY to stop after the UDH
+//				  pdsc - PDU descriptor to be filled
+//				  pError - error code on failure
+// @RETURNS     : TRUE/FALSE
+// @DESCRIPTION : This function decodes a binary (raw octets) PDU in place, no HEX
+//				  conversion and no intermediate copy of the PDU are made. With
+//				  PDU_F_HDR_ONLY the text is not converted, use DecodePduUsrData()
+//				  to get it later.
+//***************************************************************************
+int	DecodePduDataBin(const uint8_t *pdu, size_t len, int flags, PDU_DESC *pdsc, int *pError)
+{
+uint8_t	sbuf[SMS_GSM7BIT_MAX_LEN + 1];
+
+	__pdsc_reset(pdsc);
+
+	if ( len > SMS_PDU_MAX_LEN )
+		return	*pError = ERR_PDU_LENGTH, (FALSE);
+
+	return	__pdu_decode(pdu, (int) len, flags, pdsc, sbuf, pError);
+}
+
+//***************************************************************************
+// @NAME        : DecodePduUsrData
+// @PARAM       : pdu - PDU octets, the same as given to DecodePduDataBin()
+//				  len - number of octets
+//				  flags - PDU_F_NO_SMSC if the PDU starts with TPDU
+//				  pdsc - PDU descriptor, usrData & usrDataLen to be filled
+//				  pError - error code on failure
+// @RETURNS     : TRUE/FALSE
+// @DESCRIPTION : This function materializes the text of the PDU which has been decoded
+//				  with PDU_F_HDR_ONLY, other fields of the descriptor are untouched.
+//				  Only the framing is parsed again, the header is not converted.
+//***************************************************************************
+int	DecodePduUsrData(const uint8_t *pdu, size_t len, int flags, PDU_DESC *pdsc, int *pError)
+{
+PDU_VIEW	view;
+uint8_t	sbuf[SMS_GSM7BIT_MAX_LEN + 1];
+
+	if ( !DecodePduView(pdu, len, flags, &view, pError) )
+		return	FALSE;
+
+	pdsc->usrDataLen = __pdu_ud_text(&view, pdsc->usrData, sizeof(pdsc->usrData), sbuf);
+
+	return	TRUE;
+}
+
+//***************************************************************************
+// @NAME        : DecodePduDataBatch
+// @PARAM       : pdus - array of HEX PDU strings with lengths
+//				  npdus - number of elements in the pdus array
+//				  pdscs - array of npdus PDU descriptors to be filled
+//				  pErrors - array of npdus error codes, ERR_NONE on success
+// @RETURNS     : Number of successfully decoded PDUs
+// @DESCRIPTION : This function decodes a set of PDUs in one call, the binary and
+//				  the septets scratch buffers are shared by all items, input strings
+//				  are not required to be NUL-terminated.
+//***************************************************************************
+int	DecodePduDataBatch(const PDU_INPUT_DESC *pdus, int npdus, PDU_DESC *pdscs, int *pErrors)
+{
+int	i, ndecoded = 0;
+unsigned char	obuf[SMS_PDU_MAX_LEN];
+uint8_t	sbuf[SMS_GSM7BIT_MAX_LEN + 1];
+
+	for (i = 0; i < npdus; i++)
+		{
+		pErrors[i] = ERR_NONE;
+		ndecoded += (__pdu_decode_hex(pdus[i].pdu, pdus[i].len, &pdscs[i], obuf, sbuf, &pErrors[i]) == TRUE);
+		}
+
+	return	ndecoded;
+}
+
+//***************************************************************************
+// @NAME        : DecodePduDataBinBatch
+// @PARAM       : pdus - array of binary PDUs: octets with number of octets
+//				  npdus - number of elements in the pdus array
+//				  flags - PDU_F_* flags for all PDUs, see DecodePduDataBin()
+//				  pdscs - array of npdus PDU descriptors to be filled
+//				  pErrors - array of npdus error codes, ERR_NONE on success
+// @RETURNS     : Number of successfully decoded PDUs
+// @DESCRIPTION : This function decodes a set of binary PDUs in one call as
+//				  DecodePduDataBin() does, the septets scratch buffer is shared
+//				  by all items.
+//***************************************************************************
+int	DecodePduDataBinBatch(const PDU_INPUT_DESC *pdus, int npdus, int flags, PDU_DESC *pdscs, int *pErrors)
+{
+int	i, ndecoded = 0;
+uint8_t	sbuf[SMS_GSM7BIT_MAX_LEN + 1];
+
+	for (i = 0; i < npdus; i++)
 		{
-		pdsc->firstOct |= USER_DATA_HEADER_INDICATION;		/* Indicate that UDH is present */
+		pErrors[i] = ERR_NONE;
+		__pdsc_reset(&pdscs[i]);
 
-		if (pdsc->concateTotalParts == pdsc->concateCurntPart)	/* Is last part to send? */
-			if(pdsc->isDeliveryReq)				/* Indicate that delivery report is require */
-				pdsc->firstOct |= STATUS_REPORT_INDICATOR;
+		if ( pdus[i].len > SMS_PDU_MAX_LEN )
+			pErrors[i] = ERR_PDU_LENGTH;
+		else	ndecoded += (__pdu_decode(pdus[i].pdu, (int) pdus[i].len, flags, &pdscs[i], sbuf, &pErrors[i]) == TRUE);
 		}
-	 else if(pdsc->isDeliveryReq)					/* Set status report indication bit */
-		pdsc->firstOct |= STATUS_REPORT_INDICATOR;		/* Indicate that delivery report is require */
 
-	 obuf[idx++] = pdsc->firstOct;
+	return	ndecoded;
+}
 
-	 obuf[idx++] = MSG_REF_NO_DEFAULT;				/* Allow Mobile to set Message Reference No. */
+//***************************************************************************
+// @NAME        : DecodePduHdr
+// @PARAM       : pdu - HEX PDU string, NUL is not required
+//				  len - length of the HEX string in characters
+//				  hdr - compact header to be filled
+//				  arena - storage for the user data, the text is appended
+//				  pError - error code on failure
+// @RETURNS     : TRUE/FALSE
+// @DESCRIPTION : This function decodes a HEX PDU into the compact header, the user data
+//				  (UTF-8 or 8/16-bit octets, not NUL-terminated) is appended to the
+//				  caller's arena and is referenced by offset/length from the header.
+//***************************************************************************
+int	DecodePduHdr(const uint8_t *pdu, size_t len, PDU_HDR *hdr, PDU_ARENA *arena, int *pError)
+{
+unsigned char	obuf[SMS_PDU_MAX_LEN];
+int	olen;
 
+	if ( (len > SMS_PDU_MAX_LEN * 2) || (len & 1) )				/* Reject over-length or odd input up front */
+		return	*pError = ERR_PDU_LENGTH, (FALSE);
 
-	 obuf[idx++] = pdsc->phoneAddrLen;				/* Phone Number Length */
+	if ( 0 > (olen = __hex2bin(pdu, (int) len, obuf)) )
+		return	*pError = ERR_HEX_DATA, (FALSE);
 
-	 if (pdsc->phoneTypeOfAddr == NUM_TYPE_INTERNATIONAL)		/* Phone Number Type of Address (Eg: 91 , 81) */
+	return	__pdu_decode_hdr(obuf, olen, 0, hdr, arena, pError);
+}
+
+//***************************************************************************
+// @NAME        : DecodePduHdrBin
+// @PARAM       : pdu - PDU octets
+//				  len - number of octets
+//				  flags - PDU_F_NO_SMSC if the PDU starts with TPDU,
+//				  PDU_F_HDR_ONLY to stop after the UDH
+//				  hdr - compact header to be filled
+//				  arena - storage for the user data, the text is appended
+//				  pError - error code on failure
+// @RETURNS     : TRUE/FALSE
+// @DESCRIPTION : This function decodes a binary PDU into the compact header.
+//***************************************************************************
+int	DecodePduHdrBin(const uint8_t *pdu, size_t len, int flags, PDU_HDR *hdr, PDU_ARENA *arena, int *pError)
+{
+	if ( len > SMS_PDU_MAX_LEN )
+		return	*pError = ERR_PDU_LENGTH, (FALSE);
+
+	return	__pdu_decode_hdr(pdu, (int) len, flags, hdr, arena, pError);
+}
+
+//***************************************************************************
+// @NAME        : PduHdrToDesc
+// @PARAM       : hdr - compact header
+//				  arena - storage of the user data
+//				  pdsc - PDU descriptor to be filled
+// @RETURNS     : void
+// @DESCRIPTION : This function expands the compact header and its user data into the
+//				  PDU descriptor as DecodePduData() does, except the list of the UDH
+//				  Information Elements: the compact header does not keep it.
+//***************************************************************************
+void	PduHdrToDesc(const PDU_HDR *hdr, const PDU_ARENA *arena, PDU_DESC *pdsc)
+{
+uint8_t	sbuf[SMS_GSM7BIT_MAX_LEN + 1];
+
+	__pdsc_reset(pdsc);
+	__pdu_hdr2desc(hdr, pdsc, sbuf);
+
+	pdsc->usrDataLen = (hdr->usrDataLen < sizeof(pdsc->usrData)) ? hdr->usrDataLen : sizeof(pdsc->usrData) - 1;
+	memcpy(pdsc->usrData, &arena->buf[hdr->usrDataOff], pdsc->usrDataLen);
+	pdsc->usrData[pdsc->usrDataLen] = '\0';
+}
+
+//***************************************************************************
+// @NAME        : DecodePduView
+// @PARAM       : pdu - PDU octets, are referenced by the view
+//				  len - number of octets
+//				  flags - PDU_F_NO_SMSC if the PDU starts with TPDU
+//				  view - view to be filled
+//				  pError - error code on failure
+// @RETURNS     : TRUE/FALSE
+// @DESCRIPTION : This function checks the PDU framing & records offsets of the TPDU
+//				  elements, nothing is copied or converted. Fields are converted on
+//				  demand by PduView*() accessors or PDU_VIEW_OCTET().
+//***************************************************************************
+int	DecodePduView(const uint8_t *pdu, size_t len, int flags, PDU_VIEW *view, int *pError)
+{
+	if ( len > SMS_PDU_MAX_LEN )
+		return	*pError = ERR_PDU_LENGTH, (FALSE);
+
+	return	__pdu_parse(pdu, (int) len, flags, view, pError);
+}
+
+//***************************************************************************
+// @NAME        : PduViewToDesc
+// @PARAM       : view - PDU view
+//				  pdsc - PDU descriptor to be filled
+//				  pError - error code on failure
+// @RETURNS     : TRUE/FALSE
+// @DESCRIPTION : This function converts all fields of the view as DecodePduData() does.
+//***************************************************************************
+int	PduViewToDesc(const PDU_VIEW *view, PDU_DESC *pdsc, int *pError)
+{
+PDU_HDR	hdr;
+uint8_t	sbuf[SMS_GSM7BIT_MAX_LEN + 1];
+
+	__pdsc_reset(pdsc);
+
+	if ( !__pdu_view2hdr(view, &hdr, pdsc->udhIe, &pdsc->udhIeNum, pError) )
+		return	FALSE;
+
+	__pdu_hdr2desc(&hdr, pdsc, sbuf);
+	pdsc->usrDataLen = __pdu_ud_text(view, pdsc->usrData, sizeof(pdsc->usrData), sbuf);
+
+	return	TRUE;
+}
+
+//***************************************************************************
+// @NAME        : PduViewSmscAddr / PduViewOrigAddr
+// @PARAM       : view - PDU view
+//				  addr - buffer for the address, ADDR_OCTET_MAX_LEN + 1 octets
+// @RETURNS     : Length of the address string
+// @DESCRIPTION : These functions convert the Service Center Number or the Originator
+//				  (Recipient) Number to NUL-terminated string, alphanumeric address
+//				  is converted to UTF-8.
+//***************************************************************************
+int	PduViewSmscAddr(const PDU_VIEW *view, unsigned char *addr)
+{
+int	length;
+
+	if ( (view->sca == PDU_VIEW_NONE) || (view->pdu[view->sca] < 2) )
+		return	addr[0] = '\0', 0;
+
+	length = __bin2hex(&view->pdu[view->sca + 2], view->pdu[view->sca] - 1, addr);
+
+	return	i_DecSemiOctet2Ascii(addr, length, addr);		/* Internal Swapping */
+}
+
+int	PduViewOrigAddr(const PDU_VIEW *view, unsigned char *addr)
+{
+const unsigned char *obuf = view->pdu;
+uint8_t	sbuf[ADDR_OCTET_MAX_LEN + 1];
+int	length, addrLen = (obuf[view->oa] + 1) >> 1;
+
+	if ( ((obuf[view->oa + 1] & 0x70) >> 4) == NUM_TYPE_ALPHANUMERIC )
+		{
+		length = i_Pdu2Text(&obuf[view->oa + 2], addrLen, 0, (obuf[view->oa] * 4) / 7, sbuf);
+
+		return	i_GsmStrToUtf8Str(sbuf, length, addr, ADDR_OCTET_MAX_LEN + 1);
+		}
+
+	length = __bin2hex(&obuf[view->oa + 2], addrLen, addr);
+
+	return	i_DecSemiOctet2Ascii(addr, length, addr);		/* Internal Swapping */
+}
+
+//***************************************************************************
+// @NAME        : PduViewTimeStamp
+// @PARAM       : view - PDU view
+//				  ts - buffer for the TP-SCTS digits, TIME_STAMP_OCTET_MAX_LEN + 1 octets
+// @RETURNS     : Length of the time stamp string
+// @DESCRIPTION : This function converts the Service Center Time Stamp to
+//				  "YYMMDDhhmmsszz" string.
+//***************************************************************************
+int	PduViewTimeStamp(const PDU_VIEW *view, unsigned char *ts)
+{
+	__bin2hex(&view->pdu[view->scts], TIME_STAMP_LEN, ts);
+
+	return	i_DecSemiOctet2Ascii(ts, TIME_STAMP_LEN * 2, ts);	/* Internal Swapping */
+}
+
+//***************************************************************************
+// @NAME        : PduViewUdhIe
+// @PARAM       : view - PDU view
+//				  iei - Information Element Identifier to look for
+//				  ppData - pointer to the IE data in the PDU
+// @RETURNS     : Length of the IE data, -1 if there is no such IE
+// @DESCRIPTION : This function looks up the first Information Element with the
+//				  given identifier in the UDH, nothing is copied.
+//***************************************************************************
+int	PduViewUdhIe(const PDU_VIEW *view, int iei, const uint8_t **ppData)
+{
+const unsigned char *udh;
+int	idx, udhLen;
+
+	if ( view->udh == PDU_VIEW_NONE )
+		return	-1;
+
+	udh = &view->pdu[view->udh + 1];
+	udhLen = udh[-1];
+
+	for (idx = 0; (idx + 2) <= udhLen; idx += 2 + udh[idx + 1])
+		{
+		if ( (idx + 2 + udh[idx + 1]) > udhLen )		/* IE is truncated */
+			break;
+
+		if ( udh[idx] == iei )
+			return	*ppData = &udh[idx + 2], udh[idx + 1];
+		}
+
+	return	-1;
+}
+
+//***************************************************************************
+// @NAME        : PduViewUsrData
+// @PARAM       : view - PDU view
+//				  usrData - buffer for the text
+//				  usrDataSz - size of the buffer including NUL
+// @RETURNS     : Length of the text
+// @DESCRIPTION : This function converts the User Data as DecodePduData() does: GSM 7-bit
+//				  and UCS-2 to UTF-8, 8-bit data is copied as is, the UDH is skipped.
+//***************************************************************************
+int	PduViewUsrData(const PDU_VIEW *view, unsigned char *usrData, int usrDataSz)
+{
+uint8_t	sbuf[SMS_GSM7BIT_MAX_LEN + 1];
+
+	return	__pdu_ud_text(view, usrData, usrDataSz, sbuf);
+}
+
+/*  DESCRIPTION: Build the SMS-SUBMIT PDU up to the TP-UDL: SMSC address block, first octet,
+ *	TP-MR, TP-DA, TP-PID, TP-DCS and TP-VP. The PDU descriptor is not modified.
+ *
+ *   INPUTS:
+ *	pdsc:		PDU descriptor with addresses and flags
+ *	usrDataFormat:	User Data Coding Format for the TP-DCS
+ *	udhi:		User Data Header is present
+ *	srr:		Status Report is requested
+ *
+ *   OUTPUS:
+ *	obuf:		PDU octets
+ *	pTpdu:		offset of the TPDU in the obuf
+ *
+ *   RETURNS:
+ *	number of octets, -1 - address contains non-digit characters
+ */
+static int	__pdu_encode_hdr(const PDU_DESC *pdsc, int usrDataFormat, int udhi, int srr, unsigned char *obuf, int *pTpdu)
+{
+int	idx = 0, addrLen;
+uint8_t	abuf[ADDR_OCTET_MAX_LEN + 2], fo, dcs;
+
+	if (pdsc->smscAddrLen != 0)					/* Check whether Service Centre Present */
+		{
+		obuf[idx++] = 1 + ((pdsc->smscAddrLen + 1) / 2);	/* Adding length of Type of Addr */
+
+		if (pdsc->smscTypeOfAddr == NUM_TYPE_INTERNATIONAL)	/* Service Center Type of Address (Eg: 91 , 81) */
+			obuf[idx++] = 0x91;
+		else if (pdsc->smscTypeOfAddr == NUM_TYPE_NATIONAL)
+			obuf[idx++] = 0xA1;
+		else	obuf[idx++] = 0x81;				/* Unknown */
+
+		addrLen = __strnlen((char *) pdsc->smscAddr, ADDR_OCTET_MAX_LEN);	/* Service Center Number */
+		memcpy(abuf, pdsc->smscAddr, addrLen);
+		abuf[addrLen] = '\0';
+
+		addrLen = i_Ascii2DecSemiOctet(abuf, abuf);
+		if ( 0 > (addrLen = __hex2bin(abuf, addrLen, &obuf[idx])) )
+			return	-1;
+
+		idx = idx + addrLen;
+		}
+	else	obuf[idx++] = 0x00;					/* SMSC stored on phone is used */
+
+	/* So at this point TP-SCA field has been formed , we can fix TPDU area for the future use*/
+	*pTpdu = idx;
+
+	fo = pdsc->firstOct | MSG_TYPE_SMS_SUBMIT | pdsc->vldtPrdFrmt;	/* First Octet of SMS_SUBMIT PDU */
+	fo |= udhi ? USER_DATA_HEADER_INDICATION : 0;			/* Indicate that UDH is present */
+	fo |= srr ? STATUS_REPORT_INDICATOR : 0;			/* Indicate that delivery report is require */
+	obuf[idx++] = fo;
+
+	obuf[idx++] = MSG_REF_NO_DEFAULT;				/* Allow Mobile to set Message Reference No. */
+
+	obuf[idx++] = pdsc->phoneAddrLen;				/* Phone Number Length */
+
+	if (pdsc->phoneTypeOfAddr == NUM_TYPE_INTERNATIONAL)		/* Phone Number Type of Address (Eg: 91 , 81) */
 		obuf[idx++] = 0x91;
-	 else if (pdsc->phoneTypeOfAddr == NUM_TYPE_NATIONAL)
+	else if (pdsc->phoneTypeOfAddr == NUM_TYPE_NATIONAL)
 		obuf[idx++] = 0xA1;
-	 else	obuf[idx++] = 0x81;
+	else	obuf[idx++] = 0x81;
 
+	addrLen = __strnlen((char *) pdsc->phoneAddr, ADDR_OCTET_MAX_LEN);	/* Phone Number (Destination Address) */
+	memcpy(abuf, pdsc->phoneAddr, addrLen);
+	abuf[addrLen] = '\0';
 
-	 i_Ascii2DecSemiOctet(pdsc->phoneAddr, pdsc->phoneAddr);	/* Phone Number (Source Address) */
-	 addrLen = __hex2bin(pdsc->phoneAddr, &obuf[idx]);
-	 idx += addrLen;
+	addrLen = i_Ascii2DecSemiOctet(abuf, abuf);
+	if ( 0 > (addrLen = __hex2bin(abuf, addrLen, &obuf[idx])) )
+		return	-1;
 
-	 obuf[idx++] = 0x00;						/* Protocol Identifier */
+	idx += addrLen;
 
-	 pdsc->dataCodeScheme |= (pdsc->usrDataFormat << 2);		/* Data Coding Scheme */
+	obuf[idx++] = 0x00;						/* Protocol Identifier */
 
+	dcs = pdsc->dataCodeScheme | (usrDataFormat << 2);		/* Data Coding Scheme */
 
-	 if (pdsc->isFlashMsg)						/* Special case considerations WAP-PUSH & Flash Messsage */
-		pdsc->dataCodeScheme |= 0x10;
-	 else if (pdsc->isWapPushMsg)
-		pdsc->dataCodeScheme = 0xF5;
+	if (pdsc->isFlashMsg)						/* Special case considerations WAP-PUSH & Flash Messsage */
+		dcs |= 0x10;
+	else if (pdsc->isWapPushMsg)
+		dcs = 0xF5;
 
-	 obuf[idx++] = pdsc->dataCodeScheme;
+	obuf[idx++] = dcs;
 
-	 switch (pdsc->vldtPrdFrmt)
+	switch (pdsc->vldtPrdFrmt)
 		{
 		case VLDTY_PERIOD_RELATIVE:				/* One octet */
 			obuf[idx++] = pdsc->vldtPrd;
@@ -1402,94 +3493,366 @@ unsigned char  obuf[SMS_PDU_MAX_LEN + 1], *tpdu;
 			break;
 		}
 
-	 pdsc->usrDataLen = pdsc->usrDataLen				/* User Data Length */
-				? pdsc->usrDataLen			/* Has been defined before calling */
-				: __strnlen( (char *) pdsc->usrData, sizeof(pdsc->usrData));
+	return	idx;
+}
 
-	 /* User Data */
+/*  DESCRIPTION: Build the concatenated message IE (8-bit reference number) of the UDH.
+ *
+ *   OUTPUS:
+ *	udh:	UDH octets w/o the UDHL
+ *
+ *   RETURNS:
+ *	length of UDH
+ */
+static inline int __pdu_concat_udh(uint8_t *udh, uint8_t refNo, uint8_t totalParts, uint8_t curntPart)
+{
+	udh[0] = IE_CONCATENATED_MSG;
+	udh[1] = IE_CONCATENATED_MSG_LEN;
+	udh[2] = refNo;
+	udh[3] = totalParts;
+	udh[4] = curntPart;
 
-	 /* Check whether length is sufficient */
-	 if (pdsc->usrDataFormat == GSM_7BIT)
+	return	UDH_CONCATENATED_MSG_LEN;
+}
+
+/*  DESCRIPTION: Build the TP-UDL and the TP-UD: UDH (if any) and the user data. GSM 7-bit user data
+ *	is packed right after the UDH starting with fill bits.
+ *
+ *   INPUTS:
+ *	ud:		septets (GSM_7BIT) or octets
+ *	udLen:		number of septets or octets, must fit into one message
+ *	usrDataFormat:	User Data Coding Format
+ *	udh:		UDH octets w/o the UDHL
+ *	udhLen:		length of UDH, 0 - no UDH
+ *	obufSz:		size of the obuf
+ *
+ *   OUTPUS:
+ *	obuf:		PDU octets
+ *
+ *   RETURNS:
+ *	number of octets
+ */
+static int	__pdu_encode_ud(const uint8_t *ud, int udLen, int usrDataFormat, const uint8_t *udh, int udhLen,
+		unsigned char *obuf, int obufSz)
+{
+int	idx = 0, udhSeptet = 0;
+
+	if (usrDataFormat == GSM_7BIT)
+		{
+		/* Derive User Data Length in septets, the UDH is padded to the septet boundary */
+		udhSeptet = udhLen ? (((1 + udhLen) * 8) + 6) / 7 : 0;
+		obuf[idx++] = udLen + udhSeptet;			/* TP-UDL */
+		}
+	else	obuf[idx++] = udLen + (udhLen ? 1 + udhLen : 0);	/* TP-UDL */
+
+	if ( udhLen )
 		{
-		gsmLen = strlen( (char *) pdsc->usrData);		/* for GSM_7bit data */
-		tidx = idx;
-		obuf[idx++] = gsmLen;					/* TP-UDL */
+		obuf[idx++] = udhLen;
+		memcpy(&obuf[idx], udh, udhLen);
+		idx += udhLen;
+		}
 
-		if (gsmLen > SMS_GSM7BIT_MAX_LEN)
-			gsmLen = TRUNCATED_GSM_DATA_LEN;
+	if (usrDataFormat == GSM_7BIT)					/* Copy 7bit text to buffer */
+		idx += i_Text2Pdu(ud, udLen, udhLen ? udhSeptet * 7 - (1 + udhLen) * 8 : 0, &obuf[idx], obufSz - idx);
+	else	{							/* Copy 8/16bit text to buffer */
+		memcpy(&obuf[idx], ud, udLen);
+		idx += udLen;
 		}
-	 else // for 8bit & 16bit Data
+
+	return	idx;
+}
+
+//***********************************************************************************************
+// @NAME        : EncodePduData
+// @PARAM       : pGsmPduStr-Reference To PDU String
+//				  gsmPduStrLen-Length of PDU String,
+//				  PDU_ENCODE_DESC-Object Pointer
+// @RETURNS     : Length of PDU String, 0 on error
+// @DESCRIPTION : This function extracts PDU data from Descriptor & Prepares PDU String
+//				  if fails then return FALSE. GSM 7-bit and UCS-2 user data is UTF-8
+//				  text, 8-bit user data is copied as is. The text is truncated to fit
+//				  into one message: 160/153 septets or 70/67 UCS-2 units, a surrogate
+//				  pair is never split; see EncodePduDataLong() for the long messages.
+//				  0 is returned if the HEX string with NUL doesn't fit into pdusz octets.
+//***********************************************************************************************
+int	EncodePduData(PDU_DESC *pdsc, unsigned char *pdu, int pdusz, int *tpdulen)
+{
+int	idx, tidx, udLen, udhLen = 0, usrDataLen, srr;
+unsigned char  obuf[SMS_PDU_MAX_LEN + 1];
+uint8_t	gbuf[SMS_GSM7BIT_MAX_LEN], udh[UDH_CONCATENATED_MSG_LEN];	/* Septets or UCS-2, UDH */
+const uint8_t *ud;
+
+	*tpdulen = 0;
+
+	srr = pdsc->isDeliveryReq;					/* Delivery report is requested on the last part only */
+	if (pdsc->isConcatenatedMsg && (pdsc->concateTotalParts != pdsc->concateCurntPart))
+		srr = FALSE;
+
+	if ( 0 > (idx = __pdu_encode_hdr(pdsc, pdsc->usrDataFormat, pdsc->isConcatenatedMsg, srr, obuf, &tidx)) )
+		return	0;
+
+	usrDataLen = pdsc->usrDataLen					/* User Data Length */
+			? pdsc->usrDataLen				/* Has been defined before calling */
+			: __strnlen( (char *) pdsc->usrData, sizeof(pdsc->usrData));
+
+	if (pdsc->isConcatenatedMsg) // Check for Concatenated Message
+		udhLen = __pdu_concat_udh(udh, pdsc->concateMsgRefNo, pdsc->concateTotalParts, pdsc->concateCurntPart);
+
+	if (pdsc->usrDataFormat == GSM_7BIT)
 		{
-		obuf[idx++] = pdsc->usrDataLen;				/* TP-UDL */
+		/* Convert UTF-8 to septets, the text is truncated to fit into one message */
+		udLen = i_Utf8StrToGsmStr(pdsc->usrData, usrDataLen, gbuf,
+				udhLen ? TRUNCATED_GSM_DATA_LEN : SMS_GSM7BIT_MAX_LEN, NULL);
+		ud = gbuf;
+		}
+	else if (pdsc->usrDataFormat == UCS2_16BIT)
+		{
+		/* Convert UTF-8 to UCS-2, the text is truncated to fit into one message */
+		udLen = i_Utf8StrToUcs2Str(pdsc->usrData, usrDataLen, gbuf,
+				udhLen ? TRUNCATED_PDU_DATA_LEN : SMS_PDU_USER_DATA_MAX_LEN);
+		ud = gbuf;
+		}
+	else	{							/* for 8bit Data */
+		udLen = udhLen ? TRUNCATED_PDU_DATA_LEN : SMS_PDU_USER_DATA_MAX_LEN;
+		udLen = (usrDataLen > udLen) ? udLen : usrDataLen;
+		ud = pdsc->usrData;
+		}
+
+	idx += __pdu_encode_ud(ud, udLen, pdsc->usrDataFormat, udh, udhLen, &obuf[idx], sizeof(obuf) - idx);
+
+	if ( (2 * idx + 1) > pdusz )					/* HEX string & NUL don't fit */
+		return	0;
+
+	*tpdulen = idx - tidx;						/* Calculate TDPU length */
 
-		if (pdsc->usrDataLen > SMS_PDU_USER_DATA_MAX_LEN)
-				pdsc->usrDataLen = TRUNCATED_PDU_DATA_LEN;
+	return	__bin2hex(obuf, idx, pdu);			/* Convert PDU buffer into the text HEX string,
+									** return a result length */
+}
+
+/*  DESCRIPTION: Add a character to the part being filled: a part which can't hold the
+ *	character is closed, so escape sequences & surrogate pairs are never split.
+ *
+ *   INPUTS:
+ *	w:	width of the character: septets or octets
+ *	per:	room of a part
+ *	n:	number of characters of the width, all are added
+ *
+ *   OUTPUS:
+ *	pParts:	number of parts
+ *	pFill:	units in the last part
+ */
+static inline void	__pdu_part_fill(int w, int per, int n, int *pParts, int *pFill)
+{
+int	k, room;
+
+	if ( (w == 1) || (per % w == 0) )				/* Parts are filled completely */
+		{
+		*pFill += n * w;
+
+		if ( *pFill > per )
+			{
+			k = (*pFill - 1) / per;
+			*pParts += k;
+			*pFill -= k * per;
+			}
+
+		return;
+		}
+
+	for ( ; n; n--)
+		{
+		room = per - *pFill;
+		*pParts += (w > room);
+		*pFill = ((w > room) ? 0 : *pFill) + w;
 		}
+}
 
-	 /*****************************************************************************
-	 * Below section of code process user data header information
-	 *****************************************************************************/
+/*  DESCRIPTION: Scan the UTF-8 text once: GSM 7-bit septets and UCS-2 octets are counted
+ *	together with the parts of both, the scan of GSM 7-bit stops at the first character
+ *	which is not in the alphabet. ASCII runs are counted in bulk by the run kernel.
+ *
+ *   INPUTS:
+ *	text:		UTF-8 text
+ *	textLen:	length of the text in octets
+ *
+ *   OUTPUS:
+ *	est:		charset, length and number of parts as EncodePduDataLong() makes
+ */
+static void	__pdu_text_scan(const uint8_t *text, int textLen, PDU_TEXT_EST_DESC *est)
+{
+int	idx = 0, run, gsm = TRUE, septets = 0, octets = 0;
+int	gsmParts = 1, gsmFill = 0, ucsParts = 1, ucsFill = 0;
+uint32_t	cp;
+uint8_t	sept;
 
-	 if (pdsc->isConcatenatedMsg) // Check for Concatenated Message
+	while ( idx < textLen )
 		{
-		 if (pdsc->usrDataFormat == GSM_7BIT)
+		if ( __GSM7_IS_ASCII(text[idx]) )
 			{
-			uint8_t fillBitsNum = 0;
-			uint8_t udhSeptet = 0;
-
-			/* Derive number of octet to be filled */
-			fillBitsNum = ((1 + UDH_CONCATENATED_MSG_LEN) * 8) % 7;
-			fillBitsNum = 7 - fillBitsNum;
-
-			/* Derive User Data Length in septets */
-			udhSeptet = (((1 + UDH_CONCATENATED_MSG_LEN) * 8) + fillBitsNum) / 7;
-			obuf[tidx] = gsmLen + udhSeptet; // Updating TP-UDL
-			tidx = idx;
-
-			obuf[idx++] = UDH_CONCATENATED_MSG_LEN;
-			obuf[idx++] = IE_CONCATENATED_MSG;
-			obuf[idx++] = IE_CONCATENATED_MSG_LEN;
-			obuf[idx++] = pdsc->concateMsgRefNo;
-			obuf[idx++] = pdsc->concateTotalParts;
-			obuf[idx++] = pdsc->concateCurntPart;
-
-			/* Copy 7bit text to buffer */
-			i_Utf8StrToGsmStr(pdsc->usrData, gsmLen, pdsc->usrData, &gsmLen);
-			tidx = tidx + udhSeptet;  // for septet boundary of user data header
-			i_Text2Pdu(pdsc->usrData, gsmLen + udhSeptet, &obuf[tidx]);
+			run = __PDU_KERN(__gsm7_ascii_run_kern)(&text[idx], textLen - idx);
+			idx += run;
+
+			if ( gsm )
+				{
+				septets += run;
+				__pdu_part_fill(1, TRUNCATED_GSM_DATA_LEN, run, &gsmParts, &gsmFill);
+				}
+
+			octets += run * 2;
+			__pdu_part_fill(2, TRUNCATED_PDU_DATA_LEN, run, &ucsParts, &ucsFill);
+			continue;
 			}
-		else	{
-			obuf[idx++] = UDH_CONCATENATED_MSG_LEN;
-			obuf[idx++] = IE_CONCATENATED_MSG;
-			obuf[idx++] = IE_CONCATENATED_MSG_LEN;
-			obuf[idx++] = pdsc->concateMsgRefNo;
-			obuf[idx++] = pdsc->concateTotalParts;
-			obuf[idx++] = pdsc->concateCurntPart;
-
-			/* Copy 8/16bit text to buffer */
-			memcpy(&obuf[idx], pdsc->usrData, pdsc->usrDataLen);
-			obuf[idx += pdsc->usrDataLen] = '\0';
+
+		idx += __utf8_cp(&text[idx], textLen - idx, &cp);
+
+		if ( gsm && (GSM7_NONE == (sept = __gsm7_lookup(cp))) )
+			gsm = FALSE;						/* Lossy, UCS-2 only from now on */
+		else if ( gsm )
+			{
+			septets += (sept & GSM7_ESC) ? 2 : 1;
+			__pdu_part_fill((sept & GSM7_ESC) ? 2 : 1, TRUNCATED_GSM_DATA_LEN, 1, &gsmParts, &gsmFill);
 			}
+
+		octets += (cp > 0xFFFF) ? 4 : 2;
+		__pdu_part_fill((cp > 0xFFFF) ? 4 : 2, TRUNCATED_PDU_DATA_LEN, 1, &ucsParts, &ucsFill);
+		}
+
+	if ( gsm )
+		{
+		est->usrDataFormat = GSM_7BIT;
+		est->udLen = septets;
+		est->nparts = (septets > SMS_GSM7BIT_MAX_LEN) ? gsmParts : 1;
 		}
 	else	{
-		if (pdsc->usrDataFormat == GSM_7BIT)
+		est->usrDataFormat = UCS2_16BIT;
+		est->udLen = octets;
+		est->nparts = (octets > SMS_PDU_USER_DATA_MAX_LEN) ? ucsParts : 1;
+		}
+}
+
+//***********************************************************************************************
+// @NAME        : PduTextEstimate
+// @PARAM       : text - UTF-8 text of arbitrary length
+//				  textLen - length of the text in octets
+//				  est - estimate to be filled
+// @RETURNS     : Number of parts
+// @DESCRIPTION : This function tells how EncodePduDataLong() would encode the text w/o
+//				  encoding it: GSM 7-bit if all characters are in the GSM 7-bit alphabet
+//				  (escape sequences count as 2 septets), UCS-2 otherwise, the length of
+//				  the user data and the number of parts. The text is scanned once, a text
+//				  longer than EncodePduDataLong() accepts is scanned up to the limit.
+//***********************************************************************************************
+int	PduTextEstimate(const unsigned char *text, size_t textLen, PDU_TEXT_EST_DESC *est)
+{
+	if ( textLen > (MAX_CONCAT_PARTS * SMS_GSM7BIT_MAX_LEN * UTF8_CHAR_LEN) )	/* Is refused by the encoder anyway */
+		textLen = MAX_CONCAT_PARTS * SMS_GSM7BIT_MAX_LEN * UTF8_CHAR_LEN + 1;
+
+	__pdu_text_scan(text, (int) textLen, est);
+
+	return	est->nparts;
+}
+
+//***********************************************************************************************
+// @NAME        : EncodePduDataLong
+// @PARAM       : pdsc - PDU descriptor with addresses, flags and concateMsgRefNo,
+//				  usrData field is not used
+//				  text - UTF-8 text of arbitrary length
+//				  textLen - length of the text in octets
+//				  pdus - buffer for NUL-terminated HEX PDU strings of all parts
+//				  pdusSz - size of the pdus buffer
+//				  parts - array of part descriptors
+//				  maxParts - number of elements in the parts array
+//				  pError - error code
+// @RETURNS     : Number of parts, 0 on error
+// @DESCRIPTION : This function converts the text once, GSM 7-bit is used if all characters
+//				  are in the GSM 7-bit alphabet, UCS-2 otherwise (see PduTextEstimate()). Boundaries of parts
+//				  are computed from the converted text in one pass, an escape sequence
+//				  or a surrogate pair is never split. A text which fits into one
+//				  message is encoded without UDH.
+//***********************************************************************************************
+int	EncodePduDataLong(const PDU_DESC *pdsc, const unsigned char *text, size_t textLen,
+		unsigned char *pdus, size_t pdusSz, PDU_PART_DESC *parts, int maxParts, int *pError)
+{
+int	fmt, ulen, single, per, nparts, off, cut, i, idx, tidx, udhLen = 0, srr;
+int	cuts[MAX_CONCAT_PARTS + 1];					/* Boundaries of parts in the ubuf */
+uint8_t	*ubuf, udh[UDH_CONCATENATED_MSG_LEN];
+unsigned char  obuf[SMS_PDU_MAX_LEN + 1];
+size_t	pos;
+PDU_TEXT_EST_DESC	est;
+
+	*pError = ERR_NONE;
+
+	if ( textLen > (MAX_CONCAT_PARTS * SMS_GSM7BIT_MAX_LEN * UTF8_CHAR_LEN) )
+		return	*pError = ERR_PDU_LENGTH, 0;
+
+	if ( !(ubuf = malloc(2 * textLen + 1)) )			/* Enough for septets and for UCS-2 */
+		return	*pError = ERR_NO_MEMORY, 0;
+
+	/* Select the charset by one scan, UCS-2 if GSM 7-bit is lossy, convert the text once */
+	__pdu_text_scan(text, (int) textLen, &est);
+	fmt = est.usrDataFormat;
+
+	if ( fmt == GSM_7BIT )
+		{
+		ulen = i_Utf8StrToGsmStr(text, textLen, ubuf, 2 * textLen, NULL);
+		single = SMS_GSM7BIT_MAX_LEN;
+		per = TRUNCATED_GSM_DATA_LEN;
+		}
+	else	{
+		ulen = i_Utf8StrToUcs2Str(text, textLen, ubuf, 2 * textLen);
+		single = SMS_PDU_USER_DATA_MAX_LEN;
+		per = TRUNCATED_PDU_DATA_LEN;
+		}
+
+	/* Split into parts, don't break an escape sequence or a surrogate pair */
+	cuts[0] = 0;
+	nparts = 1;
+
+	if ( ulen > single )
+		for (nparts = off = 0; off < ulen; off = cut)
 			{
-			/* Copy 7bit text to buffer */
-			i_Utf8StrToGsmStr(pdsc->usrData, gsmLen, pdsc->usrData, &gsmLen);
-			idx += i_Text2Pdu(pdsc->usrData, gsmLen, &obuf[idx]);
-			}
-		else	{
-			/* Copy 8/16bit text to buffer */
-			memcpy(&obuf[idx], pdsc->usrData, pdsc->usrDataLen);
-			obuf[idx += pdsc->usrDataLen] = '\0';
+			if ( nparts == MAX_CONCAT_PARTS )
+				return	free(ubuf), *pError = ERR_PDU_LENGTH, 0;
+
+			if ( (cut = off + per) >= ulen )
+				cut = ulen;
+			else if ( fmt == GSM_7BIT )
+				cut -= (ubuf[cut - 1] == ESC_CHR);
+			else	cut -= ((ubuf[cut - 2] & 0xFC) == 0xD8) ? 2 : 0;	/* High surrogate */
+
+			cuts[nparts++] = off;
 			}
-		}
 
+	cuts[nparts] = ulen;
 
-	*tpdulen = &obuf[idx] - tpdu;					/* Calculate TDPU length */
+	if ( nparts > maxParts )
+		return	free(ubuf), *pError = ERR_PDU_LENGTH, 0;
 
-	return	__bin2hex(obuf, idx, pdu);			/* Convert PDU buffer into the text HEX string,
-									** return a result length */
+	for (i = 0, pos = 0; i < nparts; i++)
+		{
+		srr = pdsc->isDeliveryReq && (i == (nparts - 1));	/* Delivery report is requested on the last part only */
+
+		if ( 0 > (idx = __pdu_encode_hdr(pdsc, fmt, nparts > 1, srr, obuf, &tidx)) )
+			return	free(ubuf), *pError = ERR_CHAR_SET, 0;
+
+		if ( nparts > 1 )
+			udhLen = __pdu_concat_udh(udh, pdsc->concateMsgRefNo, nparts, i + 1);
+
+		idx += __pdu_encode_ud(&ubuf[cuts[i]], cuts[i + 1] - cuts[i], fmt, udh, udhLen, &obuf[idx], sizeof(obuf) - idx);
+
+		if ( (pos + idx * 2 + 1) > pdusSz )
+			return	free(ubuf), *pError = ERR_PDU_LENGTH, 0;
+
+		parts[i].off = pos;
+		parts[i].len = __bin2hex(obuf, idx, &pdus[pos]);
+		parts[i].tpdulen = idx - tidx;
+		parts[i].usrDataFormat = fmt;
+		pos += parts[i].len + 1;
+		}
+
+	free(ubuf);
+
+	return	nparts;
 }
 
 //***************************************************************************
@@ -16,6 +16,22 @@
  *
  *	24-MAY-2021	RRL	Removed <id> field, partialy replace non-C types with standard ones.
  *
+ *	17-OCT-2026	AG	Added DecodePduDataBatch() and the PDU_INPUT_DESC input descriptor.
+ *				Added ERR_HEX_DATA error code.
+ *				Added DecodePduDataN() and ERR_PDU_LENGTH error code.
+ *				Added DecodePduDataBin() and PDU_F_NO_SMSC flag.
+ *				<usrDataLen> is uint16_t now.
+ *				Added ERR_CONCAT_PART, ERR_NO_MEMORY error codes for the reassembly API.
+ *				Added EncodePduDataLong() and the PDU_PART_DESC part descriptor.
+ *				Added compact PDU_HDR with user data in PDU_ARENA, DecodePduHdr(),
+ *				DecodePduHdrBin(), PduHdrToDesc().
+ *				Added PDU_VIEW zero-copy view, DecodePduView() and PduView*() accessors.
+ *				Added PDU_F_HDR_ONLY flag and DecodePduUsrData().
+ *				Added PDU_UDH_IE_DESC list of the UDH Information Elements and ERR_UDH error code.
+ *				<usrData> of UCS2_16BIT messages is UTF-8 text now, in both directions.
+ *				Added PduTextEstimate() and the PDU_TEXT_EST_DESC estimate descriptor.
+ *				Added DecodePduDataBinBatch().
+ *
  *
  */
 #ifndef PDU_H
@@ -26,6 +42,7 @@
 // @INCLUDE
 //###########################################################################
 #include <stdint.h>
+#include <stddef.h>
 
 //###########################################################################
 // @DEFINES
@@ -40,7 +57,7 @@
 #define UTF8_CHAR_LEN				4	 /* 4 bytes */
 #define GSM_7BIT				0x00
 #define ANSI_8BIT				0x01	// TODO
-#define UCS2_16BIT				0x02	// TODO
+#define UCS2_16BIT				0x02
 #define USER_DATA_HEADER_INDICATION		0x40
 #define STATUS_REPORT_INDICATOR			0x20
 #define MSG_REF_NO_DEFAULT			0x00
@@ -50,6 +67,18 @@
 #define TRUE					 1
 #define FALSE					 0
 #define LONG_SMS_TEXT_MAX_LEN			700
+#define MAX_CONCAT_PARTS			255	/* Concatenated message parts limit */
+#define PDU_UDH_IE_MAX				8	/* Information Elements kept in the PDU_DESC */
+
+/* Decoder flags */
+#define PDU_F_NO_SMSC				0x01	/* Binary PDU starts with TPDU, no SMSC address block */
+#define PDU_F_HDR_ONLY				0x02	/* Stop after the UDH, User Data is not converted */
+
+/* PDU_HDR flags */
+#define PDU_HDR_F_UDH				0x01	/* User Data Header is present */
+#define PDU_HDR_F_CONCAT			0x02	/* Part of concatenated message */
+#define PDU_HDR_F_FLASH				0x04	/* FLASH SMS */
+#define PDU_HDR_F_WAP_PUSH			0x08	/* WAP-PUSH SMS */
 
 //###########################################################################
 // @ENUMERATOR
@@ -57,12 +86,18 @@
 /* Error Values */
 enum
 {
+	ERR_NONE = -1,							/* No error, used by the batch API */
 	ERR_MSG_TYPE = 0,
 	ERR_CHAR_SET = 1,
 	ERR_PHONE_TYPE_OF_ADDR = 2,
 	ERR_PHONE_NUM_PLAN = 3,
 	ERR_PROTOCOL_ID = 4,
-	ERR_DATA_CODE_SCHEME
+	ERR_DATA_CODE_SCHEME,
+	ERR_HEX_DATA,							/* Non-HEX character in the PDU string */
+	ERR_PDU_LENGTH,							/* PDU or a PDU field is truncated/over-length */
+	ERR_CONCAT_PART,						/* Invalid concatenated message part number(s) */
+	ERR_NO_MEMORY,							/* Memory allocation failed */
+	ERR_UDH								/* Malformed User Data Header */
 };
 
 /* Message Type indication */
@@ -115,6 +150,14 @@ enum
 //###########################################################################
 // @DATATYPE
 //###########################################################################
+/* Information Element of the User Data Header */
+typedef struct
+{
+	uint8_t	type;							/* Information Element Identifier */
+	uint8_t	off;							/* Offset of the IE data from the UDHL octet */
+	uint8_t	len;							/* Length of the IE data */
+} PDU_UDH_IE_DESC;
+
 typedef struct
 {
 	uint8_t day;
@@ -165,12 +208,14 @@ typedef struct
 	uint8_t vldtPrd;						/* Validity Period */
 	uint8_t vldtPrdFrmt;						/* Validity Period Format */
 
-	unsigned char	usrDataLen,					/* User Data Length */
-		usrData[SMS_GSM7BIT_MAX_LEN * UTF8_CHAR_LEN + 1];	/* User Data for GSM_7bit, ANSI_8bit & UCS2_16bit*/
+	uint16_t	usrDataLen;					/* User Data Length, UTF-8 text may exceed 255 octets */
+	unsigned char	usrData[SMS_GSM7BIT_MAX_LEN * UTF8_CHAR_LEN + 1];	/* UTF-8 text for GSM_7bit & UCS2_16bit, raw ANSI_8bit */
 
 	uint8_t udhLen;							/* User Data Header Length */
 	uint8_t udhInfoType;						/* Type of User Data Header */
 	uint8_t udhInfoLen;						/* User Data Header information length */
+	uint8_t udhIeNum;						/* Number of Information Elements in udhIe[] */
+	PDU_UDH_IE_DESC	udhIe[PDU_UDH_IE_MAX];				/* Information Elements in order, the rest are checked only */
 	uint8_t concateMsgRefNo; 					/* Concatenated Message Reference Number */
 	uint8_t concateTotalParts;					/* Maximum Number of concatenated messages */
 	uint8_t concateCurntPart;					/* Sequence Number of concatenated messages */
@@ -187,11 +232,117 @@ typedef struct
 	unsigned char	tz;						/* Timezone */
 } PDU_DESC;
 
+/* Input item for the batch decoder */
+typedef struct
+{
+	const unsigned char	*pdu;					/* HEX PDU string, NUL is not required, or octets */
+	size_t	len;							/* Length of the HEX string in characters or octets */
+} PDU_INPUT_DESC;
+
+/* Compact decoded header: numeric fields in one cache line, addresses and time stamps are
+ * kept as on the wire (semi-octets), user data is referenced by offset/length in the PDU_ARENA
+ */
+typedef struct
+{
+	uint32_t	usrDataOff;					/* Offset of User Data in the arena */
+	uint16_t	usrDataLen;					/* Length of User Data in the arena */
+	uint16_t	srcPortAddr, destPortAddr;			/* Port Addresses */
+
+	uint8_t	msgType, firstOct, msgRefNo;
+	uint8_t	protocolId, dataCodeScheme, usrDataFormat;
+	uint8_t	flags;							/* PDU_HDR_F_* */
+	uint8_t	smsSts;							/* Status of SMS (STATUS-REPORT) */
+
+	uint8_t	smscTypeOfAddr, smscAddrLen;				/* Length in octets */
+	uint8_t	phoneTypeOfAddr, phoneAddrLen;				/* Length in semi-octets (TP-OA) */
+
+	uint8_t	udhLen, udhInfoType, udhInfoLen;
+	uint8_t	concateMsgRefNo, concateTotalParts, concateCurntPart;
+
+	uint8_t	smscAddr[ADDR_OCTET_MAX_LEN / 2];			/* Service Center Number, semi-octets */
+	uint8_t	phoneAddr[ADDR_OCTET_MAX_LEN / 2];			/* Phone Number, semi-octets or packed septets */
+	uint8_t	timeStamp[TIME_STAMP_OCTET_MAX_LEN / 2];		/* TP-SCTS */
+	uint8_t	dischrgTimeStamp[TIME_STAMP_OCTET_MAX_LEN / 2];		/* TP-DT */
+} PDU_HDR;
+
+/* Zero-copy view of a binary PDU: offsets of the TPDU elements in the caller's octets,
+ * PDU_VIEW_NONE if an element is absent; the octets are referenced and must outlive the view
+ */
+typedef struct
+{
+	const unsigned char	*pdu;					/* PDU octets */
+	uint8_t	len;							/* Number of octets */
+
+	uint8_t	msgType, usrDataFormat;
+	uint8_t	flags;							/* PDU_HDR_F_* except PDU_HDR_F_CONCAT */
+
+	uint8_t	sca;							/* SMSC address length octet, TOA and number follow */
+	uint8_t	fo, mr;							/* First octet, TP-MR */
+	uint8_t	oa;							/* TP-OA/TP-RA length octet, TOA and number follow */
+	uint8_t	pid, dcs;						/* TP-PID, TP-DCS */
+	uint8_t	scts, dt, st;						/* TP-SCTS, TP-DT, TP-ST */
+	uint8_t	udl;							/* TP-UDL, TP-UD follows */
+	uint8_t	udh;							/* UDHL octet, IEs follow */
+
+	uint8_t	udOctets;						/* Octets of the TP-UD */
+	uint8_t	udSkip;							/* UDH: septets incl. fill bits (GSM 7-bit) or octets */
+	uint8_t	udCount;						/* Text: septets (GSM 7-bit) or octets */
+} PDU_VIEW;
+
+#define PDU_VIEW_NONE				0xFF	/* Element is absent, PDU is never so long */
+#define PDU_VIEW_OCTET(v, elem)			( ((v)->elem == PDU_VIEW_NONE) ? 0 : (v)->pdu[(v)->elem] )
+
+/* Caller-supplied storage for user data of the PDU_HDR */
+typedef struct
+{
+	unsigned char	*buf;						/* Storage */
+	size_t	size;							/* Size of the storage */
+	size_t	used;							/* Octets in use, new text is appended here */
+} PDU_ARENA;
+
+/* Part of the long message produced by EncodePduDataLong() */
+typedef struct
+{
+	size_t	off;							/* Offset of the HEX PDU string in the output buffer */
+	int	len;							/* Length of the HEX PDU string w/o NUL */
+	int	tpdulen;						/* Length of the TPDU in octets, for AT+CMGS */
+	uint8_t	usrDataFormat;						/* GSM_7BIT or UCS2_16BIT */
+} PDU_PART_DESC;
+
+/* Estimate of the outbound text made by PduTextEstimate(), as EncodePduDataLong() would encode it */
+typedef struct
+{
+	uint8_t	usrDataFormat;						/* GSM_7BIT or UCS2_16BIT */
+	int	udLen;							/* Septets (GSM 7-bit, escapes are 2) or UCS-2 octets */
+	int	nparts;							/* Number of parts, may exceed MAX_CONCAT_PARTS */
+} PDU_TEXT_EST_DESC;
+
 //###########################################################################
 // @PROTOTYPE
 //###########################################################################
 int	DecodePduData	(unsigned char *pdu, PDU_DESC *pdsc, int *pError);
+int	DecodePduDataN	(const uint8_t *pdu, size_t len, PDU_DESC *pdsc, int *pError);
+int	DecodePduDataBin(const uint8_t *pdu, size_t len, int flags, PDU_DESC *pdsc, int *pError);
+int	DecodePduUsrData(const uint8_t *pdu, size_t len, int flags, PDU_DESC *pdsc, int *pError);
 int	EncodePduData	(PDU_DESC *pdsc, unsigned char *pdu, int pdusz, int *tpdulen);
+int	EncodePduDataLong(const PDU_DESC *pdsc, const unsigned char *text, size_t textLen,
+		unsigned char *pdus, size_t pdusSz, PDU_PART_DESC *parts, int maxParts, int *pError);
+int	PduTextEstimate	(const unsigned char *text, size_t textLen, PDU_TEXT_EST_DESC *est);
+
+int	DecodePduDataBatch	(const PDU_INPUT_DESC *pdus, int npdus, PDU_DESC *pdscs, int *pErrors);
+int	DecodePduDataBinBatch	(const PDU_INPUT_DESC *pdus, int npdus, int flags, PDU_DESC *pdscs, int *pErrors);
+
+int	DecodePduHdr	(const uint8_t *pdu, size_t len, PDU_HDR *hdr, PDU_ARENA *arena, int *pError);
+int	DecodePduHdrBin	(const uint8_t *pdu, size_t len, int flags, PDU_HDR *hdr, PDU_ARENA *arena, int *pError);
+void	PduHdrToDesc	(const PDU_HDR *hdr, const PDU_ARENA *arena, PDU_DESC *pdsc);
+
+int	DecodePduView	(const uint8_t *pdu, size_t len, int flags, PDU_VIEW *view, int *pError);
+int	PduViewToDesc	(const PDU_VIEW *view, PDU_DESC *pdsc, int *pError);
+int	PduViewSmscAddr	(const PDU_VIEW *view, unsigned char *addr);
+int	PduViewOrigAddr	(const PDU_VIEW *view, unsigned char *addr);
+int	PduViewTimeStamp(const PDU_VIEW *view, unsigned char *ts);
+int	PduViewUdhIe	(const PDU_VIEW *view, int iei, const uint8_t **ppData);
+int	PduViewUsrData	(const PDU_VIEW *view, unsigned char *usrData, int usrDataSz);
 
 void	print_decoded_pdu(PDU_DESC *pPduDecodeDesc);
 
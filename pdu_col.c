@@ -0,0 +1,382 @@
+/*
+ *   DESCRIPTION:	Columnar writer of decoded PDUs
+ *
+ *   ABSTRACT:	Every column has a growable buffer with the on-disk representation of its
+ *		values, BLOB columns have an additional buffer of end offsets. Buffers are
+ *		written as is by PduColFlush() and are reused for the next block, so in the
+ *		steady state no memory allocation is made per row.
+ *
+ *   AUTHOR: AG
+ *
+ *   CREATION DATE: 17-OCT-2026
+ *
+ *   USAGE:	See pdu_col.h
+ *
+ *   MODIFICATION HISTORY:
+ *
+ *
+ */
+
+
+//###########################################################################
+// @INCLUDES
+//###########################################################################
+#include	<stdlib.h>
+#include	<string.h>
+
+#include	"pdu_col.h"
+
+//###########################################################################
+// @DEFINES
+//###########################################################################
+#define	COL_SRC_STR				0xFFFF	/* <lenOff>: NUL-terminated string */
+#define	COL_SRC_UDH_IE				0xFFFE	/* <lenOff>: <udhIe> of <udhIeNum> elements */
+
+//###########################################################################
+// @DATATYPE
+//###########################################################################
+/* Column definition */
+typedef struct
+{
+	uint8_t	id, type;
+	const char	*name;
+	uint16_t	off;						/* Offset of the field in the PDU_DESC */
+	uint16_t	lenOff;						/* BLOB: offset of the uint16_t length field or COL_SRC_* */
+} COL_DEF_DESC;
+
+/* <udhIe> is stored as is: {type, off, len} octets */
+typedef char	__col_udh_ie_size_check[(sizeof(PDU_UDH_IE_DESC) == 3) ? 1 : -1];
+
+/* Growable buffer */
+typedef struct
+{
+	unsigned char	*buf;
+	size_t	len, sz;
+} COL_BUF_DESC;
+
+struct __pdu_col
+{
+	int	nrows;
+	COL_BUF_DESC	data[PDU_COL_MAX];				/* Values of columns */
+	COL_BUF_DESC	offs[PDU_COL_MAX];				/* End offsets of BLOB values */
+};
+
+#define	COL_U8(id, name, fld)		{id, PDU_COL_U8, name, offsetof(PDU_DESC, fld), 0}
+#define	COL_U16(id, name, fld)		{id, PDU_COL_U16, name, offsetof(PDU_DESC, fld), 0}
+#define	COL_STR(id, name, fld)		{id, PDU_COL_BLOB, name, offsetof(PDU_DESC, fld), COL_SRC_STR}
+
+static const COL_DEF_DESC	__pdu_col_defs[PDU_COL_MAX] = {
+	COL_STR(PDU_COL_SMSC_ADDR, "smscAddr", smscAddr),
+	COL_U8(PDU_COL_SMSC_TYPE_OF_ADDR, "smscTypeOfAddr", smscTypeOfAddr),
+	COL_U8(PDU_COL_FIRST_OCT, "firstOct", firstOct),
+	COL_U8(PDU_COL_MSG_REF_NO, "msgRefNo", msgRefNo),
+	COL_STR(PDU_COL_PHONE_ADDR, "phoneAddr", phoneAddr),
+	COL_U8(PDU_COL_PHONE_TYPE_OF_ADDR, "phoneTypeOfAddr", phoneTypeOfAddr),
+	COL_U8(PDU_COL_PROTOCOL_ID, "protocolId", protocolId),
+	COL_U8(PDU_COL_DATA_CODE_SCHEME, "dataCodeScheme", dataCodeScheme),
+	COL_U8(PDU_COL_MSG_TYPE, "msgType", msgType),
+	COL_U8(PDU_COL_IS_WAP_PUSH_MSG, "isWapPushMsg", isWapPushMsg),
+	COL_U8(PDU_COL_IS_FLASH_MSG, "isFlashMsg", isFlashMsg),
+	COL_U8(PDU_COL_IS_STS_REPORT_REQ, "isStsReportReq", isStsReportReq),
+	COL_U8(PDU_COL_IS_MSG_WAIT, "isMsgWait", isMsgWait),
+	COL_U8(PDU_COL_USR_DATA_FORMAT, "usrDataFormat", usrDataFormat),
+	COL_STR(PDU_COL_TIME_STAMP, "timeStamp", timeStamp),
+	COL_STR(PDU_COL_DISCHRG_TIME_STAMP, "dischrgTimeStamp", dischrgTimeStamp),
+	COL_U8(PDU_COL_VLDT_PRD, "vldtPrd", vldtPrd),
+	COL_U8(PDU_COL_VLDT_PRD_FRMT, "vldtPrdFrmt", vldtPrdFrmt),
+	{PDU_COL_USR_DATA, PDU_COL_BLOB, "usrData", offsetof(PDU_DESC, usrData), offsetof(PDU_DESC, usrDataLen)},
+	COL_U8(PDU_COL_UDH_LEN, "udhLen", udhLen),
+	COL_U8(PDU_COL_CONCATE_MSG_REF_NO, "concateMsgRefNo", concateMsgRefNo),
+	COL_U8(PDU_COL_CONCATE_TOTAL_PARTS, "concateTotalParts", concateTotalParts),
+	COL_U8(PDU_COL_CONCATE_CURNT_PART, "concateCurntPart", concateCurntPart),
+	COL_U8(PDU_COL_IS_CONCATENATED_MSG, "isConcatenatedMsg", isConcatenatedMsg),
+	COL_U8(PDU_COL_SMS_STS, "smsSts", smsSts),
+	COL_U16(PDU_COL_SRC_PORT_ADDR, "srcPortAddr", srcPortAddr),
+	COL_U16(PDU_COL_DEST_PORT_ADDR, "destPortAddr", destPortAddr),
+	COL_U8(PDU_COL_TZ, "tz", tz),
+	{PDU_COL_UDH_IE, PDU_COL_BLOB, "udhIe", offsetof(PDU_DESC, udhIe), COL_SRC_UDH_IE},
+};
+
+/*
+ *   DESCRIPTION: Make room for <n> more octets in the buffer.
+ *
+ *   INPUTS:
+ *	b:	buffer
+ *	n:	number of octets
+ *
+ *   RETURNS:
+ *	pointer to the room, NULL - no memory
+ */
+static inline unsigned char	*__col_buf_room(COL_BUF_DESC *b, size_t n)
+{
+unsigned char	*p;
+size_t	sz;
+
+	if ( b->len + n > b->sz )
+		{
+		for (sz = b->sz ? b->sz : 256; sz < b->len + n; sz *= 2)
+			;
+
+		if ( !(p = realloc(b->buf, sz)) )
+			return	NULL;
+
+		b->buf = p;
+		b->sz = sz;
+		}
+
+	return	b->buf + b->len;
+}
+
+/*
+ *   DESCRIPTION: Store integer in the little-endian order.
+ *
+ *   INPUTS:
+ *	p:	output position
+ *	v:	value
+ *	n:	number of octets
+ *
+ *   RETURNS:
+ *	NONE
+ */
+static inline void	__col_le(unsigned char *p, uint64_t v, int n)
+{
+	while ( n-- )
+		{
+		*p++ = (unsigned char) v;
+		v >>= 8;
+		}
+}
+
+//***************************************************************************
+// @NAME        : PduColCreate
+// @PARAM       : rowsHint - expected number of rows in a block, buffers are preallocated
+// @RETURNS     : Column buffers, NULL - no memory
+// @DESCRIPTION : This function creates an empty set of column buffers.
+//***************************************************************************
+PDU_COL_DESC	*PduColCreate(int rowsHint)
+{
+PDU_COL_DESC	*col;
+const COL_DEF_DESC	*def;
+size_t	n;
+int	i;
+
+	if ( !(col = calloc(1, sizeof(PDU_COL_DESC))) )
+		return	NULL;
+
+	rowsHint = (rowsHint > 0) ? rowsHint : 1;
+
+	for (i = 0; i < PDU_COL_MAX; i++)
+		{
+		def = &__pdu_col_defs[i];
+		n = (def->type == PDU_COL_U16) ? 2 : (def->type == PDU_COL_U8) ? 1 : 16;
+
+		if ( !__col_buf_room(&col->data[i], n * rowsHint)
+			|| ((def->type == PDU_COL_BLOB) && !__col_buf_room(&col->offs[i], 4 * (rowsHint + 1))) )
+			{
+			PduColDestroy(col);
+			return	NULL;
+			}
+		}
+
+	return	col;
+}
+
+//***************************************************************************
+// @NAME        : PduColDestroy
+// @PARAM       : col - column buffers
+// @RETURNS     : void
+// @DESCRIPTION : This function releases column buffers, rows which have not been
+//				  flushed are lost.
+//***************************************************************************
+void	PduColDestroy(PDU_COL_DESC *col)
+{
+int	i;
+
+	if ( !col )
+		return;
+
+	for (i = 0; i < PDU_COL_MAX; i++)
+		{
+		free(col->data[i].buf);
+		free(col->offs[i].buf);
+		}
+
+	free(col);
+}
+
+//***************************************************************************
+// @NAME        : PduColAdd
+// @PARAM       : col - column buffers
+//				  pdsc - decoded PDU
+//				  pError - ERR_NO_MEMORY on failure
+// @RETURNS     : TRUE/FALSE
+// @DESCRIPTION : This function appends the fields of the PDU to the columns, the row is
+//				  either added to all columns or is not added at all.
+//***************************************************************************
+int	PduColAdd(PDU_COL_DESC *col, const PDU_DESC *pdsc, int *pError)
+{
+const COL_DEF_DESC	*def;
+const unsigned char	*fld;
+unsigned char	*p;
+size_t	len, saved[PDU_COL_MAX];
+int	i;
+
+	for (i = 0; i < PDU_COL_MAX; i++)
+		{
+		def = &__pdu_col_defs[i];
+		fld = (const unsigned char *) pdsc + def->off;
+		saved[i] = col->data[i].len;
+
+		switch ( def->type )
+			{
+			case	PDU_COL_U8:
+				if ( !(p = __col_buf_room(&col->data[i], 1)) )
+					goto	nomem;
+
+				*p = *fld;
+				col->data[i].len += 1;
+				break;
+
+			case	PDU_COL_U16:
+				if ( !(p = __col_buf_room(&col->data[i], 2)) )
+					goto	nomem;
+
+				__col_le(p, *(const uint16_t *) fld, 2);
+				col->data[i].len += 2;
+				break;
+
+			case	PDU_COL_BLOB:
+				if ( def->lenOff == COL_SRC_STR )
+					len = strlen((const char *) fld);
+				else if ( def->lenOff == COL_SRC_UDH_IE )
+					len = pdsc->udhIeNum * sizeof(PDU_UDH_IE_DESC);
+				else	len = *(const uint16_t *) ((const unsigned char *) pdsc + def->lenOff);
+
+				if ( !__col_buf_room(&col->offs[i], 4) || !(p = __col_buf_room(&col->data[i], len)) )
+					goto	nomem;
+
+				memcpy(p, fld, len);
+				col->data[i].len += len;
+				break;
+			}
+		}
+
+	/* All buffers have room, store end offsets of BLOBs */
+	for (i = 0; i < PDU_COL_MAX; i++)
+		{
+		if ( __pdu_col_defs[i].type != PDU_COL_BLOB )
+			continue;
+
+		__col_le(col->offs[i].buf + col->offs[i].len, col->data[i].len, 4);
+		col->offs[i].len += 4;
+		}
+
+	col->nrows++;
+
+	return	TRUE;
+
+nomem:
+	while ( i >= 0 )
+		col->data[i].len = saved[i], i--;
+
+	return	*pError = ERR_NO_MEMORY, (FALSE);
+}
+
+//***************************************************************************
+// @NAME        : PduColRows
+// @PARAM       : col - column buffers
+// @RETURNS     : Number of rows are not flushed yet
+// @DESCRIPTION : This function is used to decide when the block should be flushed.
+//***************************************************************************
+int	PduColRows(const PDU_COL_DESC *col)
+{
+	return	col->nrows;
+}
+
+//***************************************************************************
+// @NAME        : PduColWriteHeader
+// @PARAM       : fp - output file
+// @RETURNS     : TRUE/FALSE
+// @DESCRIPTION : This function writes the file header with the column directory,
+//				  it is written once before the first block.
+//***************************************************************************
+int	PduColWriteHeader(FILE *fp)
+{
+unsigned char	hdr[PDU_COL_MAGIC_LEN + 2 + PDU_COL_MAX * (3 + 255)], *p = hdr;
+size_t	len;
+int	i;
+
+	memcpy(p, PDU_COL_MAGIC, PDU_COL_MAGIC_LEN);
+	p += PDU_COL_MAGIC_LEN;
+
+	__col_le(p, PDU_COL_MAX, 2);
+	p += 2;
+
+	for (i = 0; i < PDU_COL_MAX; i++)
+		{
+		len = strlen(__pdu_col_defs[i].name);
+
+		*p++ = __pdu_col_defs[i].id;
+		*p++ = __pdu_col_defs[i].type;
+		*p++ = (unsigned char) len;
+		memcpy(p, __pdu_col_defs[i].name, len);
+		p += len;
+		}
+
+	len = p - hdr;
+
+	return	(len == fwrite(hdr, 1, len, fp));
+}
+
+//***************************************************************************
+// @NAME        : PduColFlush
+// @PARAM       : col - column buffers
+//				  fp - output file
+// @RETURNS     : TRUE/FALSE
+// @DESCRIPTION : This function writes accumulated rows as a block and empties buffers,
+//				  nothing is written if there are no rows.
+//***************************************************************************
+int	PduColFlush(PDU_COL_DESC *col, FILE *fp)
+{
+unsigned char	hdr[PDU_COL_BLOCK_MAGIC_LEN + 4 + PDU_COL_MAX * 8], *p = hdr, zero[4] = {0};
+size_t	len;
+int	i, ok = TRUE;
+
+	if ( !col->nrows )
+		return	TRUE;
+
+	memcpy(p, PDU_COL_BLOCK_MAGIC, PDU_COL_BLOCK_MAGIC_LEN);
+	p += PDU_COL_BLOCK_MAGIC_LEN;
+
+	__col_le(p, col->nrows, 4);
+	p += 4;
+
+	for (i = 0; i < PDU_COL_MAX; i++, p += 8)
+		{
+		len = col->data[i].len;
+
+		if ( __pdu_col_defs[i].type == PDU_COL_BLOB )
+			len += sizeof(zero) + col->offs[i].len;
+
+		__col_le(p, len, 8);
+		}
+
+	ok &= (sizeof(hdr) == fwrite(hdr, 1, sizeof(hdr), fp));
+
+	for (i = 0; i < PDU_COL_MAX; i++)
+		{
+		if ( __pdu_col_defs[i].type == PDU_COL_BLOB )
+			{
+			ok &= (sizeof(zero) == fwrite(zero, 1, sizeof(zero), fp));
+			ok &= (col->offs[i].len == fwrite(col->offs[i].buf, 1, col->offs[i].len, fp));
+			col->offs[i].len = 0;
+			}
+
+		ok &= (col->data[i].len == fwrite(col->data[i].buf, 1, col->data[i].len, fp));
+		col->data[i].len = 0;
+		}
+
+	col->nrows = 0;
+
+	return	ok;
+}
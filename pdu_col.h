@@ -0,0 +1,139 @@
+/*
+ *   DESCRIPTION:	Columnar writer of decoded PDUs
+ *
+ *   ABSTRACT:	Fields of decoded PDUs (PDU_DESC) are accumulated in per-column buffers and
+ *		are written as blocks of columns, so a reader can fetch e.g. only
+ *		<dataCodeScheme> and <phoneAddr> and skip other columns by their sizes.
+ *
+ *		File layout, all integers are little-endian:
+ *
+ *		Header:	"PDUCOL" 0x01 0x00			- magic & version
+ *			u16	ncols
+ *			ncols x {u8 id, u8 type, u8 nameLen, char name[nameLen]}
+ *
+ *		Block:	"PBLK"
+ *			u32	nrows
+ *			ncols x u64	size of the column data in octets
+ *			ncols x column data, in the order of the header
+ *
+ *		Column data:
+ *			PDU_COL_U8	nrows x u8
+ *			PDU_COL_U16	nrows x u16
+ *			PDU_COL_BLOB	(nrows + 1) x u32 offsets (the first is 0),
+ *					followed by the octets of all rows
+ *
+ *		Addresses and time stamps are stored as strings w/o NUL, <usrData> is stored
+ *		as decoded: UTF-8 for GSM 7-bit & UCS-2, raw octets for 8-bit. <udhIe> is
+ *		a BLOB of {u8 type, u8 off, u8 len} triples, one per UDH Information Element
+ *		(see PDU_UDH_IE_DESC), empty if there is no UDH.
+ *
+ *   AUTHOR: AG
+ *
+ *   CREATION DATE: 17-OCT-2026
+ *
+ *   USAGE:
+ *		PDU_COL_DESC	*col = PduColCreate(64*1024);
+ *
+ *		PduColWriteHeader(fp);
+ *
+ *		for ( ... )
+ *			{
+ *			PduColAdd(col, &pdsc, &err);
+ *
+ *			if ( PduColRows(col) >= 64*1024 )
+ *				PduColFlush(col, fp);
+ *			}
+ *
+ *		PduColFlush(col, fp);
+ *		PduColDestroy(col);
+ *
+ *   MODIFICATION HISTORY:
+ *
+ *
+ */
+#ifndef PDU_COL_H
+#define PDU_COL_H
+
+
+//###########################################################################
+// @INCLUDE
+//###########################################################################
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "pdu.h"
+
+//###########################################################################
+// @DEFINES
+//###########################################################################
+#define PDU_COL_MAGIC				"PDUCOL\x01\x00"
+#define PDU_COL_MAGIC_LEN			8
+#define PDU_COL_BLOCK_MAGIC			"PBLK"
+#define PDU_COL_BLOCK_MAGIC_LEN			4
+
+//###########################################################################
+// @ENUMERATOR
+//###########################################################################
+/* Column types */
+enum
+{
+	PDU_COL_U8 = 1,
+	PDU_COL_U16 = 2,
+	PDU_COL_BLOB = 3
+};
+
+/* Column ids, the order of columns in the file */
+enum
+{
+	PDU_COL_SMSC_ADDR = 0,
+	PDU_COL_SMSC_TYPE_OF_ADDR,
+	PDU_COL_FIRST_OCT,
+	PDU_COL_MSG_REF_NO,
+	PDU_COL_PHONE_ADDR,
+	PDU_COL_PHONE_TYPE_OF_ADDR,
+	PDU_COL_PROTOCOL_ID,
+	PDU_COL_DATA_CODE_SCHEME,
+	PDU_COL_MSG_TYPE,
+	PDU_COL_IS_WAP_PUSH_MSG,
+	PDU_COL_IS_FLASH_MSG,
+	PDU_COL_IS_STS_REPORT_REQ,
+	PDU_COL_IS_MSG_WAIT,
+	PDU_COL_USR_DATA_FORMAT,
+	PDU_COL_TIME_STAMP,
+	PDU_COL_DISCHRG_TIME_STAMP,
+	PDU_COL_VLDT_PRD,
+	PDU_COL_VLDT_PRD_FRMT,
+	PDU_COL_USR_DATA,
+	PDU_COL_UDH_LEN,
+	PDU_COL_CONCATE_MSG_REF_NO,
+	PDU_COL_CONCATE_TOTAL_PARTS,
+	PDU_COL_CONCATE_CURNT_PART,
+	PDU_COL_IS_CONCATENATED_MSG,
+	PDU_COL_SMS_STS,
+	PDU_COL_SRC_PORT_ADDR,
+	PDU_COL_DEST_PORT_ADDR,
+	PDU_COL_TZ,
+	PDU_COL_UDH_IE,
+
+	PDU_COL_MAX
+};
+
+//###########################################################################
+// @DATATYPE
+//###########################################################################
+typedef struct __pdu_col	PDU_COL_DESC;			/* Opaque column buffers */
+
+//###########################################################################
+// @PROTOTYPE
+//###########################################################################
+PDU_COL_DESC	*PduColCreate	(int rowsHint);
+void	PduColDestroy	(PDU_COL_DESC *col);
+
+int	PduColAdd	(PDU_COL_DESC *col, const PDU_DESC *pdsc, int *pError);
+int	PduColRows	(const PDU_COL_DESC *col);
+
+int	PduColWriteHeader(FILE *fp);
+int	PduColFlush	(PDU_COL_DESC *col, FILE *fp);
+
+#endif	// PDU_COL_H
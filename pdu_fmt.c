@@ -0,0 +1,495 @@
+/*
+ *   DESCRIPTION:	Serializers of decoded PDUs
+ *
+ *   ABSTRACT:	Fields are described by a table of {key fragment, kind, offset}, a key
+ *		fragment carries the separator and the quoted key (or the padded name of
+ *		the text layout), so per field only one memcpy() of a constant length and
+ *		a value conversion are made.
+ *
+ *		UDH Information Elements are given in JSON only, as an array of
+ *		{"type","off","len"} objects; the text layout has no place for them.
+ *
+ *   AUTHOR: AG
+ *
+ *   CREATION DATE: 17-OCT-2026
+ *
+ *   USAGE:	See pdu_fmt.h
+ *
+ *   MODIFICATION HISTORY:
+ *
+ *
+ */
+
+
+//###########################################################################
+// @INCLUDES
+//###########################################################################
+#include	<string.h>
+
+#include	"pdu_fmt.h"
+
+//###########################################################################
+// @DEFINES
+//###########################################################################
+enum
+{
+	FMT_U8 = 0,							/* uint8_t/unsigned char */
+	FMT_U16,							/* uint16_t */
+	FMT_STR,							/* NUL-terminated string */
+	FMT_UD,								/* <usrData>, <usrDataLen> */
+	FMT_DATE,							/* DATE_DESC as DD-MM-YYYY */
+	FMT_TIME,							/* TIME_DESC as HH:MM:SS */
+	FMT_UDH_IE							/* <udhIe>, <udhIeNum> as array of objects */
+};
+
+//###########################################################################
+// @DATATYPE
+//###########################################################################
+/* Field of the output */
+typedef struct
+{
+	const char	*key;						/* Key fragment: separator, key, colon */
+	uint8_t	keyLen;
+	uint8_t	kind;
+	uint16_t	off;						/* Offset of the field in the PDU_DESC */
+} FMT_FIELD_DESC;
+
+#define	FMT_JSON(first, name, kind, fld)	{first "\"" name "\":", sizeof(first "\"" name "\":") - 1, kind, offsetof(PDU_DESC, fld)}
+
+static const FMT_FIELD_DESC	__fmt_json_fields[] = {
+	FMT_JSON("", "smscAddrLen", FMT_U8, smscAddrLen),		/* "{" and caller's keys go first */
+	FMT_JSON(",", "smscNpi", FMT_U8, smscNpi),
+	FMT_JSON(",", "smscTypeOfAddr", FMT_U8, smscTypeOfAddr),
+	FMT_JSON(",", "smscAddr", FMT_STR, smscAddr),
+	FMT_JSON(",", "firstOct", FMT_U8, firstOct),
+	FMT_JSON(",", "isHeaderPrsnt", FMT_U8, isHeaderPrsnt),
+	FMT_JSON(",", "msgRefNo", FMT_U8, msgRefNo),
+	FMT_JSON(",", "phoneAddrLen", FMT_U8, phoneAddrLen),
+	FMT_JSON(",", "phoneTypeOfAddr", FMT_U8, phoneTypeOfAddr),
+	FMT_JSON(",", "phoneAddr", FMT_STR, phoneAddr),
+	FMT_JSON(",", "protocolId", FMT_U8, protocolId),
+	FMT_JSON(",", "dataCodeScheme", FMT_U8, dataCodeScheme),
+	FMT_JSON(",", "msgType", FMT_U8, msgType),
+	FMT_JSON(",", "isWapPushMsg", FMT_U8, isWapPushMsg),
+	FMT_JSON(",", "isFlashMsg", FMT_U8, isFlashMsg),
+	FMT_JSON(",", "isStsReportReq", FMT_U8, isStsReportReq),
+	FMT_JSON(",", "isMsgWait", FMT_U8, isMsgWait),
+	FMT_JSON(",", "usrDataFormat", FMT_U8, usrDataFormat),
+	FMT_JSON(",", "timeStamp", FMT_STR, timeStamp),
+	FMT_JSON(",", "dischrgTimeStamp", FMT_STR, dischrgTimeStamp),
+	FMT_JSON(",", "vldtPrd", FMT_U8, vldtPrd),
+	FMT_JSON(",", "vldtPrdFrmt", FMT_U8, vldtPrdFrmt),
+	FMT_JSON(",", "usrDataLen", FMT_U16, usrDataLen),
+	FMT_JSON(",", "usrData", FMT_UD, usrData),
+	FMT_JSON(",", "udhLen", FMT_U8, udhLen),
+	FMT_JSON(",", "udhInfoType", FMT_U8, udhInfoType),
+	FMT_JSON(",", "udhInfoLen", FMT_U8, udhInfoLen),
+	FMT_JSON(",", "udhIe", FMT_UDH_IE, udhIe),
+	FMT_JSON(",", "concateMsgRefNo", FMT_U8, concateMsgRefNo),
+	FMT_JSON(",", "concateTotalParts", FMT_U8, concateTotalParts),
+	FMT_JSON(",", "concateCurntPart", FMT_U8, concateCurntPart),
+	FMT_JSON(",", "isConcatenatedMsg", FMT_U8, isConcatenatedMsg),
+	FMT_JSON(",", "smsSts", FMT_U8, smsSts),
+	FMT_JSON(",", "srcPortAddr", FMT_U16, srcPortAddr),
+	FMT_JSON(",", "destPortAddr", FMT_U16, destPortAddr),
+	FMT_JSON(",", "isDeliveryReq", FMT_U8, isDeliveryReq),
+	FMT_JSON(",", "date", FMT_DATE, date),
+	FMT_JSON(",", "time", FMT_TIME, time),
+	FMT_JSON(",", "tz", FMT_U8, tz),
+};
+
+#define	FMT_TEXT(name, kind, fld)	{name ": ", sizeof(name ": ") - 1, kind, offsetof(PDU_DESC, fld)}
+
+static const FMT_FIELD_DESC	__fmt_text_fields[] = {		/* Layout of print_decoded_pdu() */
+	FMT_TEXT("smscAddrLen      ", FMT_U8, smscAddrLen),
+	FMT_TEXT("smscNpi          ", FMT_U8, smscNpi),
+	FMT_TEXT("smscTypeOfAddr   ", FMT_U8, smscTypeOfAddr),
+	FMT_TEXT("smscAddr         ", FMT_STR, smscAddr),
+	FMT_TEXT("firstOct         ", FMT_U8, firstOct),
+	FMT_TEXT("isHeaderPrsnt    ", FMT_U8, isHeaderPrsnt),
+	FMT_TEXT("msgRefNo         ", FMT_U8, msgRefNo),
+	FMT_TEXT("phoneAddrLen     ", FMT_U8, phoneAddrLen),
+	FMT_TEXT("phoneAddr        ", FMT_STR, phoneAddr),
+	FMT_TEXT("protocolId       ", FMT_U8, protocolId),
+	FMT_TEXT("dataCodeScheme   ", FMT_U8, dataCodeScheme),
+	FMT_TEXT("msgType          ", FMT_U8, msgType),
+	FMT_TEXT("isWapPushMsg     ", FMT_U8, isWapPushMsg),
+	FMT_TEXT("isFlashMsg       ", FMT_U8, isFlashMsg),
+	FMT_TEXT("isStsReportReq   ", FMT_U8, isStsReportReq),
+	FMT_TEXT("isMsgWait        ", FMT_U8, isMsgWait),
+	FMT_TEXT("usrDataFormat    ", FMT_U8, usrDataFormat),
+	FMT_TEXT("timeStamp        ", FMT_STR, timeStamp),
+	FMT_TEXT("dischrgTimeStamp ", FMT_STR, dischrgTimeStamp),
+	FMT_TEXT("vldtPrd          ", FMT_U8, vldtPrd),
+	FMT_TEXT("vldtPrdFrmt      ", FMT_U8, vldtPrdFrmt),
+	FMT_TEXT("usrDataLen       ", FMT_U16, usrDataLen),
+	FMT_TEXT("usrData          ", FMT_UD, usrData),
+	FMT_TEXT("udhLen           ", FMT_U8, udhLen),
+	FMT_TEXT("udhInfoType      ", FMT_U8, udhInfoType),
+	FMT_TEXT("udhInfoLen       ", FMT_U8, udhInfoLen),
+	FMT_TEXT("concateMsgRefNo  ", FMT_U8, concateMsgRefNo),
+	FMT_TEXT("concateTotalParts", FMT_U8, concateTotalParts),
+	FMT_TEXT("concateCurntPart ", FMT_U8, concateCurntPart),
+	FMT_TEXT("isConcatenatedMsg", FMT_U8, isConcatenatedMsg),
+	FMT_TEXT("smsSts           ", FMT_U8, smsSts),
+	FMT_TEXT("srcPortAddr      ", FMT_U16, srcPortAddr),
+	FMT_TEXT("destPortAddr     ", FMT_U16, destPortAddr),
+	FMT_TEXT("isDeliveryReq    ", FMT_U8, isDeliveryReq),
+	FMT_TEXT("Date             ", FMT_DATE, date),
+	FMT_TEXT("Time             ", FMT_TIME, time),
+};
+
+static const char	__fmt_hex[] = "0123456789ABCDEF";
+
+/* JSON escapes: 0 - as is, 'u' - \u00XX, others - \<char> */
+static const char	__fmt_json_esc[256] = {
+	'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'b', 't', 'n', 'u', 'f', 'r', 'u', 'u',
+	'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u',
+	0, 0, '"', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, '\\', 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 'u',
+};
+
+/*
+ *   DESCRIPTION: Convert unsigned integer to decimal.
+ *
+ *   INPUTS:
+ *	p:	output position
+ *	v:	value
+ *
+ *   RETURNS:
+ *	position after the last digit
+ */
+static inline char	*__fmt_u32(char *p, uint32_t v)
+{
+char	tmp[10];
+int	n = 0;
+
+	do	{
+		tmp[n++] = (char) ('0' + v % 10);
+		v /= 10;
+		} while ( v );
+
+	while ( n )
+		*p++ = tmp[--n];
+
+	return	p;
+}
+
+/*
+ *   DESCRIPTION: Convert unsigned integer to decimal with leading zeros, as "%0<width>u".
+ *
+ *   INPUTS:
+ *	p:	output position
+ *	v:	value
+ *	width:	minimal number of digits
+ *
+ *   RETURNS:
+ *	position after the last digit
+ */
+static inline char	*__fmt_u32w(char *p, uint32_t v, int width)
+{
+char	tmp[10];
+int	n = 0;
+
+	do	{
+		tmp[n++] = (char) ('0' + v % 10);
+		v /= 10;
+		} while ( v );
+
+	for ( ; width > n; width--)
+		*p++ = '0';
+
+	while ( n )
+		*p++ = tmp[--n];
+
+	return	p;
+}
+
+/*
+ *   DESCRIPTION: Put a quoted JSON string, runs of characters w/o escapes are copied
+ *	by memcpy().
+ *
+ *   INPUTS:
+ *	p:	output position
+ *	s:	UTF-8 text
+ *	len:	length of the text
+ *
+ *   RETURNS:
+ *	position after the closing quote
+ */
+static char	*__fmt_json_str(char *p, const unsigned char *s, size_t len)
+{
+size_t	i, run;
+char	esc;
+
+	*p++ = '"';
+
+	for (i = 0; i < len; )
+		{
+		for (run = i; (run < len) && !__fmt_json_esc[s[run]]; run++)
+			;
+
+		memcpy(p, s + i, run - i);
+		p += run - i;
+
+		if ( (i = run) == len )
+			break;
+
+		*p++ = '\\';
+
+		if ( 'u' == (esc = __fmt_json_esc[s[i]]) )
+			{
+			memcpy(p, "u00", 3);
+			p[3] = __fmt_hex[s[i] >> 4];
+			p[4] = __fmt_hex[s[i] & 0x0F];
+			p += 5;
+			}
+		else	*p++ = esc;
+
+		i++;
+		}
+
+	*p++ = '"';
+
+	return	p;
+}
+
+/*
+ *   DESCRIPTION: Put octets as a quoted HEX string.
+ *
+ *   INPUTS:
+ *	p:	output position
+ *	s:	octets
+ *	len:	number of octets
+ *
+ *   RETURNS:
+ *	position after the closing quote
+ */
+static char	*__fmt_hex_str(char *p, const unsigned char *s, size_t len)
+{
+size_t	i;
+
+	*p++ = '"';
+
+	for (i = 0; i < len; i++)
+		{
+		*p++ = __fmt_hex[s[i] >> 4];
+		*p++ = __fmt_hex[s[i] & 0x0F];
+		}
+
+	*p++ = '"';
+
+	return	p;
+}
+
+/*
+ *   DESCRIPTION: Format fields of the PDU by the table.
+ *
+ *   INPUTS:
+ *	flds:	fields table
+ *	nflds:	number of fields
+ *	pdsc:	decoded PDU
+ *	p:	output position
+ *	json:	TRUE - JSON values, FALSE - print_decoded_pdu() values, each field ends with LF
+ *
+ *   RETURNS:
+ *	position after the last field
+ */
+static char	*__fmt_fields(const FMT_FIELD_DESC *flds, int nflds, const PDU_DESC *pdsc, char *p, int json)
+{
+const FMT_FIELD_DESC	*fld;
+const unsigned char	*v;
+const DATE_DESC	*pDate;
+const TIME_DESC	*pTime;
+size_t	len;
+int	i, j;
+
+	for (i = 0; i < nflds; i++)
+		{
+		fld = &flds[i];
+		v = (const unsigned char *) pdsc + fld->off;
+
+		memcpy(p, fld->key, fld->keyLen);
+		p += fld->keyLen;
+
+		switch ( fld->kind )
+			{
+			case	FMT_U8:
+				p = __fmt_u32(p, *v);
+				break;
+
+			case	FMT_U16:
+				p = __fmt_u32(p, *(const uint16_t *) v);
+				break;
+
+			case	FMT_STR:
+				len = strlen((const char *) v);
+
+				if ( json )
+					p = __fmt_json_str(p, v, len);
+				else	{
+					memcpy(p, v, len);
+					p += len;
+					}
+				break;
+
+			case	FMT_UD:
+				if ( !json )					/* As "%s" */
+					{
+					len = strnlen((const char *) v, sizeof(pdsc->usrData));
+					memcpy(p, v, len);
+					p += len;
+					}
+				else if ( pdsc->usrDataFormat != ANSI_8BIT )
+					p = __fmt_json_str(p, v, pdsc->usrDataLen);
+				else	p = __fmt_hex_str(p, v, pdsc->usrDataLen);
+				break;
+
+			case	FMT_DATE:
+				pDate = (const DATE_DESC *) v;
+
+				if ( json )
+					*p++ = '"';
+
+				p = __fmt_u32w(p, pDate->day, 2);
+				*p++ = '-';
+				p = __fmt_u32w(p, pDate->month, 2);
+				*p++ = '-';
+				p = __fmt_u32w(p, pDate->year, 4);
+
+				if ( json )
+					*p++ = '"';
+				break;
+
+			case	FMT_TIME:
+				pTime = (const TIME_DESC *) v;
+
+				if ( json )
+					*p++ = '"';
+
+				p = __fmt_u32w(p, pTime->hour, 2);
+				*p++ = ':';
+				p = __fmt_u32w(p, pTime->minute, 2);
+				*p++ = ':';
+				p = __fmt_u32w(p, pTime->second, 2);
+
+				if ( json )
+					*p++ = '"';
+				break;
+
+			case	FMT_UDH_IE:					/* JSON only */
+				*p++ = '[';
+
+				for (j = 0; j < pdsc->udhIeNum; j++)
+					{
+					if ( j )
+						*p++ = ',';
+
+					memcpy(p, "{\"type\":", 8);
+					p = __fmt_u32(p + 8, pdsc->udhIe[j].type);
+					memcpy(p, ",\"off\":", 7);
+					p = __fmt_u32(p + 7, pdsc->udhIe[j].off);
+					memcpy(p, ",\"len\":", 7);
+					p = __fmt_u32(p + 7, pdsc->udhIe[j].len);
+					*p++ = '}';
+					}
+
+				*p++ = ']';
+				break;
+			}
+
+		if ( !json )
+			*p++ = '\n';
+		}
+
+	return	p;
+}
+
+//***************************************************************************
+// @NAME        : PduFmtJson
+// @PARAM       : pdsc - decoded PDU
+//				  buf - output buffer
+//				  bufSz - size of the buffer, PDU_FMT_JSON_MAX is always enough
+// @RETURNS     : Length of the line including LF, w/o NUL; -1 - the buffer is too small
+// @DESCRIPTION : This function formats the PDU descriptor as one NDJSON line,
+//				  the line is not NUL-terminated.
+//***************************************************************************
+int	PduFmtJson(const PDU_DESC *pdsc, char *buf, size_t bufSz)
+{
+	return	PduFmtJsonKeys(pdsc, NULL, buf, bufSz);
+}
+
+//***************************************************************************
+// @NAME        : PduFmtJsonKeys
+// @PARAM       : pdsc - decoded PDU
+//				  keys - caller's members put first in the object, e.g. "\"record\":17",
+//				  w/o braces and trailing comma; NULL or "" - none
+//				  buf - output buffer
+//				  bufSz - size of the buffer, PDU_FMT_JSON_MAX plus strlen(keys) plus 1 is
+//				  always enough
+// @RETURNS     : Length of the line including LF, w/o NUL; -1 - the buffer is too small
+// @DESCRIPTION : This function formats the PDU descriptor as one NDJSON line like
+//				  PduFmtJson() with the caller's keys in front of the PDU_DESC fields;
+//				  the keys are copied as they are, the line is not NUL-terminated.
+//***************************************************************************
+int	PduFmtJsonKeys(const PDU_DESC *pdsc, const char *keys, char *buf, size_t bufSz)
+{
+size_t	keysLen = keys ? strlen(keys) : 0;
+char	*p;
+
+	if ( bufSz < PDU_FMT_JSON_MAX + keysLen + 1 )				/* Check exact size only for small buffers */
+		{
+		size_t	need = PDU_FMT_JSON_FIXED + 6 * (strlen((char *) pdsc->smscAddr) + strlen((char *) pdsc->phoneAddr)
+				+ strlen((char *) pdsc->timeStamp) + strlen((char *) pdsc->dischrgTimeStamp) + pdsc->usrDataLen)
+				+ keysLen + 1;
+
+		if ( bufSz < need )
+			return	-1;
+		}
+
+	p = buf;
+	*p++ = '{';
+
+	if ( keysLen )
+		{
+		memcpy(p, keys, keysLen);
+		p += keysLen;
+		*p++ = ',';
+		}
+
+	p = __fmt_fields(__fmt_json_fields, sizeof(__fmt_json_fields) / sizeof(__fmt_json_fields[0]), pdsc, p, TRUE);
+
+	*p++ = '}';
+	*p++ = '\n';
+
+	return	(int) (p - buf);
+}
+
+//***************************************************************************
+// @NAME        : PduFmtText
+// @PARAM       : pdsc - decoded PDU
+//				  buf - output buffer
+//				  bufSz - size of the buffer, PDU_FMT_TEXT_MAX is always enough
+// @RETURNS     : Length of the text w/o NUL; -1 - the buffer is too small
+// @DESCRIPTION : This function formats the PDU descriptor exactly as print_decoded_pdu()
+//				  prints it, the caller writes the text as it likes, e.g. many PDUs
+//				  by one fwrite(); the text is not NUL-terminated.
+//***************************************************************************
+int	PduFmtText(const PDU_DESC *pdsc, char *buf, size_t bufSz)
+{
+	if ( bufSz < PDU_FMT_TEXT_MAX )
+		{
+		size_t	need = PDU_FMT_TEXT_FIXED + strlen((char *) pdsc->smscAddr) + strlen((char *) pdsc->phoneAddr)
+				+ strlen((char *) pdsc->timeStamp) + strlen((char *) pdsc->dischrgTimeStamp)
+				+ strnlen((char *) pdsc->usrData, sizeof(pdsc->usrData));
+
+		if ( bufSz < need )
+			return	-1;
+		}
+
+	return	(int) (__fmt_fields(__fmt_text_fields, sizeof(__fmt_text_fields) / sizeof(__fmt_text_fields[0]), pdsc, buf, FALSE) - buf);
+}
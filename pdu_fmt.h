@@ -0,0 +1,60 @@
+/*
+ *   DESCRIPTION:	Serializers of decoded PDUs
+ *
+ *   ABSTRACT:	PDU_DESC is formatted into a caller's buffer, no stdio and no printf-like
+ *		format parsing are used: keys are precomputed fragments, integers are
+ *		converted by hand.
+ *
+ *		JSON - one NDJSON line (object + LF) per PDU, keys are the names of the
+ *		PDU_DESC fields; <usrData> is a string for GSM 7-bit & UCS-2 (UTF-8 text)
+ *		and a HEX string for 8-bit user data; <udhIe> is an array of
+ *		{"type":<IEI>,"off":<offset from the UDHL octet>,"len":<IE data length>}.
+ *		PduFmtJsonKeys() puts the caller's keys (e.g. a record number) first.
+ *
+ *		Text - the layout of print_decoded_pdu(), w/o stdio & fflush() per PDU.
+ *
+ *   AUTHOR: AG
+ *
+ *   CREATION DATE: 17-OCT-2026
+ *
+ *   USAGE:
+ *		char	line[PDU_FMT_JSON_MAX];
+ *		int	len = PduFmtJson(&pdsc, line, sizeof(line));
+ *
+ *		write(fd, line, len);
+ *
+ *   MODIFICATION HISTORY:
+ *
+ *
+ */
+#ifndef PDU_FMT_H
+#define PDU_FMT_H
+
+
+//###########################################################################
+// @INCLUDE
+//###########################################################################
+#include <stddef.h>
+
+#include "pdu.h"
+
+//###########################################################################
+// @DEFINES
+//###########################################################################
+#define PDU_FMT_JSON_FIXED			2048	/* Keys, numbers & punctuation of the JSON line */
+#define PDU_FMT_JSON_MAX			(PDU_FMT_JSON_FIXED + 6 * (2 * ADDR_OCTET_MAX_LEN + 2 * TIME_STAMP_OCTET_MAX_LEN \
+						+ SMS_GSM7BIT_MAX_LEN * UTF8_CHAR_LEN))
+									/* Worst case of the JSON line of one PDU */
+#define PDU_FMT_TEXT_FIXED			2048	/* Names & numbers of the text layout */
+#define PDU_FMT_TEXT_MAX			(PDU_FMT_TEXT_FIXED + 2 * ADDR_OCTET_MAX_LEN + 2 * TIME_STAMP_OCTET_MAX_LEN \
+						+ SMS_GSM7BIT_MAX_LEN * UTF8_CHAR_LEN + 1)
+									/* Worst case of the text of one PDU */
+
+//###########################################################################
+// @PROTOTYPE
+//###########################################################################
+int	PduFmtJson	(const PDU_DESC *pdsc, char *buf, size_t bufSz);
+int	PduFmtJsonKeys	(const PDU_DESC *pdsc, const char *keys, char *buf, size_t bufSz);
+int	PduFmtText	(const PDU_DESC *pdsc, char *buf, size_t bufSz);
+
+#endif	// PDU_FMT_H
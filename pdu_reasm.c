@@ -0,0 +1,530 @@
+/*
+ *   DESCRIPTION:	Concatenated SMS reassembly
+ *
+ *   ABSTRACT:	Every in-flight set of parts lives in a preallocated pool, the pool is
+ *		indexed by an open-addressing (linear probing) hash table of {hash, set}
+ *		slots, removal is done by backward shift so no tombstones are accumulated.
+ *		Sets are linked into a FIFO list in the order of creation, so the oldest set
+ *		is always at the head; timeout and memory budget eviction run from the head.
+ *
+ *		Payload of parts is stored in a per-set buffer in the order of arrival,
+ *		a per-set index keeps {offset, length} for every part number.
+ *
+ *   AUTHOR: AG
+ *
+ *   CREATION DATE: 17-OCT-2026
+ *
+ *   USAGE:	See pdu_reasm.h
+ *
+ *   MODIFICATION HISTORY:
+ *
+ *
+ */
+
+
+//###########################################################################
+// @INCLUDES
+//###########################################################################
+#include	<stdlib.h>
+#include	<string.h>
+
+#include	"pdu_reasm.h"
+
+//###########################################################################
+// @DEFINES
+//###########################################################################
+#define	REASM_MAP_WORDS				(256 / 32)	/* Bitmap of the received parts, 1 - 255 */
+#define	REASM_DATA_MIN				256		/* Initial size of the payload buffer */
+
+//###########################################################################
+// @DATATYPE
+//###########################################################################
+/* Location of a part's payload in the set buffer */
+typedef struct
+{
+	uint32_t	off;
+	uint16_t	len;
+} REASM_PART_DESC;
+
+/* Set of parts of one concatenated message */
+typedef struct
+{
+	uint32_t	hash;						/* Hash of the key */
+	uint32_t	prev, next;					/* FIFO links, 1-based set numbers, 0 - none;
+									** <next> links the free list also */
+	time_t	t0;							/* Arrival time of the first part */
+
+	unsigned char	phoneAddrLen,					/* Key: originator, reference, number of parts */
+		phoneAddr[ADDR_OCTET_MAX_LEN + 1];
+	uint8_t	ref, total;
+
+	uint8_t	phoneTypeOfAddr;
+	uint8_t	usrDataFormat;
+	uint8_t	nparts;							/* Number of received parts */
+	uint32_t	map[REASM_MAP_WORDS];				/* Received parts */
+
+	REASM_PART_DESC	*parts;						/* Index by part number - 1, <total> entries */
+	unsigned char	*data;						/* Payload of parts */
+	uint32_t	dataLen,					/* Used length of <data> */
+		dataSz;							/* Allocated size of <data> */
+} REASM_SET_DESC;
+
+/* Hash table slot */
+typedef struct
+{
+	uint32_t	hash;
+	uint32_t	set;						/* 1-based set number, 0 - empty slot */
+} REASM_SLOT_DESC;
+
+struct __pdu_reasm
+{
+	REASM_SET_DESC	*sets;						/* Sets pool */
+	size_t	nsets;
+	uint32_t	freeSet;					/* Free list head */
+
+	REASM_SLOT_DESC	*slots;						/* Hash table, power of two */
+	size_t	mask;
+
+	uint32_t	head, tail;					/* FIFO, the oldest set is the head */
+
+	size_t	memBudget;
+	int	timeout;
+
+	unsigned char	*mbuf;						/* Buffer for the reassembled message */
+	size_t	mbufSz;
+
+	PDU_REASM_STAT	stat;
+};
+
+
+/*  DESCRIPTION: Calculate hash (FNV-1a) of the set key.
+ *
+ *   INPUTS:
+ *	addr:	originator address
+ *	addrLen: length of the address
+ *	ref:	reference number
+ *	total:	number of parts
+ *
+ *   RETURNS:
+ *	32-bit hash
+ */
+static inline uint32_t __reasm_hash(const unsigned char *addr, int addrLen, uint8_t ref, uint8_t total)
+{
+uint32_t	h = 2166136261U;
+int	i;
+
+	for (i = 0; i < addrLen; i++)
+		h = (h ^ addr[i]) * 16777619U;
+
+	h = (h ^ ref) * 16777619U;
+	h = (h ^ total) * 16777619U;
+
+	return	h;
+}
+
+/*  DESCRIPTION: Lookup a slot of the set with the given key.
+ *
+ *   INPUTS:
+ *	reasm:	reassembly context
+ *	hash:	hash of the key
+ *	pdsc:	decoded part, provides the key
+ *
+ *   RETURNS:
+ *	index of the slot with the set or of the empty slot where the set should be inserted
+ */
+static size_t	__reasm_lookup(const PDU_REASM_DESC *reasm, uint32_t hash, const PDU_DESC *pdsc)
+{
+size_t	i;
+const REASM_SET_DESC *set;
+
+	for (i = hash & reasm->mask; reasm->slots[i].set; i = (i + 1) & reasm->mask)
+		{
+		if ( reasm->slots[i].hash != hash )
+			continue;
+
+		set = &reasm->sets[reasm->slots[i].set - 1];
+
+		if ( (set->ref == pdsc->concateMsgRefNo) && (set->total == pdsc->concateTotalParts)
+			&& (set->phoneAddrLen == pdsc->phoneAddrLen)
+			&& !memcmp(set->phoneAddr, pdsc->phoneAddr, set->phoneAddrLen) )
+			break;
+		}
+
+	return	i;
+}
+
+/*  DESCRIPTION: Remove the slot from the hash table, move the following slots of the probe chain
+ *		backward to keep it without holes.
+ *
+ *   INPUTS:
+ *	reasm:	reassembly context
+ *	i:	index of the slot
+ */
+static void	__reasm_slot_del(PDU_REASM_DESC *reasm, size_t i)
+{
+size_t	j, k;
+
+	for (j = i; ; )
+		{
+		j = (j + 1) & reasm->mask;
+
+		if ( !reasm->slots[j].set )
+			break;
+
+		k = reasm->slots[j].hash & reasm->mask;		/* Home slot of the entry */
+
+		/* Skip the entry if its home slot is cyclically in (i, j] */
+		if ( (i <= j) ? ((i < k) && (k <= j)) : ((i < k) || (k <= j)) )
+			continue;
+
+		reasm->slots[i] = reasm->slots[j];
+		i = j;
+		}
+
+	reasm->slots[i].set = 0;
+}
+
+/*  DESCRIPTION: Release the set: remove it from the hash table and from the FIFO, free memory.
+ *
+ *   INPUTS:
+ *	reasm:	reassembly context
+ *	sno:	1-based set number
+ */
+static void	__reasm_set_free(PDU_REASM_DESC *reasm, uint32_t sno)
+{
+REASM_SET_DESC *set = &reasm->sets[sno - 1];
+size_t	i;
+
+	for (i = set->hash & reasm->mask; reasm->slots[i].set != sno; i = (i + 1) & reasm->mask);
+	__reasm_slot_del(reasm, i);
+
+	if ( set->prev )
+		reasm->sets[set->prev - 1].next = set->next;
+	else	reasm->head = set->next;
+
+	if ( set->next )
+		reasm->sets[set->next - 1].prev = set->prev;
+	else	reasm->tail = set->prev;
+
+	reasm->stat.memUsed -= set->dataSz + set->total * sizeof(REASM_PART_DESC);
+	reasm->stat.inflight--;
+
+	free(set->parts);
+	free(set->data);
+	set->parts = NULL;
+	set->data = NULL;
+
+	set->next = reasm->freeSet;					/* Put into the free list */
+	reasm->freeSet = sno;
+}
+
+/*  DESCRIPTION: Allocate a set for the first part of the message, oldest set is evicted
+ *		if the pool is exhausted; nothing is evicted if there is no memory.
+ *
+ *   INPUTS:
+ *	reasm:	reassembly context
+ *	slot:	index of the empty slot for the set
+ *	hash:	hash of the key
+ *	pdsc:	decoded part
+ *	now:	current time
+ *
+ *   RETURNS:
+ *	1-based set number, 0 - no memory
+ */
+static uint32_t	__reasm_set_new(PDU_REASM_DESC *reasm, size_t slot, uint32_t hash, const PDU_DESC *pdsc, time_t now)
+{
+uint32_t	sno;
+REASM_SET_DESC *set;
+REASM_PART_DESC	*parts;
+
+	if ( !(parts = calloc(pdsc->concateTotalParts, sizeof(REASM_PART_DESC))) )
+		return	0;
+
+	if ( !reasm->freeSet )
+		{
+		__reasm_set_free(reasm, reasm->head);			/* Pool is full - drop the oldest one */
+		reasm->stat.evicted++;
+		slot = __reasm_lookup(reasm, hash, pdsc);		/* The slot may be shifted */
+		}
+
+	sno = reasm->freeSet;
+	set = &reasm->sets[sno - 1];
+	set->parts = parts;
+
+	reasm->freeSet = set->next;
+
+	set->hash = hash;
+	set->t0 = now;
+	set->phoneAddrLen = pdsc->phoneAddrLen;
+	memcpy(set->phoneAddr, pdsc->phoneAddr, pdsc->phoneAddrLen);
+	set->phoneAddr[pdsc->phoneAddrLen] = '\0';
+	set->phoneTypeOfAddr = pdsc->phoneTypeOfAddr;
+	set->ref = pdsc->concateMsgRefNo;
+	set->total = pdsc->concateTotalParts;
+	set->usrDataFormat = pdsc->usrDataFormat;
+	set->nparts = 0;
+	memset(set->map, 0, sizeof(set->map));
+	set->dataLen = set->dataSz = 0;
+
+	reasm->slots[slot].hash = hash;
+	reasm->slots[slot].set = sno;
+
+	set->next = 0;							/* Append to the FIFO */
+	set->prev = reasm->tail;
+
+	if ( reasm->tail )
+		reasm->sets[reasm->tail - 1].next = sno;
+	else	reasm->head = sno;
+
+	reasm->tail = sno;
+
+	reasm->stat.memUsed += set->total * sizeof(REASM_PART_DESC);
+	reasm->stat.inflight++;
+
+	return	sno;
+}
+
+/*  DESCRIPTION: Join payload of all parts of the complete set into the message buffer.
+ *
+ *   INPUTS:
+ *	reasm:	reassembly context
+ *	set:	complete set
+ *
+ *   OUTPUS:
+ *	pMsg:	reassembled message
+ *
+ *   RETURNS:
+ *	TRUE/FALSE - no memory
+ */
+static int	__reasm_set_join(PDU_REASM_DESC *reasm, const REASM_SET_DESC *set, PDU_REASM_MSG_DESC *pMsg)
+{
+unsigned char	*mbuf;
+size_t	len;
+int	i;
+
+	if ( reasm->mbufSz < set->dataLen )
+		{
+		if ( !(mbuf = realloc(reasm->mbuf, set->dataLen)) )
+			return	FALSE;
+
+		reasm->mbuf = mbuf;
+		reasm->mbufSz = set->dataLen;
+		}
+
+	for (len = i = 0; i < set->total; len += set->parts[i].len, i++)
+		memcpy(&reasm->mbuf[len], &set->data[set->parts[i].off], set->parts[i].len);
+
+	pMsg->phoneAddrLen = set->phoneAddrLen;
+	pMsg->phoneTypeOfAddr = set->phoneTypeOfAddr;
+	memcpy(pMsg->phoneAddr, set->phoneAddr, sizeof(pMsg->phoneAddr));
+	pMsg->usrDataFormat = set->usrDataFormat;
+	pMsg->concateMsgRefNo = set->ref;
+	pMsg->concateTotalParts = set->total;
+	pMsg->usrData = reasm->mbuf;
+	pMsg->usrDataLen = len;
+
+	return	TRUE;
+}
+
+//***********************************************************************************************
+// @NAME        : PduReasmCreate
+// @PARAM       : maxSets - maximum number of in-flight (incomplete) sets
+//				  memBudget - maximum number of octets held by in-flight sets, 0 - unlimited
+//				  timeout - seconds to wait for missing parts, 0 - forever
+// @RETURNS     : Reassembly context, NULL on error
+// @DESCRIPTION : This function allocates the sets pool and the hash table, memory for payload is
+//				  allocated on the parts arrival.
+//***********************************************************************************************
+PDU_REASM_DESC	*PduReasmCreate(size_t maxSets, size_t memBudget, int timeout)
+{
+PDU_REASM_DESC	*reasm;
+size_t	nslots, i;
+
+	if ( !maxSets || (maxSets > PDU_REASM_MAX_SETS) )
+		return	NULL;
+
+	for (nslots = 16; nslots < maxSets * 2; nslots <<= 1);	/* Load factor <= 0.5 */
+
+	if ( !(reasm = calloc(1, sizeof(PDU_REASM_DESC))) )
+		return	NULL;
+
+	reasm->sets = calloc(maxSets, sizeof(REASM_SET_DESC));
+	reasm->slots = calloc(nslots, sizeof(REASM_SLOT_DESC));
+
+	if ( !reasm->sets || !reasm->slots )
+		return	PduReasmDestroy(reasm), NULL;
+
+	for (i = 0; i < maxSets; i++)					/* Build the free list */
+		reasm->sets[i].next = (i + 1 < maxSets) ? i + 2 : 0;
+
+	reasm->nsets = maxSets;
+	reasm->freeSet = 1;
+	reasm->mask = nslots - 1;
+	reasm->memBudget = memBudget;
+	reasm->timeout = timeout;
+
+	return	reasm;
+}
+
+//***********************************************************************************************
+// @NAME        : PduReasmDestroy
+// @PARAM       : reasm - reassembly context
+// @RETURNS     : void
+// @DESCRIPTION : This function drops all in-flight sets and releases the context.
+//***********************************************************************************************
+void	PduReasmDestroy(PDU_REASM_DESC *reasm)
+{
+size_t	i;
+
+	if ( !reasm )
+		return;
+
+	for (i = 0; reasm->sets && (i < reasm->nsets); i++)
+		{
+		free(reasm->sets[i].parts);
+		free(reasm->sets[i].data);
+		}
+
+	free(reasm->sets);
+	free(reasm->slots);
+	free(reasm->mbuf);
+	free(reasm);
+}
+
+//***********************************************************************************************
+// @NAME        : PduReasmAdd
+// @PARAM       : reasm - reassembly context
+//				  pdsc - decoded part
+//				  now - current time
+//				  pMsg - reassembled message
+//				  pError - error code, ERR_NONE if the part has been accepted
+// @RETURNS     : TRUE - message is complete, FALSE - message is incomplete or error
+// @DESCRIPTION : This function adds the decoded part into the set of its message. When the last
+//				  missing part arrives the message is returned in the pMsg. Not concatenated
+//				  message is returned as is. Duplicate parts are dropped, the memory budget
+//				  is enforced by eviction of the oldest sets.
+//***********************************************************************************************
+int	PduReasmAdd(PDU_REASM_DESC *reasm, const PDU_DESC *pdsc, time_t now, PDU_REASM_MSG_DESC *pMsg, int *pError)
+{
+uint32_t	hash, sno, sz, cap;
+size_t	slot;
+REASM_SET_DESC *set;
+REASM_PART_DESC *part;
+unsigned char	*data;
+int	partNo;
+
+	*pError = ERR_NONE;
+
+	if ( !pdsc->isConcatenatedMsg )					/* Single message - nothing to do */
+		{
+		pMsg->phoneAddrLen = pdsc->phoneAddrLen;
+		pMsg->phoneTypeOfAddr = pdsc->phoneTypeOfAddr;
+		memcpy(pMsg->phoneAddr, pdsc->phoneAddr, sizeof(pMsg->phoneAddr));
+		pMsg->usrDataFormat = pdsc->usrDataFormat;
+		pMsg->concateMsgRefNo = 0;
+		pMsg->concateTotalParts = 1;
+		pMsg->usrData = pdsc->usrData;
+		pMsg->usrDataLen = pdsc->usrDataLen;
+
+		return	TRUE;
+		}
+
+	partNo = pdsc->concateCurntPart;
+
+	if ( !partNo || (partNo > pdsc->concateTotalParts) || (pdsc->phoneAddrLen > ADDR_OCTET_MAX_LEN) )
+		return	*pError = ERR_CONCAT_PART, (FALSE);
+
+	hash = __reasm_hash(pdsc->phoneAddr, pdsc->phoneAddrLen, pdsc->concateMsgRefNo, pdsc->concateTotalParts);
+	slot = __reasm_lookup(reasm, hash, pdsc);
+
+	if ( !(sno = reasm->slots[slot].set) )
+		if ( !(sno = __reasm_set_new(reasm, slot, hash, pdsc, now)) )
+			return	*pError = ERR_NO_MEMORY, (FALSE);
+
+	set = &reasm->sets[sno - 1];
+
+	if ( set->map[(partNo - 1) >> 5] & (1U << ((partNo - 1) & 31)) )
+		{
+		reasm->stat.duplicates++;
+		return	FALSE;
+		}
+
+	if ( (sz = set->dataLen + pdsc->usrDataLen) > set->dataSz )	/* Grow payload buffer geometrically */
+		{
+		cap = set->dataSz ? 2 * set->dataSz : REASM_DATA_MIN;
+		sz = (sz > cap) ? sz : cap;
+
+		if ( !(data = realloc(set->data, sz)) )
+			return	*pError = ERR_NO_MEMORY, (FALSE);
+
+		reasm->stat.memUsed += sz - set->dataSz;
+		set->data = data;
+		set->dataSz = sz;
+		}
+
+	part = &set->parts[partNo - 1];
+	part->off = set->dataLen;
+	part->len = pdsc->usrDataLen;
+	memcpy(&set->data[part->off], pdsc->usrData, part->len);
+	set->dataLen += part->len;
+
+	set->map[(partNo - 1) >> 5] |= 1U << ((partNo - 1) & 31);
+
+	if ( ++set->nparts == set->total )				/* All parts are here ? */
+		{
+		if ( !__reasm_set_join(reasm, set, pMsg) )
+			return	*pError = ERR_NO_MEMORY, (FALSE);
+
+		__reasm_set_free(reasm, sno);
+		reasm->stat.completed++;
+
+		return	TRUE;
+		}
+
+	/* Enforce the memory budget, the current set is kept */
+	while ( reasm->memBudget && (reasm->stat.memUsed > reasm->memBudget) && (reasm->head != sno) )
+		{
+		__reasm_set_free(reasm, reasm->head);
+		reasm->stat.evicted++;
+		}
+
+	return	FALSE;
+}
+
+//***********************************************************************************************
+// @NAME        : PduReasmExpire
+// @PARAM       : reasm - reassembly context
+//				  now - current time
+// @RETURNS     : Number of dropped sets
+// @DESCRIPTION : This function drops incomplete sets are older than the timeout.
+//***********************************************************************************************
+int	PduReasmExpire(PDU_REASM_DESC *reasm, time_t now)
+{
+int	count = 0;
+
+	if ( !reasm->timeout )
+		return	0;
+
+	/* Sets are in order of creation, so stop at the first fresh one */
+	while ( reasm->head && ((now - reasm->sets[reasm->head - 1].t0) >= reasm->timeout) )
+		{
+		__reasm_set_free(reasm, reasm->head);
+		count++;
+		}
+
+	reasm->stat.expired += count;
+
+	return	count;
+}
+
+//***********************************************************************************************
+// @NAME        : PduReasmStat
+// @PARAM       : reasm - reassembly context
+//				  pStat - counters
+// @RETURNS     : void
+// @DESCRIPTION : This function returns a copy of the context counters.
+//***********************************************************************************************
+void	PduReasmStat(const PDU_REASM_DESC *reasm, PDU_REASM_STAT *pStat)
+{
+	*pStat = reasm->stat;
+}
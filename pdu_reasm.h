@@ -0,0 +1,94 @@
+/*
+ *   DESCRIPTION:	Concatenated SMS reassembly API
+ *
+ *   ABSTRACT:	Decoded parts (PDU_DESC) are bucketed by originator address + reference number +
+ *		number of parts in an open-addressing hash table. A complete message is returned
+ *		when the last missing part arrives. Incomplete sets are evicted by timeout, by
+ *		the memory budget and when the sets pool is exhausted, oldest first.
+ *
+ *   AUTHOR: AG
+ *
+ *   CREATION DATE: 17-OCT-2026
+ *
+ *   USAGE:
+ *		PDU_REASM_DESC	*reasm = PduReasmCreate(256*1024, 64*1024*1024, 600);
+ *
+ *		for ( ... )
+ *			{
+ *			DecodePduData(pdu, &pdsc, &err);
+ *
+ *			if ( PduReasmAdd(reasm, &pdsc, time(NULL), &msg, &err) )
+ *				... msg.usrData, msg.usrDataLen ...
+ *
+ *			PduReasmExpire(reasm, time(NULL));
+ *			}
+ *
+ *		PduReasmDestroy(reasm);
+ *
+ *   MODIFICATION HISTORY:
+ *
+ *
+ */
+#ifndef PDU_REASM_H
+#define PDU_REASM_H
+
+
+//###########################################################################
+// @INCLUDE
+//###########################################################################
+#include <stdint.h>
+#include <stddef.h>
+#include <time.h>
+
+#include "pdu.h"
+
+//###########################################################################
+// @DEFINES
+//###########################################################################
+#define PDU_REASM_MAX_SETS			(16*1024*1024)	/* Upper limit of in-flight sets */
+
+//###########################################################################
+// @DATATYPE
+//###########################################################################
+typedef struct __pdu_reasm	PDU_REASM_DESC;			/* Opaque reassembly context */
+
+/* Reassembled message */
+typedef struct
+{
+	unsigned char	phoneAddrLen,					/* Originator Number length */
+		phoneTypeOfAddr,					/* Type of Address of Originator Number */
+		phoneAddr[ADDR_OCTET_MAX_LEN + 1];			/* Originator Number */
+
+	uint8_t	usrDataFormat;						/* User Data Coding Format of the first part */
+	uint8_t	concateMsgRefNo;					/* Concatenated Message Reference Number */
+	uint8_t	concateTotalParts;					/* Number of parts */
+
+	size_t	usrDataLen;						/* Length of the User Data of all parts */
+	const unsigned char	*usrData;				/* User Data of all parts in order, valid until
+									** the next PduReasmAdd()/PduReasmDestroy() call,
+									** is not NUL-terminated */
+} PDU_REASM_MSG_DESC;
+
+/* Counters */
+typedef struct
+{
+	size_t	inflight;						/* Incomplete sets */
+	size_t	memUsed;						/* Octets are held by the incomplete sets */
+
+	uint64_t	completed,					/* Complete messages returned */
+		duplicates,						/* Duplicate parts were dropped */
+		expired,						/* Sets were dropped by timeout */
+		evicted;						/* Sets were dropped by memory or pool limits */
+} PDU_REASM_STAT;
+
+//###########################################################################
+// @PROTOTYPE
+//###########################################################################
+PDU_REASM_DESC	*PduReasmCreate	(size_t maxSets, size_t memBudget, int timeout);
+void	PduReasmDestroy	(PDU_REASM_DESC *reasm);
+
+int	PduReasmAdd	(PDU_REASM_DESC *reasm, const PDU_DESC *pdsc, time_t now, PDU_REASM_MSG_DESC *pMsg, int *pError);
+int	PduReasmExpire	(PDU_REASM_DESC *reasm, time_t now);
+void	PduReasmStat	(const PDU_REASM_DESC *reasm, PDU_REASM_STAT *pStat);
+
+#endif	// PDU_REASM_H
@@ -0,0 +1,756 @@
+/*
+ *   DESCRIPTION:	Synthetic PDU corpus generator
+ *
+ *   ABSTRACT:	Generates SMS-DELIVER, SMS-SUBMIT and SMS-STATUS-REPORT PDUs with a mix of
+ *		data coding schemes, UDH (concatenation, 8/16-bit application ports), numeric
+ *		and alphanumeric originators and text lengths given by command line options.
+ *		User Data and SMS-SUBMIT headers are made by the encoder internals, so pdu.c
+ *		is compiled into the generator. A long text gives all its concatenated parts
+ *		in order, an escape sequence or a surrogate pair is never split.
+ *
+ *		With -m a given percent of SMS-DELIVER and SMS-STATUS-REPORT PDUs is made
+ *		malformed: truncated TPDU, over-length address, TP-UDL beyond the PDU, UDHL
+ *		beyond the User Data or an IE beyond the UDHL. SMS-SUBMIT PDUs are kept
+ *		well-formed: the decoder rejects them by the message type anyway.
+ *
+ *		The output depends on the options and the seed only, the same seed always
+ *		gives the same corpus. Output formats are the inputs of the bulk decoder:
+ *		one HEX PDU per line or (-b) 2 octets length (network order) + PDU octets.
+ *
+ *   AUTHOR: AG
+ *
+ *   CREATION DATE: 17-OCT-2026
+ *
+ *   USAGE:
+ *		pdugen [-n <pdus>] [-s <seed>] [-b] [-t <deliver>,<submit>,<report>]
+ *			[-d <gsm>,<ucs2>,<8bit>] [-a <alnum %>] [-p <ports %>[,<16bit>,<8bit>]]
+ *			[-l <max>:<weight>,...] [-m <malformed %>] [-o <file>]
+ *
+ *   MODIFICATION HISTORY:
+ *
+ *
+ */
+
+
+//###########################################################################
+// @INCLUDES
+//###########################################################################
+#include	"pdu.c"							/* UD & SUBMIT header encoders are static */
+
+#include	<stdlib.h>
+#include	<unistd.h>
+
+//###########################################################################
+// @DEFINES
+//###########################################################################
+#define	GEN_OUT_BUF				(1024*1024)
+#define	GEN_LEN_BUCKETS_MAX			16
+#define	GEN_TEXT_MAX				(MAX_CONCAT_PARTS * SMS_GSM7BIT_MAX_LEN)
+
+#define	GEN_T_DELIVER				0	/* Message types */
+#define	GEN_T_SUBMIT				1
+#define	GEN_T_REPORT				2
+
+#define	GEN_IEI_CONCAT				0x00	/* Concatenated SM, 8-bit reference */
+#define	GEN_IEI_PORTS8				0x04	/* Application port addressing, 8-bit */
+#define	GEN_IEI_PORTS				0x05	/* Application port addressing, 16-bit */
+
+//###########################################################################
+// @DATATYPE
+//###########################################################################
+/* Options */
+typedef struct
+{
+	unsigned long long	npdus;
+	uint64_t	seed;
+	int	bin;							/* Length-prefixed binary output */
+	unsigned	types[3];					/* Weights of DELIVER, SUBMIT, STATUS-REPORT */
+	unsigned	dcs[3];						/* Weights of GSM 7-bit, UCS-2, 8-bit */
+	unsigned	alnum;						/* % of alphanumeric originators */
+	unsigned	ports;						/* % of messages with application ports */
+	unsigned	portBits[2];					/* Weights of 16-bit and 8-bit ports IE */
+	unsigned	malformed;					/* % of malformed DELIVER & STATUS-REPORT PDUs */
+	int	nlens;							/* Text length buckets: */
+	unsigned	lenMax[GEN_LEN_BUCKETS_MAX];			/* upper bound in characters, */
+	unsigned	lenWeight[GEN_LEN_BUCKETS_MAX];			/* weight */
+} GEN_OPTS_DESC;
+
+/* Output */
+typedef struct
+{
+	FILE	*fp;
+	unsigned char	*buf;
+	size_t	len;
+	unsigned long long	npdus;					/* PDUs written */
+	unsigned long long	limit;					/* PDUs to write */
+} GEN_OUT_DESC;
+
+//###########################################################################
+// @DATA
+//###########################################################################
+static uint64_t	__gen_rnd;						/* splitmix64 state */
+
+/* GSM 7-bit septets with a rough frequency of English text */
+static const char	__gen_gsm_chars[] =
+	"          eeeeeeetttttaaaaooooiiiinnnnssshhhrrrddllcuumwfgypbvk"
+	"EETAOINSHRDLCUMWFGYPBVKJXQZjxqz0123456789012345.,.,!?-:'()";
+
+static const char	*__gen_smsc[] = {"31624000000", "79168999100", "447785016005", "4915200000000", "12063130004"};
+static const char	*__gen_cc[] = {"1", "7", "31", "44", "49", "33", "39", "34", "86", "91"};
+static const char	*__gen_alnum[] = {"BANK", "Uber", "Google", "Amazon", "InfoSMS", "DHL", "Telegram", "VERIFY",
+					"Airline", "MyOperator", "PayPal", "Doctor"};
+
+static inline uint64_t	__gen_u64(void)
+{
+uint64_t	z = (__gen_rnd += 0x9E3779B97F4A7C15ULL);
+
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return	z ^ (z >> 31);
+}
+
+/* Uniform in [0, n) */
+static inline unsigned	__gen_below(unsigned n)
+{
+	return	(unsigned) (((__gen_u64() >> 32) * n) >> 32);
+}
+
+/* Index by weights */
+static unsigned	__gen_pick(const unsigned *weights, int n)
+{
+unsigned	total = 0, r;
+int	i;
+
+	for (i = 0; i < n; i++)
+		total += weights[i];
+
+	r = __gen_below(total ? total : 1);
+
+	for (i = 0; i < n - 1; i++)
+		{
+		if ( r < weights[i] )
+			break;
+
+		r -= weights[i];
+		}
+
+	return	i;
+}
+
+/*
+ *   DESCRIPTION: Put a digits string as swapped semi-octets, F-padded.
+ *
+ *   INPUTS:
+ *	digits:	ASCII digits
+ *	n:	number of digits
+ *	out:	output octets
+ *
+ *   RETURNS:
+ *	number of octets
+ */
+static int	__gen_semioct(const char *digits, int n, uint8_t *out)
+{
+int	i;
+
+	for (i = 0; i < n; i += 2)
+		out[i / 2] = (uint8_t) ((digits[i] - '0') | (((i + 1 < n) ? digits[i + 1] - '0' : 0x0F) << 4));
+
+	return	(n + 1) / 2;
+}
+
+/*
+ *   DESCRIPTION: Make a random phone number with a country code.
+ *
+ *   INPUTS:
+ *	out:	NUL-terminated digits
+ *
+ *   RETURNS:
+ *	number of digits
+ */
+static int	__gen_phone(char *out)
+{
+const char	*cc = __gen_cc[__gen_below(sizeof(__gen_cc) / sizeof(__gen_cc[0]))];
+int	n = (int) strlen(cc), total = 11 + __gen_below(2);
+
+	memcpy(out, cc, n);
+
+	for ( ; n < total; n++)
+		out[n] = (char) ('0' + __gen_below(10));
+
+	out[n] = '\0';
+	return	n;
+}
+
+/*
+ *   DESCRIPTION: Put an address field: length, type, digits; alphanumeric if <alnum>.
+ *
+ *   INPUTS:
+ *	out:	output octets
+ *	alnum:	TRUE - alphanumeric address
+ *
+ *   RETURNS:
+ *	number of octets
+ */
+static int	__gen_addr(uint8_t *out, int alnum)
+{
+char	digits[ADDR_OCTET_MAX_LEN + 1];
+const char	*name;
+int	n, packed;
+
+	if ( alnum )
+		{
+		name = __gen_alnum[__gen_below(sizeof(__gen_alnum) / sizeof(__gen_alnum[0]))];
+		n = (int) strlen(name);				/* Letters are the same in GSM 7-bit */
+		packed = i_Text2Pdu((const uint8_t *) name, n, 0, &out[2], ADDR_OCTET_MAX_LEN);
+
+		out[0] = (uint8_t) ((n * 7 + 3) / 4);			/* Useful semi-octets */
+		out[1] = 0xD0;
+		return	2 + packed;
+		}
+
+	n = __gen_phone(digits);
+	out[0] = (uint8_t) n;
+	out[1] = 0x91;
+
+	return	2 + __gen_semioct(digits, n, &out[2]);
+}
+
+/*
+ *   DESCRIPTION: Put a random time stamp in semi-octets.
+ *
+ *   INPUTS:
+ *	out:	7 octets
+ *
+ *   RETURNS:
+ *	7
+ */
+static int	__gen_scts(uint8_t *out)
+{
+unsigned	v[7] = {26, 1 + __gen_below(12), 1 + __gen_below(28), __gen_below(24), __gen_below(60), __gen_below(60),
+			__gen_below(4 * 14)};
+int	i;
+
+	for (i = 0; i < 7; i++)
+		out[i] = (uint8_t) ((v[i] / 10) | ((v[i] % 10) << 4));
+
+	return	7;
+}
+
+/*
+ *   DESCRIPTION: Make a random text: GSM 7-bit septets (with escapes), UCS-2 code
+ *	units in big-endian order (with surrogate pairs) or octets.
+ *
+ *   INPUTS:
+ *	fmt:	GSM_7BIT, UCS2_16BIT or ANSI_8BIT
+ *	nchars:	number of characters
+ *	out:	output
+ *
+ *   RETURNS:
+ *	number of septets/octets
+ */
+static int	__gen_text(int fmt, int nchars, uint8_t *out)
+{
+unsigned	c, r;
+int	i, n = 0;
+
+	for (i = 0; i < nchars; i++)
+		{
+		r = __gen_below(1000);
+
+		if ( fmt == GSM_7BIT )
+			{
+			if ( r < 5 )					/* Extension table: EUR, {, } */
+				{
+				out[n++] = 0x1B;
+				out[n++] = (r < 3) ? 0x65 : (r < 4) ? 0x28 : 0x29;
+				}
+			else	out[n++] = (uint8_t) __gen_gsm_chars[__gen_below(sizeof(__gen_gsm_chars) - 1)];
+			}
+		else if ( fmt == UCS2_16BIT )
+			{
+			if ( r < 10 )					/* Emoji as a surrogate pair */
+				{
+				c = 0xDE00 + __gen_below(0x50);
+				out[n++] = 0xD8;
+				out[n++] = 0x3D;
+				}
+			else if ( r < 150 )
+				c = 0x20;
+			else if ( r < 200 )
+				c = "0123456789.,!?"[__gen_below(14)];
+			else	c = 0x0410 + __gen_below(0x40);			/* Cyrillic */
+
+			out[n++] = (uint8_t) (c >> 8);
+			out[n++] = (uint8_t) c;
+			}
+		else	out[n++] = (uint8_t) __gen_u64();
+		}
+
+	return	n;
+}
+
+/*
+ *   DESCRIPTION: Append the PDU to the output.
+ *
+ *   INPUTS:
+ *	out:	output
+ *	pdu:	PDU octets
+ *	len:	number of octets
+ *	bin:	TRUE - length-prefixed binary, FALSE - HEX line
+ *
+ *   RETURNS:
+ *	NONE
+ */
+static void	__gen_put(GEN_OUT_DESC *out, const uint8_t *pdu, int len, int bin)
+{
+	if ( out->npdus >= out->limit )					/* Parts of the last message over the limit */
+		return;
+
+	if ( out->len + 2 * SMS_PDU_MAX_LEN + 2 > GEN_OUT_BUF )
+		{
+		if ( out->len != fwrite(out->buf, 1, out->len, out->fp) )
+			{
+			perror("Output");
+			exit(EXIT_FAILURE);
+			}
+
+		out->len = 0;
+		}
+
+	if ( bin )
+		{
+		out->buf[out->len++] = (unsigned char) (len >> 8);
+		out->buf[out->len++] = (unsigned char) len;
+		memcpy(&out->buf[out->len], pdu, len);
+		out->len += len;
+		}
+	else	{
+		out->len += __bin2hex(pdu, len, &out->buf[out->len]);
+		out->buf[out->len++] = '\n';
+		}
+
+	out->npdus++;
+}
+
+/*
+ *   DESCRIPTION: Make the well-formed SMS-DELIVER or SMS-STATUS-REPORT malformed in a random
+ *	way, so the corpus exercises the framing checks of the decoder.
+ *
+ *   INPUTS:
+ *	pdu:	PDU octets
+ *	len:	number of octets
+ *	fo:	offset of the first octet
+ *	oa:	offset of the TP-OA/TP-RA length octet
+ *	udl:	offset of the TP-UDL, -1 - there is no User Data (STATUS-REPORT)
+ *
+ *   RETURNS:
+ *	new number of octets
+ */
+static int	__gen_malform(uint8_t *pdu, int len, int fo, int oa, int udl)
+{
+	switch ( __gen_below((udl < 0) ? 2 : 5) )
+		{
+		case	0:						/* Truncated TPDU */
+			return	oa + 1 + (int) __gen_below(len - oa - 1);
+
+		case	1:						/* Address over ADDR_OCTET_MAX_LEN digits */
+			pdu[oa] = (uint8_t) (ADDR_OCTET_MAX_LEN + 1 + __gen_below(256 - ADDR_OCTET_MAX_LEN - 1));
+			return	len;
+
+		case	2:						/* TP-UDL beyond any User Data */
+			pdu[udl] = (uint8_t) (SMS_GSM7BIT_MAX_LEN + 1 + __gen_below(256 - SMS_GSM7BIT_MAX_LEN - 1));
+			return	len;
+
+		case	3:						/* UDHL beyond the User Data */
+			if ( len > udl + 1 )
+				{
+				pdu[fo] |= USER_DATA_HEADER_INDICATION;
+				pdu[udl + 1] = (uint8_t) (len - udl - 1 + __gen_below(256 - (len - udl - 1)));
+				return	len;
+				}
+			break;
+
+		default:						/* IE beyond the UDHL */
+			if ( (pdu[fo] & USER_DATA_HEADER_INDICATION) && (len > udl + 3) && (pdu[udl + 1] >= 2) )
+				{
+				pdu[udl + 3] = (uint8_t) (pdu[udl + 1] - 1 + __gen_below(256 - pdu[udl + 1] + 1));
+				return	len;
+				}
+			break;
+		}
+
+	return	oa + 1 + (int) __gen_below(len - oa - 1);		/* Truncate if no room for the chosen way */
+}
+
+/*
+ *   DESCRIPTION: Generate one STATUS-REPORT.
+ *
+ *   INPUTS:
+ *	opts:	options
+ *	out:	output
+ *
+ *   RETURNS:
+ *	NONE
+ */
+static void	__gen_report(const GEN_OPTS_DESC *opts, GEN_OUT_DESC *out)
+{
+static const uint8_t	sts[] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x30, 0x41, 0x45, 0x60};
+const char	*smsc = __gen_smsc[__gen_below(sizeof(__gen_smsc) / sizeof(__gen_smsc[0]))];
+uint8_t	pdu[SMS_PDU_MAX_LEN];
+int	idx = 0;
+
+	pdu[0] = 1 + (uint8_t) ((strlen(smsc) + 1) / 2);
+	pdu[1] = 0x91;
+	idx = 2 + __gen_semioct(smsc, (int) strlen(smsc), &pdu[2]);
+
+	pdu[idx++] = 0x06;						/* SMS-STATUS-REPORT, no more messages */
+	pdu[idx++] = (uint8_t) __gen_below(256);			/* TP-MR */
+	idx += __gen_addr(&pdu[idx], FALSE);				/* TP-RA */
+	idx += __gen_scts(&pdu[idx]);					/* TP-SCTS */
+	idx += __gen_scts(&pdu[idx]);					/* TP-DT */
+	pdu[idx++] = sts[__gen_below(sizeof(sts))];			/* TP-ST */
+
+	if ( opts->malformed && (__gen_below(100) < opts->malformed) )
+		idx = __gen_malform(pdu, idx, pdu[0] + 1, pdu[0] + 3, -1);
+
+	__gen_put(out, pdu, idx, opts->bin);
+}
+
+/*
+ *   DESCRIPTION: Generate one message, a long text gives all its parts.
+ *
+ *   INPUTS:
+ *	opts:	options
+ *	out:	output
+ *	type:	GEN_T_DELIVER or GEN_T_SUBMIT
+ *	ref:	concatenated message reference
+ *
+ *   RETURNS:
+ *	NONE
+ */
+static void	__gen_message(const GEN_OPTS_DESC *opts, GEN_OUT_DESC *out, int type, uint8_t ref)
+{
+static const int	fmts[3] = {GSM_7BIT, UCS2_16BIT, ANSI_8BIT};
+static uint8_t	text[GEN_TEXT_MAX * 2];
+PDU_DESC	pdsc;
+uint8_t	pdu[SMS_PDU_MAX_LEN + 8], udh[16], hdr[64];
+int	fmt, bucket, lo, nchars, tlen, udhLen = 0, ports, per, nparts, i, off, cut, hlen, tidx, flash, foIdx = 0;
+uint8_t	fo;
+
+	fmt = fmts[__gen_pick(opts->dcs, 3)];
+	bucket = __gen_pick(opts->lenWeight, opts->nlens);
+	lo = bucket ? opts->lenMax[bucket - 1] : 0;
+	nchars = lo + 1 + __gen_below(opts->lenMax[bucket] - lo);
+	nchars = (nchars > GEN_TEXT_MAX / 2) ? GEN_TEXT_MAX / 2 : nchars;
+	tlen = __gen_text(fmt, nchars, text);
+
+	if ( (ports = (__gen_below(100) < opts->ports)) && __gen_pick(opts->portBits, 2) )	/* Ports IE goes first */
+		{
+		udh[udhLen++] = GEN_IEI_PORTS8;
+		udh[udhLen++] = 2;
+		udh[udhLen++] = (uint8_t) (240 + __gen_below(16));		/* Destination & originator ports */
+		udh[udhLen++] = (uint8_t) (240 + __gen_below(16));		/* of the 240-255 application range */
+		}
+	else if ( ports )
+		{
+		udh[udhLen++] = GEN_IEI_PORTS;
+		udh[udhLen++] = 4;
+		udh[udhLen++] = 0x0B;					/* WAP push destination port 2948 */
+		udh[udhLen++] = 0x84;
+		udh[udhLen++] = (uint8_t) __gen_below(256);
+		udh[udhLen++] = (uint8_t) __gen_below(256);
+		}
+
+	/* Capacity of one part in septets/octets */
+	per = (fmt == GSM_7BIT) ? SMS_GSM7BIT_MAX_LEN - (udhLen ? ((1 + udhLen) * 8 + 6) / 7 : 0)
+		: SMS_PDU_USER_DATA_MAX_LEN - (udhLen ? 1 + udhLen : 0);
+
+	if ( tlen > per )						/* Concatenated */
+		{
+		udh[udhLen++] = GEN_IEI_CONCAT;
+		udh[udhLen++] = 3;
+		udh[udhLen++] = ref;
+		udhLen += 2;						/* Total & sequence are set per part */
+
+		per = (fmt == GSM_7BIT) ? SMS_GSM7BIT_MAX_LEN - ((1 + udhLen) * 8 + 6) / 7 : SMS_PDU_USER_DATA_MAX_LEN - 1 - udhLen;
+		per &= (fmt == UCS2_16BIT) ? ~1 : ~0;
+
+		/* Count parts first, boundaries are moved back off escapes & surrogate pairs */
+		for (off = nparts = 0; off < tlen; off = cut, nparts++)
+			{
+			cut = (off + per < tlen) ? off + per : tlen;
+
+			if ( (cut < tlen) && (fmt == GSM_7BIT) && (text[cut - 1] == 0x1B) )
+				cut--;
+			else if ( (cut < tlen) && (fmt == UCS2_16BIT) && ((text[cut - 2] & 0xFC) == 0xD8) )
+				cut -= 2;
+			}
+
+		if ( nparts > MAX_CONCAT_PARTS )
+			nparts = MAX_CONCAT_PARTS;				/* Limited by GEN_TEXT_MAX, should not happen */
+		}
+	else	nparts = 1;
+
+	/* Header of all parts */
+	flash = (fmt == GSM_7BIT) && (__gen_below(100) == 0);
+	memset(&pdsc, 0, sizeof(pdsc));
+
+	if ( type == GEN_T_SUBMIT )
+		{
+		if ( __gen_below(3) )
+			{
+			strcpy((char *) pdsc.smscAddr, __gen_smsc[__gen_below(sizeof(__gen_smsc) / sizeof(__gen_smsc[0]))]);
+			pdsc.smscAddrLen = (uint8_t) strlen((char *) pdsc.smscAddr);
+			pdsc.smscTypeOfAddr = NUM_TYPE_INTERNATIONAL;
+			}
+
+		pdsc.phoneAddrLen = (uint8_t) __gen_phone((char *) pdsc.phoneAddr);
+		pdsc.phoneTypeOfAddr = NUM_TYPE_INTERNATIONAL;
+		pdsc.isFlashMsg = (uint8_t) flash;
+
+		if ( __gen_below(2) )
+			{
+			pdsc.vldtPrdFrmt = VLDTY_PERIOD_RELATIVE;
+			pdsc.vldtPrd = 167;					/* 24 hours */
+			}
+
+		hlen = __pdu_encode_hdr(&pdsc, fmt, udhLen != 0, __gen_below(10) == 0, hdr, &tidx);
+		}
+	else	{
+		const char	*smsc = __gen_smsc[__gen_below(sizeof(__gen_smsc) / sizeof(__gen_smsc[0]))];
+
+		hdr[0] = 1 + (uint8_t) ((strlen(smsc) + 1) / 2);
+		hdr[1] = 0x91;
+		hlen = 2 + __gen_semioct(smsc, (int) strlen(smsc), &hdr[2]);
+
+		fo = 0x04;						/* SMS-DELIVER, no more messages */
+		fo |= udhLen ? USER_DATA_HEADER_INDICATION : 0;
+		foIdx = hlen;
+		hdr[hlen++] = fo;
+
+		hlen += __gen_addr(&hdr[hlen], __gen_below(100) < opts->alnum);
+		hdr[hlen++] = 0x00;					/* TP-PID */
+		hdr[hlen++] = (uint8_t) ((fmt << 2) | (flash ? 0x10 : 0));	/* TP-DCS */
+		hlen += __gen_scts(&hdr[hlen]);
+		}
+
+	for (i = off = 0; i < nparts; i++, off = cut)
+		{
+		cut = (off + per < tlen) ? off + per : tlen;
+
+		if ( (cut < tlen) && (fmt == GSM_7BIT) && (text[cut - 1] == 0x1B) )
+			cut--;
+		else if ( (cut < tlen) && (fmt == UCS2_16BIT) && ((text[cut - 2] & 0xFC) == 0xD8) )
+			cut -= 2;
+
+		if ( nparts > 1 )
+			{
+			udh[udhLen - 2] = (uint8_t) nparts;
+			udh[udhLen - 1] = (uint8_t) (i + 1);
+			}
+
+		memcpy(pdu, hdr, hlen);
+		tidx = hlen + __pdu_encode_ud(&text[off], cut - off, fmt, udh, udhLen, &pdu[hlen], sizeof(pdu) - hlen);
+
+		if ( (type == GEN_T_DELIVER) && opts->malformed && (__gen_below(100) < opts->malformed) )
+			tidx = __gen_malform(pdu, tidx, foIdx, foIdx + 1, hlen);
+
+		__gen_put(out, pdu, tidx, opts->bin);
+		}
+}
+
+/*
+ *   DESCRIPTION: Parse a list of weights "w1,w2,..."
+ *
+ *   INPUTS:
+ *	arg:	option value
+ *	out:	weights
+ *	n:	number of weights
+ *
+ *   RETURNS:
+ *	0/-1
+ */
+static int	__gen_weights(const char *arg, unsigned *out, int n)
+{
+char	*end;
+int	i;
+
+	for (i = 0; i < n; i++)
+		{
+		out[i] = (unsigned) strtoul(arg, &end, 10);
+
+		if ( (end == arg) || ((i < n - 1) ? (*end != ',') : (*end != '\0')) )
+			return	-1;
+
+		arg = end + 1;
+		}
+
+	return	0;
+}
+
+/*
+ *   DESCRIPTION: Parse length buckets "max:weight,..." with increasing <max>.
+ *
+ *   INPUTS:
+ *	arg:	option value
+ *	opts:	options
+ *
+ *   RETURNS:
+ *	0/-1
+ */
+static int	__gen_lens(const char *arg, GEN_OPTS_DESC *opts)
+{
+char	*end;
+unsigned	prev = 0;
+
+	for (opts->nlens = 0; *arg && (opts->nlens < GEN_LEN_BUCKETS_MAX); opts->nlens++)
+		{
+		opts->lenMax[opts->nlens] = (unsigned) strtoul(arg, &end, 10);
+
+		if ( (end == arg) || (*end != ':') || (opts->lenMax[opts->nlens] <= prev) )
+			return	-1;
+
+		prev = opts->lenMax[opts->nlens];
+		arg = end + 1;
+		opts->lenWeight[opts->nlens] = (unsigned) strtoul(arg, &end, 10);
+
+		if ( (end == arg) || ((*end != ',') && (*end != '\0')) )
+			return	-1;
+
+		arg = *end ? end + 1 : end;
+		}
+
+	return	(opts->nlens && !*arg) ? 0 : -1;
+}
+
+static void	__usage(const char *prog)
+{
+	fprintf(stderr, "Usage: %s [-n <pdus>] [-s <seed>] [-b] [-t <deliver>,<submit>,<report>]\n"
+		"\t[-d <gsm>,<ucs2>,<8bit>] [-a <alnum %%>] [-p <ports %%>[,<16bit>,<8bit>]]\n"
+		"\t[-l <max>:<weight>,...] [-m <malformed %%>] [-o <file>]\n"
+		"\t-n\tnumber of PDUs, default is 1000000\n"
+		"\t-s\tseed, the same seed gives the same output, default is 1\n"
+		"\t-b\tlength-prefixed binary output, default is one HEX PDU per line\n"
+		"\t-t\tweights of message types, default is 80,15,5\n"
+		"\t-d\tweights of data coding schemes, default is 60,35,5\n"
+		"\t-a\tpercent of alphanumeric originators of SMS-DELIVER, default is 15\n"
+		"\t-p\tpercent of messages with application ports UDH and weights of 16-bit & 8-bit\n"
+		"\t\tports IEs, default is 2,50,50\n"
+		"\t-l\ttext length buckets in characters, default is 40:55,160:30,400:12,1200:3\n"
+		"\t-m\tpercent of malformed SMS-DELIVER & SMS-STATUS-REPORT PDUs, default is 0\n"
+		"\t-o\toutput file, default is stdout\n", prog);
+}
+
+int	main(int argc, char **argv)
+{
+GEN_OPTS_DESC	opts = {.npdus = 1000000ULL, .seed = 1, .types = {80, 15, 5}, .dcs = {60, 35, 5}, .alnum = 15, .ports = 2,
+		.portBits = {50, 50}};
+GEN_OUT_DESC	out = {.fp = stdout};
+const char	*fname = NULL;
+char	*end;
+uint8_t	ref = 0;
+int	opt;
+
+	__gen_lens("40:55,160:30,400:12,1200:3", &opts);
+
+	while ( -1 != (opt = getopt(argc, argv, "n:s:bt:d:a:p:l:m:o:")) )
+		{
+		switch ( opt )
+			{
+			case	'n':	opts.npdus = strtoull(optarg, NULL, 10); break;
+			case	's':	opts.seed = strtoull(optarg, NULL, 0); break;
+			case	'b':	opts.bin = 1; break;
+			case	'a':	opts.alnum = (unsigned) atoi(optarg); break;
+			case	'p':
+				opts.ports = (unsigned) strtoul(optarg, &end, 10);
+
+				if ( (end == optarg) || (*end && ((*end != ',') || __gen_weights(end + 1, opts.portBits, 2))) )
+					{
+					__usage(argv[0]);
+					return	EXIT_FAILURE;
+					}
+				break;
+
+			case	'm':	opts.malformed = (unsigned) atoi(optarg); break;
+			case	'o':	fname = optarg; break;
+
+			case	't':
+				if ( __gen_weights(optarg, opts.types, 3) )
+					{
+					__usage(argv[0]);
+					return	EXIT_FAILURE;
+					}
+				break;
+
+			case	'd':
+				if ( __gen_weights(optarg, opts.dcs, 3) )
+					{
+					__usage(argv[0]);
+					return	EXIT_FAILURE;
+					}
+				break;
+
+			case	'l':
+				if ( __gen_lens(optarg, &opts) )
+					{
+					__usage(argv[0]);
+					return	EXIT_FAILURE;
+					}
+				break;
+
+			default:	__usage(argv[0]); return EXIT_FAILURE;
+			}
+		}
+
+	if ( optind != argc )
+		{
+		__usage(argv[0]);
+		return	EXIT_FAILURE;
+		}
+
+	if ( fname && !(out.fp = fopen(fname, "wb")) )
+		{
+		perror(fname);
+		return	EXIT_FAILURE;
+		}
+
+	if ( !(out.buf = malloc(GEN_OUT_BUF)) )
+		{
+		fprintf(stderr, "Cannot allocate output buffer\n");
+		return	EXIT_FAILURE;
+		}
+
+	out.limit = opts.npdus;
+	__gen_rnd = opts.seed;
+	__pdu_cpu_select(0);						/* Scalar kernels, the output does not depend on the CPU */
+
+	while ( out.npdus < opts.npdus )
+		{
+		switch ( __gen_pick(opts.types, 3) )
+			{
+			case	GEN_T_REPORT:
+				__gen_report(&opts, &out);
+				break;
+
+			case	GEN_T_SUBMIT:
+				__gen_message(&opts, &out, GEN_T_SUBMIT, ref++);
+				break;
+
+			default:
+				__gen_message(&opts, &out, GEN_T_DELIVER, ref++);
+			}
+		}
+
+	if ( (out.len != fwrite(out.buf, 1, out.len, out.fp)) || fflush(out.fp) )
+		{
+		perror("Output");
+		return	EXIT_FAILURE;
+		}
+
+	if ( out.fp != stdout )
+		fclose(out.fp);
+
+	free(out.buf);
+
+	return	EXIT_SUCCESS;
+}
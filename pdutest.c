@@ -0,0 +1,301 @@
+/*
+ *   DESCRIPTION:	Checks of the PDU decoding paths on the sample PDUs
+ *
+ *   ABSTRACT:	Every sample PDU is decoded by DecodePduData() and by the other decoding
+ *		paths of pdu.c: the zero-copy view with its PduView*() accessors and
+ *		PduViewToDesc(), PDU_F_HDR_ONLY decoding completed by DecodePduUsrData(),
+ *		the compact header of DecodePduHdrBin() expanded by PduHdrToDesc(). Every path
+ *		must give the same fields as DecodePduData(), PDU_F_HDR_ONLY decoding must
+ *		leave the text empty for every data coding. Every mismatch is reported with
+ *		the PDU, the exit code is non-zero if any check fails.
+ *
+ *		Samples are SMS-DELIVER and SMS-STATUS-REPORT PDUs in GSM 7-bit, UCS-2 and
+ *		8-bit, with concatenation and 8/16-bit application port IEs, numeric and
+ *		alphanumeric originators.
+ *
+ *   AUTHOR: AG
+ *
+ *   CREATION DATE: 17-OCT-2026
+ *
+ *   USAGE:
+ *		make test
+ *		./pdutest
+ *
+ *   MODIFICATION HISTORY:
+ *
+ *
+ */
+
+
+//###########################################################################
+// @INCLUDES
+//###########################################################################
+#include	<stdio.h>
+#include	<stdlib.h>
+#include	<string.h>
+
+#include	"pdu.h"
+
+//###########################################################################
+// @DEFINES
+//###########################################################################
+#define	TEST_FILL				0xA5	/* Descriptor contents before decoding */
+
+#define	TEST_CHECK(cond)			__test_check((cond), #cond, __func__, __LINE__)
+
+//###########################################################################
+// @DATA
+//###########################################################################
+static const char	*__test_pdus[] = {
+	/* SMS-DELIVER, GSM 7-bit */
+	"07911326040000F0040B911346610089F60000208062917314080CC8F71D14969741F977FD07",
+	/* SMS-DELIVER, alphanumeric originator */
+	"0791448720003023240DD0E474D81C0EBB010000111011315214000BE474D81C0EBB5DE3771B",
+	/* SMS-DELIVER, GSM 7-bit */
+	"07919730071111F1000B919746121611F10000811170021222230DC8329BFD6681EE6F399B1C02",
+	/* SMS-STATUS-REPORT */
+	"0006D60B911326880736F4111011719551401110117195714000",
+	/* SMS-DELIVER, UCS-2, part 1 of 2 */
+	"07911326040000F0440B911346610089F60008208062917314080E0500030A02010048006500720065",
+	/* SMS-DELIVER, 8-bit */
+	"07911326040000F0040B911346610089F60004208062917314080548656C6C6F",
+	/* SMS-DELIVER, GSM 7-bit, alphanumeric originator, part 2 of 2 */
+	"07911326040000F04406D0442413000062216120816112390500030E0202D8F5F92D36A55FE9EDB43B5E0F35CDE528B3BECCB7DBAE"
+		"7030BD5CA2E9305C2D4C666DCA5A37FD3837E6AC6E",
+	/* SMS-DELIVER, GSM 7-bit, 8-bit ports, part 2 of 2 */
+	"07912160130300F4440C9133374178397300006280717152211325090402F6F800033F02021095BFD753E1B02C7359876958908D22"
+		"CB9D2E506C5306",
+	/* SMS-DELIVER, GSM 7-bit, 16-bit ports, part 2 of 2 */
+	"07912160130300F4440B919753185861F90000621032202455511D0B05040B8418590003D70202D0B161902D8DAE1D63CC505DEE06",
+	/* SMS-DELIVER, 8-bit, 8-bit ports */
+	"0891945102000000F0440B918119980853F700046211024144203012040402F6F6E498F592789351D0FDFFB774C9",
+	/* SMS-DELIVER, 8-bit, 16-bit ports, part 2 of 2 */
+	"07911326040000F0440B914348173682F80004626012405371543F0B05040B841442000317020256E9C40495647C5D8487B4BC5EC4"
+		"E80A5B366346075794EC432AF3D38D04F14043FB6F64779339B8D5A205D19849A9D413C0E2",
+	/* SMS-DELIVER, UCS-2, 8-bit ports */
+	"0791447758100650440C9193052518722000086201327171543217040402F1F1043F0445043C0433042A00330036044A041D",
+	/* SMS-DELIVER, UCS-2, 16-bit ports, surrogate pair, part 3 of 3 */
+	"0791447758100650440C91197182291223000862504060329240180B05040B8447FD0003370303D83DDE27043E0433043D0418",
+	/* SMS-DELIVER, UCS-2, part 3 of 3 */
+	"07911326040000F0440C916865217568700008627090916354604205000353030304120419042300200410003204270020041804"
+		"250415041904220426043E041000200416042B0445041E044C041D002004410411042F041204390031",
+};
+
+static	int	__test_nchecks, __test_nfails;
+static	const char	*__test_pdu;					/* Sample being checked */
+
+/*  DESCRIPTION: Count the check, report a failed one with the sample PDU.
+ *
+ *  INPUTS:
+ *	cond:	Result of the check
+ *	expr:	Text of the check
+ *	func:	Name of the test
+ *	line:	Line of the check
+ *
+ *  RETURNS:
+ *	cond
+ */
+static	int	__test_check(int cond, const char *expr, const char *func, int line)
+{
+	__test_nchecks++;
+
+	if ( !cond )
+		{
+		__test_nfails++;
+		fprintf(stderr, "FAIL %s:%d: %s, PDU %s\n", func, line, expr, __test_pdu);
+		}
+
+	return	cond;
+}
+
+/*  DESCRIPTION: Convert the HEX PDU to octets.
+ *
+ *  INPUTS:
+ *	hex:	HEX PDU, valid
+ *
+ *  OUTPUS:
+ *	bin:	PDU octets, SMS_PDU_MAX_LEN octets
+ *
+ *  RETURNS:
+ *	number of octets
+ */
+static	int	__test_hex2bin(const char *hex, uint8_t *bin)
+{
+int	i, n = (int) strlen(hex) / 2;
+
+	for (i = 0; i < n; i++)
+		sscanf(&hex[i * 2], "%2hhx", &bin[i]);
+
+	return	n;
+}
+
+/*  DESCRIPTION: Compare two decoded PDUs: all fields and the text, the tail of the text
+ *	buffer behind the NUL is not compared.
+ *
+ *  INPUTS:
+ *	a, b:	PDU descriptors, both reset by a decoder
+ *
+ *  RETURNS:
+ *	TRUE - descriptors are the same
+ */
+static	int	__test_same(const PDU_DESC *a, const PDU_DESC *b)
+{
+	return	!memcmp(a, b, offsetof(PDU_DESC, usrData))
+		&& !memcmp(a->usrData, b->usrData, a->usrDataLen + 1)
+		&& !memcmp(&a->udhLen, &b->udhLen, sizeof(PDU_DESC) - offsetof(PDU_DESC, udhLen));
+}
+
+/*  DESCRIPTION: The view and its accessors give the same fields as DecodePduData().
+ *
+ *  INPUTS:
+ *	pdsc:	PDU decoded by DecodePduData()
+ *	bin:	PDU octets
+ *	len:	number of octets
+ */
+static	void	__test_view(const PDU_DESC *pdsc, const uint8_t *bin, int len)
+{
+PDU_VIEW	view;
+PDU_DESC	vdsc;
+unsigned char	buf[sizeof(pdsc->usrData)];
+const uint8_t	*data;
+int	err, i, j, n;
+
+	if ( !TEST_CHECK(DecodePduView(bin, len, 0, &view, &err)) )
+		return;
+
+	TEST_CHECK(PduViewToDesc(&view, &vdsc, &err) && __test_same(&vdsc, pdsc));
+
+	TEST_CHECK(view.msgType == pdsc->msgType);
+	TEST_CHECK(view.usrDataFormat == pdsc->usrDataFormat);
+	TEST_CHECK(PDU_VIEW_OCTET(&view, fo) == pdsc->firstOct);
+	TEST_CHECK(PDU_VIEW_OCTET(&view, pid) == pdsc->protocolId);
+	TEST_CHECK(PDU_VIEW_OCTET(&view, dcs) == pdsc->dataCodeScheme);
+
+	if ( view.st != PDU_VIEW_NONE )
+		TEST_CHECK(pdsc->smsSts == (PDU_VIEW_OCTET(&view, st) ? MSG_DELIVERY_FAIL : MSG_DELIVERY_SUCCESS));
+
+	n = PduViewSmscAddr(&view, buf);
+	TEST_CHECK((n == (int) strlen((char *) pdsc->smscAddr)) && !memcmp(buf, pdsc->smscAddr, n + 1));
+
+	n = PduViewOrigAddr(&view, buf);
+	TEST_CHECK((n == (int) strlen((char *) pdsc->phoneAddr)) && !memcmp(buf, pdsc->phoneAddr, n + 1));
+
+	if ( view.scts != PDU_VIEW_NONE )
+		{
+		n = PduViewTimeStamp(&view, buf);
+		TEST_CHECK((n == TIME_STAMP_OCTET_MAX_LEN) && !memcmp(buf, pdsc->timeStamp, n));
+		}
+
+	n = PduViewUsrData(&view, buf, sizeof(buf));
+	TEST_CHECK((n == pdsc->usrDataLen) && !memcmp(buf, pdsc->usrData, n));
+
+	for (i = 0; i < pdsc->udhIeNum; i++)				/* The first IE of every type is found */
+		{
+		for (j = 0; (j < i) && (pdsc->udhIe[j].type != pdsc->udhIe[i].type); j++);
+
+		if ( j < i )
+			continue;
+
+		TEST_CHECK(PduViewUdhIe(&view, pdsc->udhIe[i].type, &data) == pdsc->udhIe[i].len);
+		TEST_CHECK(data == &bin[view.udh + pdsc->udhIe[i].off]);
+		}
+
+	TEST_CHECK(PduViewUdhIe(&view, 0xFF, &data) == -1);		/* Reserved IEI is never generated */
+}
+
+/*  DESCRIPTION: PDU_F_HDR_ONLY decoding gives the fields of DecodePduData() and leaves the
+ *	text empty and the text buffer untouched, DecodePduUsrData() completes the text.
+ *
+ *  INPUTS:
+ *	pdsc:	PDU decoded by DecodePduData()
+ *	bin:	PDU octets
+ *	len:	number of octets
+ */
+static	void	__test_hdr_only(const PDU_DESC *pdsc, const uint8_t *bin, int len)
+{
+PDU_DESC	hdsc;
+size_t	i;
+int	err;
+
+	memset(&hdsc, TEST_FILL, sizeof(hdsc));
+
+	if ( !TEST_CHECK(DecodePduDataBin(bin, len, PDU_F_HDR_ONLY, &hdsc, &err)) )
+		return;
+
+	TEST_CHECK(hdsc.usrDataLen == 0);
+	TEST_CHECK(hdsc.usrData[0] == '\0');
+
+	for (i = 1; (i < sizeof(hdsc.usrData)) && (hdsc.usrData[i] == TEST_FILL); i++);
+
+	TEST_CHECK(i == sizeof(hdsc.usrData));
+
+	TEST_CHECK(!memcmp(&hdsc, pdsc, offsetof(PDU_DESC, usrDataLen)));
+	TEST_CHECK(!memcmp(&hdsc.udhLen, &pdsc->udhLen, sizeof(PDU_DESC) - offsetof(PDU_DESC, udhLen)));
+
+	TEST_CHECK(DecodePduUsrData(bin, len, 0, &hdsc, &err) && __test_same(&hdsc, pdsc));
+}
+
+/*  DESCRIPTION: The compact header expanded by PduHdrToDesc() gives the fields of
+ *	DecodePduData(), but the UDH IE list which PduHdrToDesc() does not fill.
+ *
+ *  INPUTS:
+ *	pdsc:	PDU decoded by DecodePduData()
+ *	bin:	PDU octets
+ *	len:	number of octets
+ */
+static	void	__test_hdr(const PDU_DESC *pdsc, const uint8_t *bin, int len)
+{
+PDU_DESC	hdsc, want;
+PDU_HDR	hdr;
+PDU_ARENA	arena;
+unsigned char	abuf[sizeof(hdsc.usrData)];
+int	err;
+
+	arena.buf = abuf;
+	arena.size = sizeof(abuf);
+	arena.used = 0;
+
+	if ( !TEST_CHECK(DecodePduHdrBin(bin, len, 0, &hdr, &arena, &err)) )
+		return;
+
+	PduHdrToDesc(&hdr, &arena, &hdsc);
+
+	want = *pdsc;
+	want.udhIeNum = 0;
+	memset(want.udhIe, 0, sizeof(want.udhIe));
+
+	TEST_CHECK(__test_same(&hdsc, &want));
+}
+
+int	main(void)
+{
+PDU_DESC	pdsc;
+unsigned char	hex[SMS_PDU_MAX_LEN * 2 + 1];
+uint8_t	bin[SMS_PDU_MAX_LEN];
+size_t	i;
+int	len, err, formats = 0;
+
+	for (i = 0; i < sizeof(__test_pdus) / sizeof(__test_pdus[0]); i++)
+		{
+		__test_pdu = __test_pdus[i];
+		strcpy((char *) hex, __test_pdu);
+
+		if ( !TEST_CHECK(DecodePduData(hex, &pdsc, &err)) )
+			continue;
+
+		len = __test_hex2bin(__test_pdu, bin);
+
+		__test_view(&pdsc, bin, len);
+		__test_hdr_only(&pdsc, bin, len);
+		__test_hdr(&pdsc, bin, len);
+
+		formats |= 1 << pdsc.usrDataFormat;
+		}
+
+	__test_pdu = "(all)";						/* PDU_F_HDR_ONLY is checked on every coding */
+	TEST_CHECK(formats == ((1 << GSM_7BIT) | (1 << ANSI_8BIT) | (1 << UCS2_16BIT)));
+
+	printf("Checks: %d, failed: %d\n", __test_nchecks, __test_nfails);
+
+	return	__test_nfails ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,365 @@
+/*
+ *   DESCRIPTION:	Checks of the concatenated SMS reassembly
+ *
+ *   ABSTRACT:	Parts are built as decoded PDU_DESCs and given to PduReasmAdd() of
+ *		pdu_reasm.c: out-of-order parts, duplicate parts, parts of messages with the
+ *		same reference from different originators, memory budget and pool eviction,
+ *		timeout expiry and not concatenated messages. The reassembled text and the
+ *		counters of PduReasmStat() are compared with the expected ones, every mismatch
+ *		is reported, the exit code is non-zero if any check fails.
+ *
+ *   AUTHOR: AG
+ *
+ *   CREATION DATE: 17-OCT-2026
+ *
+ *   USAGE:
+ *		make test
+ *		./reasmtest
+ *
+ *   MODIFICATION HISTORY:
+ *
+ *
+ */
+
+
+//###########################################################################
+// @INCLUDES
+//###########################################################################
+#include	<stdio.h>
+#include	<stdlib.h>
+#include	<string.h>
+
+#include	"pdu.h"
+#include	"pdu_reasm.h"
+
+//###########################################################################
+// @DEFINES
+//###########################################################################
+#define	TEST_TIMEOUT				60	/* Seconds to wait for missing parts */
+#define	TEST_PART_LEN				153	/* Text of a part of concatenated GSM 7-bit message */
+
+#define	TEST_CHECK(cond)			__test_check((cond), #cond, __func__, __LINE__)
+
+//###########################################################################
+// @DATA
+//###########################################################################
+static	int	__test_nchecks, __test_nfails;
+
+/*  DESCRIPTION: Count the check, report a failed one.
+ *
+ *  INPUTS:
+ *	cond:	Result of the check
+ *	expr:	Text of the check
+ *	func:	Name of the test
+ *	line:	Line of the check
+ *
+ *  RETURNS:
+ *	cond
+ */
+static	int	__test_check(int cond, const char *expr, const char *func, int line)
+{
+	__test_nchecks++;
+
+	if ( !cond )
+		{
+		__test_nfails++;
+		fprintf(stderr, "FAIL %s:%d: %s\n", func, line, expr);
+		}
+
+	return	cond;
+}
+
+/*  DESCRIPTION: Build the decoded part of a concatenated message.
+ *
+ *  INPUTS:
+ *	pdsc:	Descriptor to be filled
+ *	addr:	Originator Number, ASCII digits
+ *	ref:	Concatenated Message Reference Number
+ *	total:	Number of parts, 0 - not concatenated message
+ *	partNo:	Part number, 1 - <total>
+ *	text:	Text of the part
+ *
+ *  RETURNS:
+ *	void
+ */
+static	void	__test_part(PDU_DESC *pdsc, const char *addr, int ref, int total, int partNo, const char *text)
+{
+	memset(pdsc, 0, sizeof(PDU_DESC));
+
+	pdsc->phoneAddrLen = strlen(addr);
+	memcpy(pdsc->phoneAddr, addr, pdsc->phoneAddrLen);
+	pdsc->phoneTypeOfAddr = 0x91;
+
+	pdsc->usrDataFormat = GSM_7BIT;
+	pdsc->usrDataLen = strlen(text);
+	memcpy(pdsc->usrData, text, pdsc->usrDataLen);
+
+	pdsc->isConcatenatedMsg = (total != 0);
+	pdsc->concateMsgRefNo = ref;
+	pdsc->concateTotalParts = total;
+	pdsc->concateCurntPart = partNo;
+}
+
+/*  DESCRIPTION: Fill the text of a part with the letter of the part number.
+ *
+ *  INPUTS:
+ *	text:	Buffer of TEST_PART_LEN + 1 octets
+ *	partNo:	Part number
+ *
+ *  RETURNS:
+ *	text
+ */
+static	const char	*__test_text(char *text, int partNo)
+{
+	memset(text, 'A' + partNo - 1, TEST_PART_LEN);
+	text[TEST_PART_LEN] = '\0';
+
+	return	text;
+}
+
+/*  DESCRIPTION: Add a part, check the result of PduReasmAdd().
+ *
+ *  INPUTS:
+ *	reasm:	Reassembly context
+ *	addr, ref, total, partNo, text: Part, see __test_part()
+ *	now:	Current time
+ *	complete: Expected result, TRUE - message is complete
+ *
+ *  OUTPUS:
+ *	pMsg:	Reassembled message
+ *
+ *  RETURNS:
+ *	TRUE - result is expected
+ */
+static	int	__test_add(PDU_REASM_DESC *reasm, const char *addr, int ref, int total, int partNo, const char *text,
+			time_t now, int complete, PDU_REASM_MSG_DESC *pMsg)
+{
+PDU_DESC	pdsc;
+int	rc, err = -1;
+
+	__test_part(&pdsc, addr, ref, total, partNo, text);
+	rc = PduReasmAdd(reasm, &pdsc, now, pMsg, &err);
+
+	return	TEST_CHECK(err == ERR_NONE) && TEST_CHECK(rc == complete);
+}
+
+/*  DESCRIPTION: Parts arrive in reverse and mixed order, the text is joined in order of part numbers.
+ */
+static	void	__test_out_of_order(void)
+{
+PDU_REASM_DESC	*reasm;
+PDU_REASM_MSG_DESC	msg;
+PDU_REASM_STAT	stat;
+char	text[TEST_PART_LEN + 1];
+static const int order[] = {4, 2, 1, 3};
+int	i, partNo;
+
+	if ( !TEST_CHECK((reasm = PduReasmCreate(16, 0, TEST_TIMEOUT)) != NULL) )
+		return;
+
+	for (i = 0; i < 4; i++)
+		__test_add(reasm, "31624000000", 7, 4, order[i], __test_text(text, order[i]), 0, (i == 3), &msg);
+
+	TEST_CHECK(msg.concateMsgRefNo == 7);
+	TEST_CHECK(msg.concateTotalParts == 4);
+	TEST_CHECK(msg.phoneAddrLen == 11);
+	TEST_CHECK(!memcmp(msg.phoneAddr, "31624000000", 11));
+
+	if ( TEST_CHECK(msg.usrDataLen == 4 * TEST_PART_LEN) )
+		for (partNo = 1; partNo <= 4; partNo++)
+			TEST_CHECK(!memcmp(&msg.usrData[(partNo - 1) * TEST_PART_LEN], __test_text(text, partNo), TEST_PART_LEN));
+
+	PduReasmStat(reasm, &stat);
+	TEST_CHECK(stat.completed == 1);
+	TEST_CHECK(stat.inflight == 0);
+	TEST_CHECK(stat.memUsed == 0);
+
+	PduReasmDestroy(reasm);
+}
+
+/*  DESCRIPTION: Duplicate parts are dropped, same reference from other originator is another message.
+ */
+static	void	__test_duplicates(void)
+{
+PDU_REASM_DESC	*reasm;
+PDU_REASM_MSG_DESC	msg;
+PDU_REASM_STAT	stat;
+
+	if ( !TEST_CHECK((reasm = PduReasmCreate(16, 0, TEST_TIMEOUT)) != NULL) )
+		return;
+
+	__test_add(reasm, "31624000000", 9, 2, 1, "Hello, ", 0, FALSE, &msg);
+	__test_add(reasm, "31624000000", 9, 2, 1, "Hello, ", 0, FALSE, &msg);
+	__test_add(reasm, "31624000001", 9, 2, 2, "stranger", 0, FALSE, &msg);
+	__test_add(reasm, "31624000000", 9, 2, 1, "Hello, ", 0, FALSE, &msg);
+
+	PduReasmStat(reasm, &stat);
+	TEST_CHECK(stat.duplicates == 2);
+	TEST_CHECK(stat.inflight == 2);
+
+	__test_add(reasm, "31624000000", 9, 2, 2, "world", 0, TRUE, &msg);
+	TEST_CHECK((msg.usrDataLen == 12) && !memcmp(msg.usrData, "Hello, world", 12));
+
+	/* Late duplicate of the complete message starts a new set */
+	__test_add(reasm, "31624000000", 9, 2, 2, "world", 0, FALSE, &msg);
+
+	PduReasmStat(reasm, &stat);
+	TEST_CHECK(stat.duplicates == 2);
+	TEST_CHECK(stat.completed == 1);
+	TEST_CHECK(stat.inflight == 2);
+
+	PduReasmDestroy(reasm);
+}
+
+/*  DESCRIPTION: Oldest sets are evicted when the memory budget or the pool is exhausted.
+ */
+static	void	__test_eviction(void)
+{
+PDU_REASM_DESC	*reasm;
+PDU_REASM_MSG_DESC	msg;
+PDU_REASM_STAT	stat;
+char	text[TEST_PART_LEN + 1];
+size_t	setSz;
+
+	/* Size of a set with one part */
+	if ( !TEST_CHECK((reasm = PduReasmCreate(16, 0, TEST_TIMEOUT)) != NULL) )
+		return;
+
+	__test_add(reasm, "31624000000", 1, 3, 1, __test_text(text, 1), 0, FALSE, &msg);
+	PduReasmStat(reasm, &stat);
+	setSz = stat.memUsed;
+	TEST_CHECK(setSz >= TEST_PART_LEN);
+	PduReasmDestroy(reasm);
+
+	/* Budget of two sets: the third one evicts the first one */
+	if ( !TEST_CHECK((reasm = PduReasmCreate(16, 2 * setSz, TEST_TIMEOUT)) != NULL) )
+		return;
+
+	__test_add(reasm, "31624000000", 1, 3, 1, __test_text(text, 1), 0, FALSE, &msg);
+	__test_add(reasm, "31624000000", 2, 3, 1, __test_text(text, 1), 1, FALSE, &msg);
+	__test_add(reasm, "31624000000", 3, 3, 1, __test_text(text, 1), 2, FALSE, &msg);
+
+	PduReasmStat(reasm, &stat);
+	TEST_CHECK(stat.evicted == 1);
+	TEST_CHECK(stat.inflight == 2);
+	TEST_CHECK(stat.memUsed <= 2 * setSz);
+
+	/* Second message is still complete, the first one is not */
+	__test_add(reasm, "31624000000", 2, 3, 2, __test_text(text, 2), 3, FALSE, &msg);
+	__test_add(reasm, "31624000000", 2, 3, 3, __test_text(text, 3), 3, TRUE, &msg);
+	TEST_CHECK(msg.concateMsgRefNo == 2);
+	TEST_CHECK(msg.usrDataLen == 3 * TEST_PART_LEN);
+
+	__test_add(reasm, "31624000000", 1, 3, 2, __test_text(text, 2), 4, FALSE, &msg);
+	__test_add(reasm, "31624000000", 1, 3, 3, __test_text(text, 3), 4, FALSE, &msg);
+
+	PduReasmStat(reasm, &stat);
+	TEST_CHECK(stat.completed == 1);
+	PduReasmDestroy(reasm);
+
+	/* Pool of two sets: the third set evicts the first one, the complete one frees its set */
+	if ( !TEST_CHECK((reasm = PduReasmCreate(2, 0, TEST_TIMEOUT)) != NULL) )
+		return;
+
+	__test_add(reasm, "31624000000", 1, 2, 1, "a", 0, FALSE, &msg);
+	__test_add(reasm, "31624000000", 2, 2, 1, "b", 0, FALSE, &msg);
+	__test_add(reasm, "31624000000", 3, 2, 1, "c", 0, FALSE, &msg);
+	__test_add(reasm, "31624000000", 3, 2, 2, "C", 0, TRUE, &msg);
+	TEST_CHECK((msg.usrDataLen == 2) && !memcmp(msg.usrData, "cC", 2));
+	__test_add(reasm, "31624000000", 1, 2, 2, "A", 0, FALSE, &msg);
+
+	PduReasmStat(reasm, &stat);
+	TEST_CHECK(stat.evicted == 1);
+	TEST_CHECK(stat.completed == 1);
+	TEST_CHECK(stat.inflight == 2);
+
+	PduReasmDestroy(reasm);
+}
+
+/*  DESCRIPTION: Sets older than the timeout are dropped, the fresh ones are kept.
+ */
+static	void	__test_expiry(void)
+{
+PDU_REASM_DESC	*reasm;
+PDU_REASM_MSG_DESC	msg;
+PDU_REASM_STAT	stat;
+
+	if ( !TEST_CHECK((reasm = PduReasmCreate(16, 0, TEST_TIMEOUT)) != NULL) )
+		return;
+
+	__test_add(reasm, "31624000000", 1, 2, 1, "old ", 100, FALSE, &msg);
+	__test_add(reasm, "31624000000", 2, 2, 1, "new ", 130, FALSE, &msg);
+
+	TEST_CHECK(PduReasmExpire(reasm, 100 + TEST_TIMEOUT - 1) == 0);
+	TEST_CHECK(PduReasmExpire(reasm, 100 + TEST_TIMEOUT) == 1);
+
+	PduReasmStat(reasm, &stat);
+	TEST_CHECK(stat.expired == 1);
+	TEST_CHECK(stat.inflight == 1);
+
+	/* Late part of the expired message starts a new set */
+	__test_add(reasm, "31624000000", 1, 2, 2, "part", 161, FALSE, &msg);
+	__test_add(reasm, "31624000000", 2, 2, 2, "part", 161, TRUE, &msg);
+	TEST_CHECK((msg.usrDataLen == 8) && !memcmp(msg.usrData, "new part", 8));
+
+	TEST_CHECK(PduReasmExpire(reasm, 161 + TEST_TIMEOUT) == 1);
+
+	PduReasmStat(reasm, &stat);
+	TEST_CHECK(stat.expired == 2);
+	TEST_CHECK(stat.inflight == 0);
+	TEST_CHECK(stat.memUsed == 0);
+
+	PduReasmDestroy(reasm);
+
+	/* No timeout - nothing expires */
+	if ( !TEST_CHECK((reasm = PduReasmCreate(16, 0, 0)) != NULL) )
+		return;
+
+	__test_add(reasm, "31624000000", 1, 2, 1, "old ", 0, FALSE, &msg);
+	TEST_CHECK(PduReasmExpire(reasm, 1000000) == 0);
+
+	PduReasmDestroy(reasm);
+}
+
+/*  DESCRIPTION: Not concatenated message is returned as is, invalid part numbers are rejected.
+ */
+static	void	__test_single(void)
+{
+PDU_REASM_DESC	*reasm;
+PDU_REASM_MSG_DESC	msg;
+PDU_REASM_STAT	stat;
+PDU_DESC	pdsc;
+int	err;
+
+	if ( !TEST_CHECK((reasm = PduReasmCreate(16, 0, TEST_TIMEOUT)) != NULL) )
+		return;
+
+	__test_add(reasm, "31624000000", 0, 0, 0, "How are you?", 0, TRUE, &msg);
+	TEST_CHECK(msg.concateTotalParts == 1);
+	TEST_CHECK((msg.usrDataLen == 12) && !memcmp(msg.usrData, "How are you?", 12));
+
+	__test_part(&pdsc, "31624000000", 1, 2, 3, "bad");
+	TEST_CHECK(!PduReasmAdd(reasm, &pdsc, 0, &msg, &err) && (err == ERR_CONCAT_PART));
+
+	__test_part(&pdsc, "31624000000", 1, 2, 0, "bad");
+	TEST_CHECK(!PduReasmAdd(reasm, &pdsc, 0, &msg, &err) && (err == ERR_CONCAT_PART));
+
+	PduReasmStat(reasm, &stat);
+	TEST_CHECK(stat.inflight == 0);
+	TEST_CHECK(stat.completed == 0);
+
+	PduReasmDestroy(reasm);
+}
+
+int	main(void)
+{
+	__test_out_of_order();
+	__test_duplicates();
+	__test_eviction();
+	__test_expiry();
+	__test_single();
+
+	printf("Checks: %d, failed: %d\n", __test_nchecks, __test_nfails);
+
+	return	__test_nfails ? EXIT_FAILURE : EXIT_SUCCESS;
+}